@@ -39,6 +39,21 @@ inline int lx_ftruncate(int fd, unsigned long length)
 }
 
 
+inline int lx_fallocate(int fd, unsigned long length)
+{
+#ifdef _LP64
+	return lx_syscall(SYS_fallocate, fd, 0, 0, length);
+#else
+	/*
+	 * The 64-bit offset and length are passed as pairs of 32-bit words,
+	 * low word first. With the file descriptor and mode in front, both
+	 * pairs are register-aligned as required by ARM EABI.
+	 */
+	return lx_syscall(SYS_fallocate, fd, 0, 0, 0, length, 0);
+#endif /* _LP64 */
+}
+
+
 inline int lx_unlink(const char *fname)
 {
 	return lx_syscall(SYS_unlink, fname);
@@ -51,6 +66,36 @@ inline int lx_dup(int fd)
 }
 
 
+enum {
+	LX_MFD_CLOEXEC       = 0x1,
+	LX_MFD_ALLOW_SEALING = 0x2,
+	LX_MFD_HUGETLB       = 0x4,
+
+	LX_F_ADD_SEALS       = 1033,
+	LX_F_SEAL_SEAL       = 0x1,
+	LX_F_SEAL_SHRINK     = 0x2,
+	LX_F_SEAL_GROW       = 0x4,
+
+	LX_ENOSYS            = 38,
+};
+
+
+inline int lx_memfd_create(char const *name, unsigned flags)
+{
+#ifdef SYS_memfd_create
+	return lx_syscall(SYS_memfd_create, name, flags);
+#else
+	return -LX_ENOSYS;
+#endif
+}
+
+
+inline int lx_fcntl(int fd, int cmd, unsigned long arg)
+{
+	return lx_syscall(SYS_fcntl, fd, cmd, arg);
+}
+
+
 /*******************************************************
  ** Functions used by core's rom-session support code **
  *******************************************************/
@@ -14,7 +14,32 @@
 #ifndef _CORE__INCLUDE__UTIL_H_
 #define _CORE__INCLUDE__UTIL_H_
 
+/* Genode includes */
+#include <util/string.h>
+
 /* base-internal includes */
 #include <base/internal/page_size.h>
 
+
+/**
+ * List of Unix environment variables, initialized by the startup code
+ */
+extern char **lx_environ;
+
+
+/**
+ * Read environment variable as string
+ *
+ * If no matching key exists, return an empty string.
+ */
+static inline char const *get_env(char const *key)
+{
+	Genode::size_t key_len = Genode::strlen(key);
+	for (char **curr = lx_environ; curr && *curr; curr++)
+		if ((Genode::strcmp(*curr, key, key_len) == 0) && (*curr)[key_len] == '=')
+			return (char const *)(*curr + key_len + 1);
+
+	return "";
+}
+
 #endif /* _CORE__INCLUDE__UTIL_H_ */
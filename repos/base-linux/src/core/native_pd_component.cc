@@ -19,6 +19,7 @@
 /* core-local includes */
 #include <pd_session_component.h>
 #include <dataspace_component.h>
+#include <util.h>
 
 /* base-internal includes */
 #include <base/internal/parent_socket_handle.h>
@@ -65,28 +66,6 @@ static int _exec_child(Execve_args *arg)
 }
 
 
-/**
- * List of Unix environment variables, initialized by the startup code
- */
-extern char **lx_environ;
-
-
-/**
- * Read environment variable as string
- *
- * If no matching key exists, return an empty string.
- */
-static const char *get_env(const char *key)
-{
-	Genode::size_t key_len = Genode::strlen(key);
-	for (char **curr = lx_environ; curr && *curr; curr++)
-		if ((Genode::strcmp(*curr, key, key_len) == 0) && (*curr)[key_len] == '=')
-			return (const char *)(*curr + key_len + 1);
-
-	return "";
-}
-
-
 /**************************
  ** PD session interface **
  **************************/
@@ -20,6 +20,7 @@
 /* local includes */
 #include <ram_dataspace_factory.h>
 #include <resource_path.h>
+#include <util.h>
 
 /* base-internal includes */
 #include <base/internal/capability_space_tpl.h>
@@ -31,9 +32,87 @@
 using namespace Genode;
 
 
+/**
+ * Policy for backing large RAM dataspaces by huge pages
+ *
+ * Transparent huge pages need no support by core. They are requested by the
+ * components when attaching large dataspaces, and the kernel grants them
+ * according to '/sys/kernel/mm/transparent_hugepage/shmem_enabled'.
+ *
+ * Explicit huge pages must be reserved on the host beforehand (see
+ * '/proc/sys/vm/nr_hugepages') and are used if core is started with the
+ * environment variable 'GENODE_HUGE_PAGES=explicit'. Such dataspaces can be
+ * attached at huge-page-aligned addresses only. The creation of a hugetlbfs
+ * file succeeds even if no huge page is left, and the lack is noticed not
+ * before a component touches the memory, which kills the component with
+ * SIGBUS. Hence, core reserves the huge pages of such a dataspace up front
+ * and uses normal pages if the reservation fails.
+ */
+struct Huge_page_policy
+{
+	enum { SIZE = 2*1024*1024 };
+
+	bool const explicit_pages =
+		!Genode::strcmp(get_env("GENODE_HUGE_PAGES"), "explicit");
+
+	bool applies(size_t size) const
+	{
+		return explicit_pages && size >= SIZE && (size % SIZE) == 0;
+	}
+};
+
+
+static Huge_page_policy const &huge_page_policy()
+{
+	static Huge_page_policy inst;
+	return inst;
+}
+
+
+/**
+ * Create anonymous memory file of 'size' bytes
+ *
+ * \return file descriptor, or -1 if the kernel does not support 'memfd'
+ *         or lacks the memory, or if the requested huge pages cannot
+ *         be reserved
+ */
+static int create_memfd(size_t size, unsigned flags)
+{
+	int const fd = lx_memfd_create("ds", LX_MFD_CLOEXEC | LX_MFD_ALLOW_SEALING
+	                                     | flags);
+	if (fd < 0)
+		return -1;
+
+	if (lx_ftruncate(fd, size) < 0) {
+		lx_close(fd);
+		return -1;
+	}
+
+	/* reserve huge pages, ftruncate does not fail if there are none left */
+	if ((flags & LX_MFD_HUGETLB) && lx_fallocate(fd, size) < 0) {
+		lx_close(fd);
+		return -1;
+	}
+
+	/*
+	 * The file descriptor is handed out to each component that attaches the
+	 * dataspace. Prevent any of them from changing the size of the file
+	 * under the feet of the others.
+	 */
+	lx_fcntl(fd, LX_F_ADD_SEALS, LX_F_SEAL_SHRINK | LX_F_SEAL_GROW | LX_F_SEAL_SEAL);
+
+	return fd;
+}
+
+
 static int ram_ds_cnt = 0;  /* counter for creating unique dataspace IDs */
 
-void Ram_dataspace_factory::_export_ram_ds(Dataspace_component *ds)
+/**
+ * Create file for 'size' bytes in the resource path
+ *
+ * This is the fallback for kernels older than 3.17, which lack 'memfd'.
+ */
+static int create_resource_file(size_t size)
 {
 	char fname[Linux_dataspace::FNAME_LEN];
 
@@ -41,10 +120,7 @@ void Ram_dataspace_factory::_export_ram_ds(Dataspace_component *ds)
 	snprintf(fname, sizeof(fname), "%s/ds-%d", resource_path(), ram_ds_cnt++);
 	lx_unlink(fname);
 	int const fd = lx_open(fname, O_CREAT|O_RDWR|O_TRUNC|LX_O_CLOEXEC, S_IRWXU);
-	lx_ftruncate(fd, ds->size());
-
-	/* remember file descriptor in dataspace component object */
-	ds->fd(fd);
+	lx_ftruncate(fd, size);
 
 	/*
 	 * Wipe the file from the Linux file system. The kernel will still keep the
@@ -53,6 +129,28 @@ void Ram_dataspace_factory::_export_ram_ds(Dataspace_component *ds)
 	 * w/o the right file descriptor won't be able to open and access the file.
 	 */
 	lx_unlink(fname);
+
+	return fd;
+}
+
+
+void Ram_dataspace_factory::_export_ram_ds(Dataspace_component *ds)
+{
+	size_t const size = ds->size();
+
+	int fd = -1;
+
+	if (huge_page_policy().applies(size))
+		fd = create_memfd(size, LX_MFD_HUGETLB);
+
+	if (fd < 0)
+		fd = create_memfd(size, 0);
+
+	if (fd < 0)
+		fd = create_resource_file(size);
+
+	/* remember file descriptor in dataspace component object */
+	ds->fd(fd);
 }
 
 
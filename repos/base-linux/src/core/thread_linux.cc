@@ -61,7 +61,10 @@ void Thread::_thread_start()
 void Thread::_init_platform_thread(size_t, Type) { }
 
 
-void Thread::_deinit_platform_thread() { }
+void Thread::_deinit_platform_thread()
+{
+	destroy_reply_channel(native_thread().reply_channel);
+}
 
 
 void Thread::start()
@@ -22,6 +22,7 @@
 
 /* Genode includes */
 #include <base/thread.h>
+#include <cpu/atomic.h>
 
 /* Linux includes */
 #include <linux_syscalls.h>
@@ -30,6 +31,23 @@
 extern int main_thread_futex_counter;
 
 
+/*
+ * The futex counter of each thread serves as wake-up token. The waker sets
+ * the counter to 1 before issuing 'FUTEX_WAKE', the woken-up thread consumes
+ * the token by resetting the counter to 0. This way, a wake-up that happens
+ * before the applicant actually went to sleep is never lost and the waker
+ * does not need to retry.
+ */
+enum { FUTEX_TOKEN_NONE = 0, FUTEX_TOKEN_WAKEUP = 1 };
+
+
+static inline int *thread_futex_counter(Genode::Thread *thread_base)
+{
+	return thread_base ? &thread_base->native_thread().futex_counter
+	                   : &main_thread_futex_counter;
+}
+
+
 static inline void thread_yield()
 {
 	struct timespec ts = { 0, 1000 };
@@ -39,10 +57,11 @@ static inline void thread_yield()
 
 static inline bool thread_check_stopped_and_restart(Genode::Thread *thread_base)
 {
-	const int *futex_counter_ptr = thread_base ?
-	                               &thread_base->native_thread().futex_counter :
-	                               &main_thread_futex_counter;
-	return lx_futex(futex_counter_ptr, LX_FUTEX_WAKE, 1);
+	int * const futex_counter_ptr = thread_futex_counter(thread_base);
+
+	Genode::cmpxchg(futex_counter_ptr, FUTEX_TOKEN_NONE, FUTEX_TOKEN_WAKEUP);
+	lx_futex(futex_counter_ptr, LX_FUTEX_WAKE, 1);
+	return true;
 }
 
 
@@ -52,18 +71,30 @@ static inline void thread_switch_to(Genode::Thread *thread_base)
 }
 
 
-static inline void thread_stop_myself()
+/**
+ * Block until woken up via 'thread_check_stopped_and_restart'
+ *
+ * \return  true if the wake-up token was consumed, false if the blocking
+ *          got canceled by a signal
+ */
+static inline bool thread_stop_myself()
 {
-	/*
-	 * Just go to sleep without modifying the counter value. The
-	 * 'thread_check_stopped_and_restart()' function will get called
-	 * repeatedly until this thread has actually executed the syscall.
-	 */
-	Genode::Thread *myself = Genode::Thread::myself();
-	const int *futex_counter_ptr = myself ?
-	                               &myself->native_thread().futex_counter :
-	                               &main_thread_futex_counter;
-	lx_futex(futex_counter_ptr, LX_FUTEX_WAIT, 0);
+	int * const futex_counter_ptr = thread_futex_counter(Genode::Thread::myself());
+
+	enum { LX_EINTR = 4 };
+
+	for (;;) {
+
+		if (Genode::cmpxchg(futex_counter_ptr, FUTEX_TOKEN_WAKEUP, FUTEX_TOKEN_NONE))
+			return true;
+
+		/* returns immediately if the token got deposited meanwhile */
+		int const ret = lx_futex(futex_counter_ptr, LX_FUTEX_WAIT, FUTEX_TOKEN_NONE);
+
+		if (ret == -LX_EINTR)
+			return Genode::cmpxchg(futex_counter_ptr, FUTEX_TOKEN_WAKEUP,
+			                       FUTEX_TOKEN_NONE);
+	}
 }
 
 #endif /* _INCLUDE__BASE__INTERNAL__LOCK_HELPER_H_ */
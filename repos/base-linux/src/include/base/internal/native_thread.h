@@ -16,6 +16,7 @@
 
 #include <base/stdint.h>
 #include <base/internal/server_socket_pair.h>
+#include <base/internal/reply_channel.h>
 
 namespace Genode { struct Native_thread; }
 
@@ -48,6 +49,14 @@ struct Genode::Native_thread
 
 	Socket_pair socket_pair;
 
+	/**
+	 * Channel for receiving RPC replies
+	 *
+	 * The channel is created on the first RPC call issued by the thread and
+	 * reused for all subsequent calls.
+	 */
+	Reply_channel reply_channel;
+
 	Native_thread() { }
 };
 
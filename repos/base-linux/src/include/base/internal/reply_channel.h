@@ -0,0 +1,40 @@
+/*
+ * \brief  Socket pair used by an RPC client to receive replies
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__INTERNAL__REPLY_CHANNEL_H_
+#define _INCLUDE__BASE__INTERNAL__REPLY_CHANNEL_H_
+
+namespace Genode {
+
+	/*
+	 * The remote socket is handed out to the server along with each RPC
+	 * request. The client receives the reply at the local socket.
+	 */
+	struct Reply_channel
+	{
+		int local_sd  = -1;
+		int remote_sd = -1;
+
+		bool valid() const { return local_sd != -1; }
+	};
+
+	/*
+	 * Helper to close the sockets of a reply channel
+	 *
+	 * The reply channel is reset to the invalid state such that it gets
+	 * re-created on the next RPC call.
+	 */
+	void destroy_reply_channel(Reply_channel &);
+}
+
+#endif /* _INCLUDE__BASE__INTERNAL__REPLY_CHANNEL_H_ */
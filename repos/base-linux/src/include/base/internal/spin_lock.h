@@ -0,0 +1,64 @@
+/*
+ * \brief  Linux-specific spinlock used within the lock implementation
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2009-2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__INTERNAL__SPIN_LOCK_H_
+#define _INCLUDE__BASE__INTERNAL__SPIN_LOCK_H_
+
+/* Genode includes */
+#include <cpu/atomic.h>
+#include <cpu/memory_barrier.h>
+
+/* base-internal includes */
+#include <base/internal/native_thread.h>
+#include <base/internal/lock_helper.h>
+
+/*
+ * Spinlock functions used for protecting the critical sections within the
+ * 'lock' and 'unlock' functions. In contrast to the generic version, a
+ * contended spinlock is polled for a while before yielding the CPU. On a
+ * multi-processor host, the holder of the spinlock is most likely running on
+ * another CPU and leaves the short critical section well before a sleeping
+ * 'thread_yield' would return.
+ */
+
+enum State { SPINLOCK_LOCKED, SPINLOCK_UNLOCKED };
+
+enum { SPINLOCK_SPIN_COUNT = 1000 };
+
+
+static inline void spinlock_lock(volatile int *lock_variable)
+{
+	for (unsigned spins = 0;
+	     !Genode::cmpxchg(lock_variable, SPINLOCK_UNLOCKED, SPINLOCK_LOCKED);
+	     spins++) {
+
+		/* poll without issuing atomic operations */
+		while (*lock_variable == SPINLOCK_LOCKED && spins++ < SPINLOCK_SPIN_COUNT)
+			Genode::memory_barrier();
+
+		if (spins >= SPINLOCK_SPIN_COUNT) {
+			thread_yield();
+			spins = 0;
+		}
+	}
+}
+
+
+static inline void spinlock_unlock(volatile int *lock_variable)
+{
+	/* make sure all got written by compiler before releasing lock */
+	Genode::memory_barrier();
+	*lock_variable = SPINLOCK_UNLOCKED;
+}
+
+#endif /* _INCLUDE__BASE__INTERNAL__SPIN_LOCK_H_ */
@@ -345,6 +345,53 @@ static inline void lx_reply(int reply_socket, Rpc_exception_code exception_code,
 }
 
 
+/*******************
+ ** Reply channel **
+ *******************/
+
+void Genode::destroy_reply_channel(Reply_channel &reply_channel)
+{
+	if (reply_channel.local_sd  != -1) lx_close(reply_channel.local_sd);
+	if (reply_channel.remote_sd != -1) lx_close(reply_channel.remote_sd);
+
+	reply_channel = Reply_channel();
+}
+
+
+/**
+ * Return reply channel of the calling thread, create it on first use
+ *
+ * Keeping the socket pair around for the lifetime of the thread spares the
+ * 'socketpair' and 'close' system calls for each RPC.
+ */
+static Reply_channel &reply_channel_of_myself()
+{
+	/* the main thread has no 'Thread' object, use a dedicated channel */
+	static Reply_channel main_reply_channel;
+
+	Thread * const myself = Thread::myself();
+
+	Reply_channel &reply_channel = myself ? myself->native_thread().reply_channel
+	                                      : main_reply_channel;
+	if (reply_channel.valid())
+		return reply_channel;
+
+	enum { LOCAL_SOCKET = 0, REMOTE_SOCKET = 1 };
+	int sd[2] = { -1, -1 };
+
+	int const ret = lx_socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, sd);
+	if (ret < 0) {
+		PRAW("[%d] lx_socketpair failed with %d", lx_getpid(), ret);
+		throw Genode::Ipc_error();
+	}
+
+	reply_channel.local_sd  = sd[LOCAL_SOCKET];
+	reply_channel.remote_sd = sd[REMOTE_SOCKET];
+
+	return reply_channel;
+}
+
+
 /****************
  ** IPC client **
  ****************/
@@ -359,42 +406,12 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 	Message snd_msg(snd_header.msg_start(),
 	                sizeof(Protocol_header) + snd_msgbuf.data_size());
 
-	/*
-	 * Create reply channel
-	 *
-	 * The reply channel will be closed when leaving the scope of 'lx_call'.
-	 */
-	struct Reply_channel
-	{
-		enum { LOCAL_SOCKET = 0, REMOTE_SOCKET = 1 };
-		int sd[2];
-
-		Reply_channel()
-		{
-			sd[LOCAL_SOCKET] = -1; sd[REMOTE_SOCKET] = -1;
-
-			int ret = lx_socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, sd);
-			if (ret < 0) {
-				PRAW("[%d] lx_socketpair failed with %d", lx_getpid(), ret);
-				throw Genode::Ipc_error();
-			}
-		}
-
-		~Reply_channel()
-		{
-			if (sd[LOCAL_SOCKET]  != -1) lx_close(sd[LOCAL_SOCKET]);
-			if (sd[REMOTE_SOCKET] != -1) lx_close(sd[REMOTE_SOCKET]);
-		}
-
-		int local_socket()  const { return sd[LOCAL_SOCKET];  }
-		int remote_socket() const { return sd[REMOTE_SOCKET]; }
-
-	} reply_channel;
+	Reply_channel &reply_channel = reply_channel_of_myself();
 
 	/* assemble message */
 
 	/* marshal reply capability */
-	snd_msg.marshal_socket(reply_channel.remote_socket());
+	snd_msg.marshal_socket(reply_channel.remote_sd);
 
 	/* marshal capabilities contained in 'snd_msgbuf' */
 	insert_sds_into_message(snd_msg, snd_header, snd_msgbuf);
@@ -418,7 +435,15 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 	rcv_msg.accept_sockets(Message::MAX_SDS_PER_MSG);
 
 	rcv_msgbuf.reset();
-	int const recv_ret = lx_recvmsg(reply_channel.local_socket(), rcv_msg.msg(), 0);
+	int const recv_ret = lx_recvmsg(reply_channel.local_sd, rcv_msg.msg(), 0);
+
+	/*
+	 * The server may still reply to a call that we stopped waiting for.
+	 * Discard the reply channel so that such a late reply cannot be mistaken
+	 * for the reply of the next call.
+	 */
+	if (recv_ret < 0)
+		destroy_reply_channel(reply_channel);
 
 	/* system call got interrupted by a signal */
 	if (recv_ret == -LX_EINTR)
@@ -117,6 +117,38 @@ addr_t Region_map_mmap::_reserve_local(bool           use_local_addr,
 }
 
 
+enum { HUGE_PAGE_SIZE_LOG2 = 21, HUGE_PAGE_SIZE = 1 << HUGE_PAGE_SIZE_LOG2 };
+
+
+/**
+ * Reserve virtual address range for mapping 'size' bytes at a huge-page
+ * boundary
+ *
+ * \return  aligned start of the reserved range, or 0 on failure
+ */
+static addr_t reserve_huge_page_aligned(Genode::size_t size)
+{
+	Genode::size_t const reserve_size = size + HUGE_PAGE_SIZE;
+
+	void * const reserved = lx_mmap(0, reserve_size, PROT_NONE,
+	                                MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+
+	if (((long)reserved < 0) && ((long)reserved > -4095))
+		return 0;
+
+	addr_t const start   = (addr_t)reserved;
+	addr_t const end     = start + reserve_size;
+	addr_t const aligned = align_addr(start, HUGE_PAGE_SIZE_LOG2);
+	addr_t const used    = aligned + align_addr(size, 12);
+
+	/* release the parts of the reservation not covered by the mapping */
+	if (aligned > start) lx_munmap((void *)start, aligned - start);
+	if (end > used)      lx_munmap((void *)used, end - used);
+
+	return aligned;
+}
+
+
 void *Region_map_mmap::_map_local(Dataspace_capability ds,
                                   Genode::size_t       size,
                                   addr_t               offset,
@@ -128,11 +160,20 @@ void *Region_map_mmap::_map_local(Dataspace_capability ds,
 	int  const  fd        = _dataspace_fd(ds);
 	bool const  writable  = _dataspace_writable(ds);
 
-	int  const  flags     = MAP_SHARED | (overmap ? MAP_FIXED : 0);
+	/*
+	 * Large dataspaces are mapped at huge-page-aligned addresses, which
+	 * enables the kernel to back them with transparent huge pages and is a
+	 * prerequisite for dataspaces that consist of explicit huge pages.
+	 */
+	addr_t const huge_addr = (!use_local_addr && size >= HUGE_PAGE_SIZE
+	                          && (offset % HUGE_PAGE_SIZE) == 0)
+	                       ? reserve_huge_page_aligned(size) : 0;
+
+	int  const  flags     = MAP_SHARED | (overmap || huge_addr ? MAP_FIXED : 0);
 	int  const  prot      = PROT_READ
 	                      | (writable   ? PROT_WRITE : 0)
 	                      | (executable ? PROT_EXEC  : 0);
-	void * const addr_in  = use_local_addr ? (void*)local_addr : 0;
+	void * const addr_in  = use_local_addr ? (void*)local_addr : (void *)huge_addr;
 	void * const addr_out = lx_mmap(addr_in, size, prot, flags, fd, offset);
 
 	/*
@@ -149,12 +190,21 @@ void *Region_map_mmap::_map_local(Dataspace_capability ds,
 
 	if ((use_local_addr && addr_in != addr_out)
 	 || (((long)addr_out < 0) && ((long)addr_out > -4095))) {
+
+		/* release reservation */
+		if (huge_addr)
+			lx_munmap((void *)huge_addr, size);
+
 		error("_map_local: lx_mmap failed"
 		      "(addr_in=", addr_in, ", addr_out=", addr_out, "/", (long)addr_out, ") "
 		      "overmap=", overmap);
 		throw Region_map::Region_conflict();
 	}
 
+	/* the advice is merely a hint, the kernel may ignore it */
+	if (huge_addr)
+		lx_madvise(addr_out, size, LX_MADV_HUGEPAGE);
+
 	return addr_out;
 }
 
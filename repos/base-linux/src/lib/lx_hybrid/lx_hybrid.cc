@@ -543,6 +543,9 @@ Thread::~Thread()
 			        "with ", ret, " (errno=", errno, ")");
 	}
 
+	/* release the sockets used for receiving RPC replies */
+	destroy_reply_channel(native_thread().reply_channel);
+
 	Thread_meta_data_created *meta_data =
 		dynamic_cast<Thread_meta_data_created *>(native_thread().meta_data);
 
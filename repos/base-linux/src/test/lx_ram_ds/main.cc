@@ -0,0 +1,130 @@
+/*
+ * \brief  Linux: Benchmark of RAM-dataspace allocation and access
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The test measures the rate of allocating and freeing small RAM
+ * dataspaces, which is dominated by the creation of the backing files in
+ * core. It further measures the throughput of writing a large dataspace,
+ * once sequentially and once with a stride of one page. The latter touches
+ * a different page with each access and thereby depends on whether the
+ * dataspace is backed by huge pages.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/component.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/log.h>
+#include <util/string.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	enum {
+		NUM_DS      = 2000,
+		SMALL_SIZE  = 4096,
+		LARGE_SIZE  = 64*1024*1024,
+		ROUNDS      = 10,
+		PAGE_SIZE   = 4096,
+		HUGE_SIZE   = 2*1024*1024,
+	};
+
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Ram_dataspace_capability _ds[NUM_DS];
+
+	unsigned long _now() { return _timer.elapsed_ms(); }
+
+	static unsigned long _rate(unsigned long count, unsigned long ms) {
+		return (count*1000)/max(1UL, ms); }
+
+	void _measure_allocation()
+	{
+		unsigned long const start = _now();
+
+		for (unsigned i = 0; i < NUM_DS; i++)
+			_ds[i] = _env.ram().alloc(SMALL_SIZE);
+
+		unsigned long const allocated = _now();
+
+		for (unsigned i = 0; i < NUM_DS; i++)
+			_env.ram().free(_ds[i]);
+
+		unsigned long const freed = _now();
+
+		log("allocated ", (unsigned)NUM_DS, " dataspaces in ",
+		    allocated - start, " ms (", _rate(NUM_DS, allocated - start),
+		    " allocations/s)");
+		log("freed ", (unsigned)NUM_DS, " dataspaces in ",
+		    freed - allocated, " ms (", _rate(NUM_DS, freed - allocated),
+		    " frees/s)");
+	}
+
+	void _measure_access()
+	{
+		Attached_ram_dataspace ds(_env.ram(), _env.rm(), LARGE_SIZE);
+
+		char * const base = ds.local_addr<char>();
+
+		log("large dataspace of ", (unsigned)LARGE_SIZE/(1024*1024), " MiB "
+		    "attached at ", (void *)base, ", ",
+		    ((addr_t)base % HUGE_SIZE) ? "not " : "",
+		    "huge-page aligned");
+
+		/* sequential write */
+		{
+			unsigned long const start = _now();
+
+			for (unsigned i = 0; i < ROUNDS; i++)
+				memset(base, i, LARGE_SIZE);
+
+			unsigned long const ms = _now() - start;
+			log("memset: ", _rate(ROUNDS*(LARGE_SIZE/(1024*1024)), ms),
+			    " MiB/s");
+		}
+
+		/* one write per page, stressing the TLB */
+		{
+			unsigned long const start = _now();
+
+			enum { STRIDE_ROUNDS = 100 };
+			for (unsigned i = 0; i < STRIDE_ROUNDS; i++)
+				for (unsigned off = 0; off < LARGE_SIZE; off += PAGE_SIZE)
+					((char volatile *)base)[off] = i;
+
+			unsigned long const ms = _now() - start;
+			log("page-strided write: ",
+			    _rate(STRIDE_ROUNDS*(LARGE_SIZE/PAGE_SIZE), ms),
+			    " pages/s");
+		}
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- Linux RAM-dataspace benchmark ---");
+
+		_measure_allocation();
+		_measure_access();
+
+		log("--- Linux RAM-dataspace benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-lx_ram_ds
+LIBS   = base
+SRC_CC = main.cc
@@ -84,9 +84,7 @@ class Genode::Id_space : public Noncopyable
 				:
 					_obj(obj), _id_space(id_space)
 				{
-					Lock::Guard guard(_id_space._lock);
-					_id = id_space._unused_id(*this);
-					_id_space._elements.insert(this);
+					_id_space._insert_unused(*this);
 				}
 
 				/**
@@ -98,15 +96,19 @@ class Genode::Id_space : public Noncopyable
 				:
 					_obj(obj), _id_space(id_space), _id(id)
 				{
-					Lock::Guard guard(_id_space._lock);
-					_id_space._check_conflict(*this, id);
-					_id_space._elements.insert(this);
+					Bucket &bucket = _id_space._bucket(id);
+
+					Lock::Guard guard(bucket.lock);
+					_id_space._check_conflict(bucket, id);
+					bucket.elements.insert(this);
 				}
 
 				~Element()
 				{
-					Lock::Guard guard(_id_space._lock);
-					_id_space._elements.remove(this);
+					Bucket &bucket = _id_space._bucket(_id);
+
+					Lock::Guard guard(bucket.lock);
+					bucket.elements.remove(this);
 				}
 
 				/**
@@ -120,29 +122,58 @@ class Genode::Id_space : public Noncopyable
 		};
 
 	private:
- 
-		Lock mutable      _lock;       /* protect '_elements' and '_cnt' */
-		Avl_tree<Element> _elements;
-		unsigned long     _cnt = 0;
+
+		/*
+		 * The elements are distributed over buckets by their IDs. Each
+		 * bucket is protected by a lock of its own. Hence, lookups of
+		 * different IDs rarely contend and walk a tree of only a fraction
+		 * of the elements.
+		 */
+		enum { NUM_BUCKETS = 16 };
+
+		struct Bucket
+		{
+			Lock mutable      lock { };     /* protect 'elements' */
+			Avl_tree<Element> elements { };
+
+			Element *lookup(Id id) const
+			{
+				return elements.first() ? elements.first()->_lookup(id)
+				                        : nullptr;
+			}
+		};
+
+		Bucket _buckets[NUM_BUCKETS];
+
+		Lock          _cnt_lock { };   /* protect '_cnt' */
+		unsigned long _cnt = 0;
+
+		Bucket &_bucket(Id id) { return _buckets[id.value % NUM_BUCKETS]; }
 
 		/**
-		 * Return ID that does not exist within the ID space
+		 * Assign ID that does not exist within the ID space and insert element
 		 *
-		 * \return ID assigned to the element within the ID space
-		 * \throw  Out_of_ids
+		 * \throw Out_of_ids
 		 */
-		Id _unused_id(Element &e)
+		void _insert_unused(Element &e)
 		{
+			Lock::Guard cnt_guard(_cnt_lock);
+
 			unsigned long _attempts = 0;
 			for (; _attempts < ~0UL; _attempts++, _cnt++) {
 
 				Id const id { _cnt };
 
+				Bucket &bucket = _bucket(id);
+				Lock::Guard guard(bucket.lock);
+
 				/* another attempt if is already in use */
-				if (_elements.first() && _elements.first()->_lookup(id))
+				if (bucket.lookup(id))
 					continue;
 
-				return id;
+				e._id = id;
+				bucket.elements.insert(&e);
+				return;
 			}
 			throw Out_of_ids();
 		}
@@ -150,11 +181,13 @@ class Genode::Id_space : public Noncopyable
 		/**
 		 * Check if ID is already in use
 		 *
+		 * Must be called with the bucket lock held.
+		 *
 		 * \throw  Conflicting_id
 		 */
-		void _check_conflict(Element &e, Id id)
+		void _check_conflict(Bucket &bucket, Id id)
 		{
-			if (_elements.first() && _elements.first()->_lookup(id))
+			if (bucket.lookup(id))
 				throw Conflicting_id();
 		}
 
@@ -168,16 +201,19 @@ class Genode::Id_space : public Noncopyable
 		 * \param ARG  argument type passed to 'fn', must be convertible
 		 *             from 'T' via a 'static_cast'
 		 *
-		 * This function is called with the ID space locked. Hence, it is not
+		 * The IDs are not visited in a particular order. This function is
+		 * called with the ID space partially locked. Hence, it is not
 		 * possible to modify the ID space from within 'fn'.
 		 */
 		template <typename ARG, typename FUNC>
 		void for_each(FUNC const &fn) const
 		{
-			Lock::Guard guard(_lock);
+			for (Bucket const &bucket : _buckets) {
+				Lock::Guard guard(bucket.lock);
 
-			if (_elements.first())
-				_elements.first()->template _for_each<ARG>(fn);
+				if (bucket.elements.first())
+					bucket.elements.first()->template _for_each<ARG>(fn);
+			}
 		}
 
 		/**
@@ -193,12 +229,11 @@ class Genode::Id_space : public Noncopyable
 		{
 			T *obj = nullptr;
 			{
-				Lock::Guard guard(_lock);
+				Bucket &bucket = _bucket(id);
 
-				if (!_elements.first())
-					throw Unknown_id();
+				Lock::Guard guard(bucket.lock);
 
-				if (Element *e = _elements.first()->_lookup(id))
+				if (Element *e = bucket.lookup(id))
 					obj = &e->_obj;
 			}
 			if (obj)
@@ -224,22 +259,28 @@ class Genode::Id_space : public Noncopyable
 		bool apply_any(FUNC const &fn)
 		{
 			T *obj = nullptr;
-			{
-				Lock::Guard guard(_lock);
+			for (Bucket &bucket : _buckets) {
+				Lock::Guard guard(bucket.lock);
 
-				if (_elements.first())
-					obj = &_elements.first()->_obj;
-				else
-					return false;
+				if (bucket.elements.first()) {
+					obj = &bucket.elements.first()->_obj;
+					break;
+				}
 			}
+			if (!obj)
+				return false;
+
 			fn(static_cast<ARG &>(*obj));
 			return true;
 		}
 
 		~Id_space()
 		{
-			if (_elements.first())
-				error("ID space not empty at destruction time");
+			for (Bucket &bucket : _buckets)
+				if (bucket.elements.first()) {
+					error("ID space not empty at destruction time");
+					return;
+				}
 		}
 };
 
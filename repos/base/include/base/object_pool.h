@@ -93,29 +93,67 @@ class Genode::Object_pool
 
 	private:
 
-		Avl_tree<Entry> _tree;
-		Lock            _lock;
+		/*
+		 * The entries are distributed over buckets by the local names of
+		 * their capabilities. Each bucket is protected by a lock of its
+		 * own. Lookups of different entrypoint threads thereby rarely
+		 * contend, and each lookup walks a tree of only a fraction of
+		 * the objects of the pool.
+		 */
+		enum { NUM_BUCKETS = 32 };
+
+		struct Bucket
+		{
+			Avl_tree<Entry> tree { };
+			Lock            lock { };
+
+			Entry *lookup(unsigned long capid)
+			{
+				return tree.first() ? tree.first()->find_by_obj_id(capid)
+				                    : nullptr;
+			}
+		};
+
+		Bucket _buckets[NUM_BUCKETS];
+
+		Bucket &_bucket(unsigned long capid)
+		{
+			/*
+			 * Local names are mostly allocated densely and thereby spread
+			 * by their low bits. Folding in the upper bits also spreads
+			 * names that differ in those bits only.
+			 */
+			return _buckets[(capid ^ (capid >> 16)) % NUM_BUCKETS];
+		}
 
 	protected:
 
 		bool empty()
 		{
-			Lock::Guard lock_guard(_lock);
-			return _tree.first() == nullptr;
+			for (Bucket &bucket : _buckets) {
+				Lock::Guard lock_guard(bucket.lock);
+				if (bucket.tree.first())
+					return false;
+			}
+			return true;
 		}
 
 	public:
 
 		void insert(OBJ_TYPE *obj)
 		{
-			Lock::Guard lock_guard(_lock);
-			_tree.insert(obj);
+			Bucket &bucket = _bucket(obj->_obj_id());
+
+			Lock::Guard lock_guard(bucket.lock);
+			bucket.tree.insert(obj);
 		}
 
 		void remove(OBJ_TYPE *obj)
 		{
-			Lock::Guard lock_guard(_lock);
-			_tree.remove(obj);
+			Bucket &bucket = _bucket(obj->_obj_id());
+
+			Lock::Guard lock_guard(bucket.lock);
+			bucket.tree.remove(obj);
 		}
 
 		template <typename FUNC>
@@ -130,12 +168,12 @@ class Genode::Object_pool
 			Weak_ptr ptr;
 
 			{
-				Lock::Guard lock_guard(_lock);
+				Bucket &bucket = _bucket(capid);
 
-				Entry * entry = _tree.first() ?
-					_tree.first()->find_by_obj_id(capid) : nullptr;
+				Lock::Guard lock_guard(bucket.lock);
 
-				if (entry) ptr = entry->_lock.weak_ptr();
+				if (Entry * entry = bucket.lookup(capid))
+					ptr = entry->_lock.weak_ptr();
 			}
 
 			{
@@ -159,24 +197,26 @@ class Genode::Object_pool
 			using Weak_ptr   = Weak_ptr<typename Entry::Entry_lock>;
 			using Locked_ptr = Locked_ptr<typename Entry::Entry_lock>;
 
-			for (;;) {
-				OBJ_TYPE * obj;
+			for (Bucket &bucket : _buckets) {
+				for (;;) {
+					OBJ_TYPE * obj;
 
-				{
-					Lock::Guard lock_guard(_lock);
+					{
+						Lock::Guard lock_guard(bucket.lock);
 
-					if (!((obj = (OBJ_TYPE*) _tree.first()))) return;
+						if (!((obj = (OBJ_TYPE*) bucket.tree.first()))) break;
 
-					Weak_ptr ptr = obj->_lock.weak_ptr();
-					{
-						Locked_ptr lock_ptr(ptr);
-						if (!lock_ptr.valid()) return;
+						Weak_ptr ptr = obj->_lock.weak_ptr();
+						{
+							Locked_ptr lock_ptr(ptr);
+							if (!lock_ptr.valid()) return;
 
-						_tree.remove(obj);
+							bucket.tree.remove(obj);
+						}
 					}
-				}
 
-				func(obj);
+					func(obj);
+				}
 			}
 		}
 };
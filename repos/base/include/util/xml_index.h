@@ -0,0 +1,230 @@
+/*
+ * \brief  Pre-built index for accessing large XML documents
+ * \author agent
+ * \date   2026-10-17
+ *
+ * A plain 'Xml_node' locates its end tag and counts its sub nodes by
+ * tokenizing its whole content whenever it is constructed. Iterating over
+ * the sub nodes of a large document thereby scans the same data over and
+ * over again. The 'Xml_index' parses a document once and records the
+ * structure of each node in an array of entries. The nodes handed out by
+ * the index are regular 'Xml_node' objects that look up their siblings,
+ * sub nodes, content, and size in these entries instead of scanning.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__UTIL__XML_INDEX_H_
+#define _INCLUDE__UTIL__XML_INDEX_H_
+
+#include <util/xml_node.h>
+#include <util/noncopyable.h>
+#include <base/allocator.h>
+
+namespace Genode { class Xml_index; }
+
+
+class Genode::Xml_index : Noncopyable
+{
+	private:
+
+		typedef Xml_node::Index_entry Entry;
+		typedef Xml_node::Token       Token;
+		typedef Xml_node::Tag         Tag;
+		typedef Xml_node::Comment     Comment;
+
+		enum { INITIAL_CAPACITY = 64 };
+
+		Allocator  &_alloc;
+		char const *_base;
+		size_t      _max_len;
+		Entry      *_entries  = nullptr;
+		unsigned    _capacity = 0;
+		unsigned    _count    = 0;
+
+		size_t _offset(Token const &t) const { return t.start() - _base; }
+
+		void _grow()
+		{
+			unsigned const capacity = _capacity ? 2*_capacity
+			                                    : (unsigned)INITIAL_CAPACITY;
+
+			Entry *entries = (Entry *)_alloc.alloc(capacity*sizeof(Entry));
+			if (_entries) {
+				memcpy(entries, _entries, _count*sizeof(Entry));
+				_alloc.free(_entries, _capacity*sizeof(Entry));
+			}
+			_entries  = entries;
+			_capacity = capacity;
+		}
+
+		/**
+		 * Append entry for node that starts with 'tag'
+		 */
+		unsigned _append(Tag const &tag, unsigned parent)
+		{
+			if (_count == _capacity)
+				_grow();
+
+			unsigned const id = _count++;
+			Entry &e = _entries[id];
+
+			e.addr          = 0;
+			e.start_tag     = _offset(tag.token());
+			e.content       = _offset(tag.next_token());
+			e.end_tag       = e.start_tag;
+			e.end           = e.content;
+			e.num_sub_nodes = 0;
+			e.parent        = parent;
+			e.first_child   = Entry::NONE;
+			e.last_child    = Entry::NONE;
+			e.next_sibling  = Entry::NONE;
+			e.empty         = tag.type() == Tag::EMPTY;
+
+			if (parent == Entry::NONE)
+				return id;
+
+			/*
+			 * Link node into the sub-node list of its parent. The addresses
+			 * mirror those of plain nodes. A first sub node starts right at
+			 * the content of its parent, all following sub nodes at their
+			 * start tag.
+			 */
+			Entry &p = _entries[parent];
+			if (p.last_child == Entry::NONE) {
+				p.first_child = id;
+				e.addr        = p.content;
+			} else {
+				_entries[p.last_child].next_sibling = id;
+				e.addr = e.start_tag;
+			}
+
+			p.last_child = id;
+			p.num_sub_nodes++;
+			return id;
+		}
+
+		static bool _same_name(Token const &a, Token const &b)
+		{
+			return a.len() == b.len() && !strcmp(a.start(), b.start(), a.len());
+		}
+
+		/**
+		 * Parse the document in one pass
+		 *
+		 * \throw Xml_node::Invalid_syntax
+		 */
+		void _build()
+		{
+			Token t = Xml_node::skip_non_tag_characters(Token(_base, _max_len));
+			Tag const root(t);
+			if (!root.node())
+				throw Xml_node::Invalid_syntax();
+
+			unsigned curr = _append(root, Entry::NONE);
+			if (root.type() == Tag::EMPTY)
+				return;
+
+			for (t = root.next_token(); ; ) {
+
+				if (t.type() == Token::END)
+					throw Xml_node::Invalid_syntax();
+
+				Comment const comment(t);
+				if (comment.valid()) {
+					t = comment.next_token();
+					continue;
+				}
+
+				Tag const tag(t);
+				if (tag.type() == Tag::INVALID) {
+					t = t.next();
+					continue;
+				}
+
+				if (tag.node()) {
+					unsigned const id = _append(tag, curr);
+					if (tag.type() == Tag::START)
+						curr = id;
+
+					t = tag.next_token();
+					continue;
+				}
+
+				/* end tag must close the innermost open node */
+				Entry &e = _entries[curr];
+				if (!_same_name(Tag(Token(_base + e.start_tag,
+				                          _max_len - e.start_tag)).name(),
+				                tag.name()))
+					throw Xml_node::Invalid_syntax();
+
+				e.end_tag = _offset(tag.token());
+				e.end     = _offset(tag.next_token());
+
+				curr = e.parent;
+				if (curr == Entry::NONE)
+					return;
+
+				t = tag.next_token();
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc    backing store of the index entries
+		 * \param addr     start of the XML data
+		 * \param max_len  length of the XML data
+		 *
+		 * \throw Xml_node::Invalid_syntax  document is not well formed
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 *
+		 * In contrast to 'Xml_node', which validates only the node it
+		 * represents, the index requires the whole document to be well
+		 * formed. The XML data must remain valid and unmodified during the
+		 * lifetime of the index and of all nodes obtained from it.
+		 */
+		Xml_index(Allocator &alloc, char const *addr, size_t max_len = ~0UL)
+		:
+			_alloc(alloc), _base(addr), _max_len(max_len)
+		{
+			try { _build(); }
+			catch (...) {
+				if (_entries)
+					_alloc.free(_entries, _capacity*sizeof(Entry));
+				throw;
+			}
+		}
+
+		/**
+		 * Constructor for indexing an existing node
+		 */
+		Xml_index(Allocator &alloc, Xml_node const &node)
+		: Xml_index(alloc, node.addr(), node.size()) { }
+
+		~Xml_index() { _alloc.free(_entries, _capacity*sizeof(Entry)); }
+
+		/**
+		 * Return top-level node of the indexed document
+		 *
+		 * Other than for a plain 'Xml_node', 'next' of the returned node
+		 * does not look beyond the indexed data and always throws
+		 * 'Nonexistent_sub_node'.
+		 */
+		Xml_node xml() const { return Xml_node(_entries, 0, _base, _max_len); }
+
+		/**
+		 * Return total number of nodes of the document
+		 */
+		unsigned num_nodes() const { return _count; }
+};
+
+#endif /* _INCLUDE__UTIL__XML_INDEX_H_ */
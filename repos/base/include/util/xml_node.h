@@ -20,6 +20,7 @@
 namespace Genode {
 	class Xml_attribute;
 	class Xml_node;
+	class Xml_index;
 }
 
 
@@ -49,6 +50,7 @@ class Genode::Xml_attribute
 		Token _value;
 
 		friend class Xml_node;
+		friend class Xml_index;
 
 		/*
 		 * Even though 'Tag' is part of 'Xml_node', the friendship
@@ -183,6 +185,10 @@ class Genode::Xml_attribute
 
 /**
  * Representation of an XML node
+ *
+ * For repeatedly traversing large documents, nodes can be obtained from an
+ * 'Xml_index' (see 'util/xml_index.h'), which avoids re-scanning the node
+ * content on each access.
  */
 class Genode::Xml_node
 {
@@ -195,6 +201,30 @@ class Genode::Xml_node
 		 */
 		class Tag;
 
+		friend class Xml_index;
+
+		/**
+		 * Pre-parsed structure of a node as recorded by 'Xml_index'
+		 *
+		 * All offsets are relative to the start of the indexed XML data.
+		 */
+		struct Index_entry
+		{
+			enum : unsigned { NONE = ~0U };
+
+			size_t   addr;          /* value of 'addr()' of the node        */
+			size_t   start_tag;     /* leading '<' of the start tag         */
+			size_t   content;       /* token after the start tag            */
+			size_t   end_tag;       /* leading '<' of the end tag           */
+			size_t   end;           /* token after the node                 */
+			unsigned num_sub_nodes;
+			unsigned parent;
+			unsigned first_child;
+			unsigned last_child;
+			unsigned next_sibling;
+			bool     empty;         /* node is an empty-element tag         */
+		};
+
 	public:
 
 		/*********************
@@ -449,6 +479,9 @@ class Genode::Xml_node
 		Tag         _start_tag;
 		Tag         _end_tag;
 
+		Index_entry const *_index    = nullptr; /* entries of 'Xml_index' */
+		unsigned           _index_id = 0;       /* entry of this node     */
+
 		/**
 		 * Search for end tag of XML node and initialize '_num_sub_nodes'
 		 *
@@ -565,6 +598,57 @@ class Genode::Xml_node
 			return Xml_node(at, _max_len - (at - addr()));
 		}
 
+		/**
+		 * Constructor used for nodes backed by an 'Xml_index'
+		 *
+		 * The node is created from its index entry without scanning its
+		 * content. Only the start tag and the end tag are tokenized.
+		 *
+		 * \param base     start of the indexed XML data
+		 * \param max_len  length of the indexed XML data
+		 */
+		Xml_node(Index_entry const *index, unsigned id,
+		         char const *base, size_t max_len)
+		:
+			_addr(base + index[id].addr),
+			_max_len(max_len - index[id].addr),
+			_num_sub_nodes(index[id].num_sub_nodes),
+			_start_tag(Token(base + index[id].start_tag,
+			                 max_len - index[id].start_tag)),
+			_end_tag(index[id].empty ? _start_tag
+			                         : Tag(Token(base + index[id].end_tag,
+			                                     max_len - index[id].end_tag))),
+			_index(index), _index_id(id)
+		{ }
+
+		Index_entry const &_entry() const { return _index[_index_id]; }
+
+		/**
+		 * Return node of index entry 'id' of the same index
+		 */
+		Xml_node _indexed_node(unsigned id) const
+		{
+			if (id == Index_entry::NONE)
+				throw Nonexistent_sub_node();
+
+			return Xml_node(_index, id, _addr - _entry().addr,
+			                _max_len + _entry().addr);
+		}
+
+		/**
+		 * Return first sub node
+		 *
+		 * \throw Nonexistent_sub_node
+		 * \throw Invalid_syntax
+		 */
+		Xml_node _first_sub_node() const
+		{
+			if (_index)
+				return _indexed_node(_entry().first_child);
+
+			return _sub_node(content_addr());
+		}
+
 	public:
 
 		/**
@@ -636,7 +720,13 @@ class Genode::Xml_node
 		/**
 		 * Return size of node including start and end tags
 		 */
-		size_t size() const { return _end_tag.next_token().start() - addr(); }
+		size_t size() const
+		{
+			if (_index)
+				return _entry().end - _entry().addr;
+
+			return _end_tag.next_token().start() - addr();
+		}
 
 		/**
 		 * Return begin of node content as an opaque string
@@ -649,7 +739,13 @@ class Genode::Xml_node
 		 *
 		 * \noapi
 		 */
-		char *content_addr() const { return _start_tag.next_token().start(); }
+		char *content_addr() const
+		{
+			if (_index)
+				return (char *)_addr + (_entry().content - _entry().addr);
+
+			return _start_tag.next_token().start();
+		}
 
 		/**
 		 * Return pointer to start of content
@@ -720,6 +816,9 @@ class Genode::Xml_node
 		 */
 		Xml_node next() const
 		{
+			if (_index)
+				return _indexed_node(_entry().next_sibling);
+
 			Token after_node = _end_tag.next_token();
 			after_node = skip_non_tag_characters(after_node);
 			try { return _sub_node(after_node.start()); }
@@ -769,7 +868,7 @@ class Genode::Xml_node
 
 				/* look up node at specified index */
 				try {
-					Xml_node curr_node = _sub_node(content_addr());
+					Xml_node curr_node = _first_sub_node();
 					for (; idx > 0; idx--)
 						curr_node = curr_node.next();
 					return curr_node;
@@ -790,7 +889,7 @@ class Genode::Xml_node
 
 				/* search for sub node of specified type */
 				try {
-					Xml_node curr_node = _sub_node(content_addr());
+					Xml_node curr_node = _first_sub_node();
 					for ( ; true; curr_node = curr_node.next())
 						if (curr_node.has_type(type))
 							return curr_node;
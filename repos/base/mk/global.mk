@@ -169,6 +169,15 @@ LD_OPT_GC_SECTIONS ?= -gc-sections
 LD_OPT_ALIGN_SANE   = -z max-page-size=0x1000
 LD_OPT_PREFIX      := -Wl,
 LD_OPT             += $(LD_MARCH) $(LD_OPT_GC_SECTIONS) $(LD_OPT_ALIGN_SANE)
+
+#
+# Equip dynamic objects with both the SysV and the GNU hash table. The dynamic
+# linker prefers the GNU hash table, which rejects most lookups of undefined
+# symbols via a Bloom filter. The SysV table keeps the objects usable by tools
+# that do not support the GNU hash table.
+#
+LD_OPT_HASH_STYLE  ?= --hash-style=both
+LD_OPT             += $(LD_OPT_HASH_STYLE)
 CXX_LINK_OPT       += $(addprefix $(LD_OPT_PREFIX),$(LD_OPT))
 CXX_LINK_OPT       += $(LD_OPT_NOSTDLIB)
 
@@ -35,6 +35,10 @@ Linker::Dependency::Dependency(Env &env, Allocator &md_alloc,
 
 Linker::Dependency::~Dependency()
 {
+	/* cached symbols may refer to this dependency list or object */
+	if (_root)
+		flush_symbol_cache();
+
 	if (!_obj.unload())
 		return;
 
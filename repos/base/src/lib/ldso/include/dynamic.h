@@ -20,6 +20,8 @@
 
 namespace Linker {
 	struct Hash_table;
+	struct Gnu_hash_table;
+	class  Symbol_hash;
 	struct Dynamic;
 }
 
@@ -53,6 +55,109 @@ struct Linker::Hash_table
 };
 
 
+/**
+ * GNU hash table and hash function
+ *
+ * In contrast to the ELF hash table, the GNU hash table features a Bloom
+ * filter, which rejects most lookups of symbols that are not defined by the
+ * object without touching the hash chains. The symbols of a hash bucket are
+ * stored consecutively in the symbol table.
+ */
+struct Linker::Gnu_hash_table
+{
+	Elf::Hashelt const nbuckets;
+	Elf::Hashelt const symoffset;
+	Elf::Hashelt const bloom_size;
+	Elf::Hashelt const bloom_shift;
+
+	enum { BLOOM_WORD_BITS = sizeof(Elf::Addr)*8 };
+
+	Elf::Addr    const *bloom()   const { return (Elf::Addr const *)(this + 1); }
+	Elf::Hashelt const *buckets() const { return (Elf::Hashelt const *)(bloom() + bloom_size); }
+	Elf::Hashelt const *chains()  const { return buckets() + nbuckets; }
+
+	/**
+	 * Return false if the object does definitely not contain the symbol
+	 */
+	bool may_contain(Elf::Hashelt hash) const
+	{
+		Elf::Addr const word = bloom()[(hash / BLOOM_WORD_BITS) % bloom_size];
+		Elf::Addr const mask = ((Elf::Addr)1 << (hash % BLOOM_WORD_BITS))
+		                     | ((Elf::Addr)1 << ((hash >> bloom_shift) % BLOOM_WORD_BITS));
+
+		return (word & mask) == mask;
+	}
+
+	/**
+	 * Return number of symbols covered by the table
+	 */
+	unsigned long num_symbols() const
+	{
+		/* the chain of the highest bucket ends with the last symbol */
+		unsigned long last = 0;
+		for (unsigned long i = 0; i < nbuckets; i++)
+			if (buckets()[i] > last)
+				last = buckets()[i];
+
+		if (last < symoffset)
+			return symoffset;
+
+		while (!(chains()[last - symoffset] & 1))
+			last++;
+
+		return last + 1;
+	}
+
+	/**
+	 * GNU hash function (Bernstein)
+	 */
+	static Elf::Hashelt hash(char const *name)
+	{
+		unsigned const char *p = (unsigned char const *)name;
+		Elf::Hashelt         h = 5381;
+
+		while (*p)
+			h = h*33 + *p++;
+
+		return h;
+	}
+};
+
+
+/**
+ * Hash values of a symbol name
+ *
+ * The ELF hash value is computed only if an object without GNU hash table
+ * is consulted.
+ */
+class Linker::Symbol_hash
+{
+	private:
+
+		char const *_name;
+
+		Elf::Hashelt const _gnu = Gnu_hash_table::hash(_name);
+
+		mutable unsigned long _elf       = 0;
+		mutable bool          _elf_valid = false;
+
+	public:
+
+		Symbol_hash(char const *name) : _name(name) { }
+
+		Elf::Hashelt gnu() const { return _gnu; }
+
+		unsigned long elf() const
+		{
+			if (!_elf_valid) {
+				_elf       = Hash_table::hash(_name);
+				_elf_valid = true;
+			}
+			return _elf;
+		}
+};
+
+
 /**
  * .dynamic section entries
  */
@@ -88,6 +193,8 @@ class Linker::Dynamic
 		Allocator           *_md_alloc      = nullptr;
 
 		Hash_table          *_hash_table    = nullptr;
+		Gnu_hash_table      *_gnu_hash      = nullptr;
+		unsigned long        _num_symbols   = 0;
 
 		Elf::Rela           *_reloca        = nullptr;
 		unsigned long        _reloca_size   = 0;
@@ -152,6 +259,7 @@ class Linker::Dynamic
 				case DT_PLTRELSZ: _pltrel_size = d->un.val;                             break;
 				case DT_PLTGOT  : _section<typeof(_pltgot)>(&_pltgot, d);               break;
 				case DT_HASH    : _section<typeof(_hash_table)>(&_hash_table, d);       break;
+				case DT_GNU_HASH: _section<typeof(_gnu_hash)>(&_gnu_hash, d);           break;
 				case DT_RELA    : _section<typeof(_reloca)>(&_reloca, d);               break;
 				case DT_RELASZ  : _reloca_size = d->un.val;                             break;
 				case DT_SYMTAB  : _section<typeof(_symtab)>(&_symtab, d);               break;
@@ -167,6 +275,80 @@ class Linker::Dynamic
 					break;
 				}
 			}
+
+			if (_hash_table)
+				_num_symbols = _hash_table->nchains();
+			else if (_gnu_hash)
+				_num_symbols = _gnu_hash->num_symbols();
+		}
+
+		bool _matches(Elf::Sym const *sym, char const *name) const
+		{
+			/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
+			if (sym->type() > STT_FUNC)
+				return false;
+
+			if (sym->st_value == 0)
+				return false;
+
+			/* check for symbol name */
+			char const *sym_name = symbol_name(*sym);
+			return name[0] == sym_name[0] && !strcmp(name, sym_name);
+		}
+
+		Elf::Sym const *_lookup_gnu(char const *name, Elf::Hashelt hash) const
+		{
+			Gnu_hash_table const &h = *_gnu_hash;
+
+			if (!h.nbuckets || !h.bloom_size || !h.may_contain(hash))
+				return nullptr;
+
+			unsigned long sym_index = h.buckets()[hash % h.nbuckets];
+			if (sym_index < h.symoffset)
+				return nullptr;
+
+			/* traverse the symbols of the bucket */
+			for (; sym_index < _num_symbols; sym_index++) {
+
+				Elf::Hashelt const chain_hash = h.chains()[sym_index - h.symoffset];
+
+				/* the lowest bit of the hash value marks the end of the chain */
+				if ((chain_hash | 1) == (hash | 1)) {
+					Elf::Sym const *sym = _symtab + sym_index;
+					if (_matches(sym, name))
+						return sym;
+				}
+
+				if (chain_hash & 1)
+					break;
+			}
+
+			return nullptr;
+		}
+
+		Elf::Sym const *_lookup_elf(char const *name, unsigned long hash) const
+		{
+			Hash_table *h = _hash_table;
+
+			if (!h->buckets())
+				return nullptr;
+
+			unsigned long sym_index = h->buckets()[hash % h->nbuckets()];
+
+			/* traverse hash chain */
+			for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
+			{
+				/* bad object */
+				if (sym_index > h->nchains())
+					return nullptr;
+
+				Elf::Sym const *sym = symbol(sym_index);
+
+				if (_matches(sym, name))
+					return sym;
+			}
+
+			return nullptr;
 		}
 
 	public:
@@ -210,7 +392,7 @@ class Linker::Dynamic
 
 		Elf::Sym const *symbol(unsigned sym_index) const
 		{
-			if (sym_index > _hash_table->nchains())
+			if (sym_index > _num_symbols)
 				return nullptr;
 
 			return _symtab + sym_index;
@@ -228,46 +410,28 @@ class Linker::Dynamic
 		Dependency const &dep() const { return *_dep; }
 
 		/*
-		 * Use DT_HASH table address for linker, assuming that it will always be at
+		 * Use hash table address for linker, assuming that it will always be at
 		 * the beginning of the file
 		 */
-		Elf::Addr link_map_addr() const { return trunc_page((Elf::Addr)_hash_table); }
+		Elf::Addr link_map_addr() const
+		{
+			return trunc_page(_hash_table ? (Elf::Addr)_hash_table
+			                              : (Elf::Addr)_gnu_hash);
+		}
 
 		/**
 		 * Lookup symbol name in this ELF
+		 *
+		 * The GNU hash table is preferred over the ELF hash table if the
+		 * object provides both.
 		 */
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash) const
 		{
-			Hash_table *h = _hash_table;
-
-			if (!h->buckets())
-				return nullptr;
+			if (_gnu_hash)
+				return _lookup_gnu(name, hash.gnu());
 
-			unsigned long sym_index = h->buckets()[hash % h->nbuckets()];
-
-			/* traverse hash chain */
-			for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
-			{
-				/* bad object */
-				if (sym_index > h->nchains())
-					return nullptr;
-
-				Elf::Sym const *sym      = symbol(sym_index);
-				char const     *sym_name = symbol_name(*sym);
-
-				/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
-				if (sym->type() > STT_FUNC)
-					continue;
-
-				if (sym->st_value == 0)
-					continue;
-
-				/* check for symbol name */
-				if (name[0] != sym_name[0] || strcmp(name, sym_name))
-					continue;
-
-				return sym;
-			}
+			if (_hash_table)
+				return _lookup_elf(name, hash.elf());
 
 			return nullptr;
 		}
@@ -279,7 +443,7 @@ class Linker::Dynamic
 		{
 			addr_t const reloc_base = _obj.reloc_base();
 
-			for (unsigned long i = 0; i < _hash_table->nchains(); i++)
+			for (unsigned long i = 0; i < _num_symbols; i++)
 			{
 				Elf::Sym const *sym = symbol(i);
 				if (!sym)
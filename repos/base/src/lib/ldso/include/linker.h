@@ -82,6 +82,11 @@ namespace Linker {
 	Elf::Sym const *lookup_symbol(char const *name, Dependency const &dep, Elf::Addr *base,
 	                              bool undef = false, bool other = false);
 
+	/**
+	 * Invalidate the cache of resolved symbols
+	 */
+	void flush_symbol_cache();
+
 	/**
 	 * Load an ELF (setup segments and map program header)
 	 *
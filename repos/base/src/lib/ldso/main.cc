@@ -71,6 +71,87 @@ Genode::Lock &Linker::lock()
 }
 
 
+/**
+ * Cache of resolved symbols
+ *
+ * Most global symbols are referenced by many objects, e.g., the symbols of
+ * the libc. Without the cache, each reference is resolved by consulting the
+ * hash tables of all objects of the dependency list in order. The cache is
+ * keyed by the head of the dependency list and the symbol name. It holds
+ * only the results of lookups that do not depend on the requesting object,
+ * i.e., lookups of defined symbols across all objects of the list.
+ */
+namespace Linker { class Symbol_cache; }
+
+
+class Linker::Symbol_cache
+{
+	private:
+
+		enum { SIZE_LOG2 = 10, SIZE = 1 << SIZE_LOG2 };
+
+		struct Entry
+		{
+			Dependency const *first;
+			Elf::Hashelt      hash;
+			Elf::Sym   const *sym;
+			Elf::Addr         base;
+			char       const *name;
+		};
+
+		Lock  _lock { };
+		Entry _entries[SIZE] { };
+
+		Entry &_entry(Dependency const &first, Elf::Hashelt hash)
+		{
+			unsigned long const index = hash ^ ((addr_t)&first >> 4);
+			return _entries[index & (SIZE - 1)];
+		}
+
+	public:
+
+		Elf::Sym const *lookup(Dependency const &first, char const *name,
+		                       Symbol_hash const &hash, Elf::Addr *base)
+		{
+			Lock::Guard guard(_lock);
+
+			Entry const &e = _entry(first, hash.gnu());
+
+			if (e.first != &first || e.hash != hash.gnu() || strcmp(e.name, name))
+				return nullptr;
+
+			*base = e.base;
+			return e.sym;
+		}
+
+		void insert(Dependency const &first, Elf_object const &elf,
+		            Symbol_hash const &hash, Elf::Sym const *sym, Elf::Addr base);
+
+		/**
+		 * Invalidate all entries
+		 *
+		 * Must be called whenever a dependency is destroyed because the
+		 * entries refer to the dependency lists and symbols of the objects.
+		 */
+		void flush()
+		{
+			Lock::Guard guard(_lock);
+
+			for (unsigned i = 0; i < SIZE; i++)
+				_entries[i].first = nullptr;
+		}
+};
+
+
+static Linker::Symbol_cache &symbol_cache()
+{
+	return *unmanaged_singleton<Linker::Symbol_cache>();
+}
+
+
+void Linker::flush_symbol_cache() { symbol_cache().flush(); }
+
+
 /**************************************************************
  ** ELF object types (shared object, dynamic binaries, ldso  **
  **************************************************************/
@@ -172,7 +253,7 @@ class Linker::Elf_object : public Object, public Fifo<Elf_object>::Element
 			return _dyn.symbol_name(sym);
 		}
 
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash) const
 		{
 			return _dyn.lookup_symbol(name, hash);
 		}
@@ -475,6 +556,17 @@ struct Linker::Binary : Root_object, Elf_object
 };
 
 
+void Linker::Symbol_cache::insert(Dependency const &first, Elf_object const &elf,
+                                  Symbol_hash const &hash, Elf::Sym const *sym,
+                                  Elf::Addr base)
+{
+	Lock::Guard guard(_lock);
+
+	_entry(first, hash.gnu()) = { &first, hash.gnu(), sym, base,
+	                              elf.symbol_name(*sym) };
+}
+
+
 /***************************************
  ** Global Linker namespace functions **
  ***************************************/
@@ -527,11 +619,23 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
                                       Elf::Addr *base, bool undef, bool other)
 {
 	Dependency const *curr        = &dep.first();
-	unsigned long     hash        = Hash_table::hash(name);
+	Symbol_hash const hash(name);
 	Elf::Sym   const *weak_symbol = 0;
 	Elf::Addr        weak_base    = 0;
+	Elf_object const *weak_elf    = 0;
 	Elf::Sym   const *symbol      = 0;
 
+	/*
+	 * The result of looking up a defined symbol depends only on the
+	 * dependency list. The linker's self relocation, which uses a
+	 * dependency without root, must not touch any global state.
+	 */
+	bool const cacheable = dep.root() && !undef && !other;
+
+	if (cacheable)
+		if (Elf::Sym const *cached = symbol_cache().lookup(*curr, name, hash, base))
+			return cached;
+
 	//TODO: handle vertab and search in object list
 	for (;curr; curr = curr->next()) {
 
@@ -552,12 +656,17 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
 
 			if (!symbol->weak() && symbol->st_shndx != SHN_UNDEF) {
 				*base = elf.reloc_base();
+
+				if (cacheable)
+					symbol_cache().insert(dep.first(), elf, hash, symbol, *base);
+
 				return symbol;
 			}
 
 			if (!weak_symbol) {
 				weak_symbol = symbol;
 				weak_base   = elf.reloc_base();
+				weak_elf    = &elf;
 			}
 		}
 	}
@@ -577,6 +686,9 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
 	if (!weak_symbol)
 		throw Not_found(name);
 
+	if (cacheable)
+		symbol_cache().insert(dep.first(), *weak_elf, hash, weak_symbol, weak_base);
+
 	*base = weak_base;
 	return weak_symbol;
 }
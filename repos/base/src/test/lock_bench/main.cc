@@ -0,0 +1,168 @@
+/*
+ * \brief  Lock-contention benchmark
+ * \author agent
+ * \date   2026-10-17
+ *
+ * A number of threads repeatedly enter a short critical section protected by
+ * one shared lock. The test reports the throughput in critical sections per
+ * second and the distribution of the time needed to acquire the lock.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/thread.h>
+#include <base/log.h>
+#include <util/reconstructible.h>
+#include <timer_session/connection.h>
+#include <trace/timestamp.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Latency_histogram;
+	struct Worker;
+	struct Main;
+}
+
+
+/**
+ * Histogram of lock-acquisition latencies with power-of-two buckets
+ */
+struct Test::Latency_histogram
+{
+	enum { NUM_BUCKETS = 64 };
+
+	unsigned long count[NUM_BUCKETS] { };
+
+	static unsigned _bucket(Trace::Timestamp cycles)
+	{
+		unsigned i = 0;
+		for (; cycles > 1 && i < NUM_BUCKETS - 1; cycles >>= 1, i++);
+		return i;
+	}
+
+	void record(Trace::Timestamp cycles) { count[_bucket(cycles)]++; }
+
+	void add(Latency_histogram const &other)
+	{
+		for (unsigned i = 0; i < NUM_BUCKETS; i++)
+			count[i] += other.count[i];
+	}
+
+	/**
+	 * Return upper bound of the latency in cycles for the given permille
+	 */
+	unsigned long long percentile(unsigned permille) const
+	{
+		unsigned long total = 0;
+		for (unsigned i = 0; i < NUM_BUCKETS; i++)
+			total += count[i];
+
+		unsigned long const threshold = (total*permille)/1000;
+
+		unsigned long sum = 0;
+		for (unsigned i = 0; i < NUM_BUCKETS; i++) {
+			sum += count[i];
+			if (sum >= threshold && sum > 0)
+				return 2ULL << i;
+		}
+		return 0;
+	}
+};
+
+
+struct Test::Worker : Thread
+{
+	enum { STACK_SIZE = 4*1024*sizeof(long) };
+
+	Lock          &_lock;
+	unsigned long &_shared_counter;
+	unsigned const _sections;
+
+	Latency_histogram histogram { };
+
+	Worker(Env &env, Lock &lock, unsigned long &shared_counter, unsigned sections)
+	:
+		Thread(env, "worker", STACK_SIZE),
+		_lock(lock), _shared_counter(shared_counter), _sections(sections)
+	{ }
+
+	void entry() override
+	{
+		for (unsigned i = 0; i < _sections; i++) {
+
+			Trace::Timestamp const start = Trace::timestamp();
+
+			Lock::Guard guard(_lock);
+
+			histogram.record(Trace::timestamp() - start);
+
+			/* short critical section */
+			_shared_counter++;
+		}
+	}
+};
+
+
+struct Test::Main
+{
+	enum { MAX_THREADS = 16, SECTIONS = 200000 };
+
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	void _measure(unsigned num_threads)
+	{
+		Lock          lock;
+		unsigned long shared_counter = 0;
+
+		Constructible<Worker> workers[MAX_THREADS];
+
+		for (unsigned i = 0; i < num_threads; i++)
+			workers[i].construct(_env, lock, shared_counter, (unsigned)SECTIONS);
+
+		unsigned long const start_ms = _timer.elapsed_ms();
+
+		for (unsigned i = 0; i < num_threads; i++) workers[i]->start();
+		for (unsigned i = 0; i < num_threads; i++) workers[i]->join();
+
+		unsigned long const duration_ms = max(1UL, _timer.elapsed_ms() - start_ms);
+
+		Latency_histogram histogram;
+		for (unsigned i = 0; i < num_threads; i++)
+			histogram.add(workers[i]->histogram);
+
+		unsigned long const expected = (unsigned long)num_threads*SECTIONS;
+		if (shared_counter != expected)
+			error("lock is broken, counter=", shared_counter, " expected=", expected);
+
+		log(num_threads, " threads x ", (unsigned)SECTIONS, " sections: ",
+		    duration_ms, " ms, ", (expected*1000)/duration_ms, " sections/s, "
+		    "acquisition cycles p50<", histogram.percentile(500),
+		    " p99<",   histogram.percentile(990),
+		    " p99.9<", histogram.percentile(999),
+		    " max<",   histogram.percentile(1000));
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- lock benchmark started ---");
+
+		for (unsigned num_threads = 1; num_threads <= MAX_THREADS; num_threads *= 2)
+			_measure(num_threads);
+
+		log("--- lock benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-lock_bench
+SRC_CC = main.cc
+LIBS   = base
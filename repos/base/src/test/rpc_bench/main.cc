@@ -0,0 +1,121 @@
+/*
+ * \brief  Ping-pong RPC benchmark
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The test measures the round-trip rate of RPC calls between a client and an
+ * entrypoint within the same component.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/rpc_server.h>
+#include <base/rpc_client.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Session;
+	struct Client;
+	struct Component;
+	struct Main;
+}
+
+
+struct Test::Session : Genode::Session
+{
+	static const char *service_name() { return "RPC_BENCH"; }
+
+	enum { CAP_QUOTA = 2 };
+
+	GENODE_RPC(Rpc_ping, unsigned, ping, unsigned);
+	GENODE_RPC(Rpc_ping_cap, void, ping_cap, Genode::Native_capability);
+	GENODE_RPC_INTERFACE(Rpc_ping, Rpc_ping_cap);
+};
+
+
+struct Test::Client : Genode::Rpc_client<Session>
+{
+	Client(Capability<Session> cap) : Rpc_client<Session>(cap) { }
+
+	unsigned ping(unsigned value) { return call<Rpc_ping>(value); }
+
+	void ping_cap(Native_capability cap) { call<Rpc_ping_cap>(cap); }
+};
+
+
+struct Test::Component : Genode::Rpc_object<Session, Component>
+{
+	unsigned ping(unsigned value) { return value + 1; }
+
+	void ping_cap(Native_capability) { }
+};
+
+
+struct Test::Main
+{
+	enum { STACK_SIZE = 4*1024*sizeof(long), ROUNDS = 5, CALLS = 20000 };
+
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Entrypoint _ep { _env, STACK_SIZE, "rpc_bench_ep" };
+
+	Component _component { };
+
+	Capability<Session> _cap { _ep.manage(_component) };
+
+	Client _client { _cap };
+
+	template <typename FN>
+	void _measure(char const *name, FN const &fn)
+	{
+		for (unsigned round = 0; round < ROUNDS; round++) {
+
+			unsigned long const start_ms = _timer.elapsed_ms();
+
+			for (unsigned i = 0; i < CALLS; i++)
+				fn(i);
+
+			unsigned long const duration_ms =
+				max(1UL, _timer.elapsed_ms() - start_ms);
+
+			log(name, ": ", (unsigned)CALLS, " calls in ", duration_ms, " ms "
+			    "(", ((unsigned long)CALLS*1000)/duration_ms, " calls/s)");
+		}
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- RPC benchmark started ---");
+
+		_measure("ping", [&] (unsigned i) {
+			if (_client.ping(i) != i + 1) {
+				struct Unexpected_rpc_result { };
+				throw Unexpected_rpc_result();
+			}
+		});
+
+		Native_capability const cap = _cap;
+		_measure("ping with capability argument", [&] (unsigned) {
+			_client.ping_cap(cap); });
+
+		_ep.dissolve(_component);
+
+		log("--- RPC benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
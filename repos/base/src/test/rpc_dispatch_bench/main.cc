@@ -0,0 +1,207 @@
+/*
+ * \brief  Benchmark of the RPC-object lookup with many objects
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The test manages 10000 RPC objects at a few entrypoints and lets a
+ * varying number of client threads access randomly selected objects. The
+ * "lookup" phase measures the translation of capabilities to objects via
+ * the object pools of the entrypoints only. The "dispatch" phase performs
+ * actual RPC calls, which includes the lookup at the server side.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/rpc_server.h>
+#include <base/thread.h>
+#include <util/reconstructible.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Object_interface;
+	struct Object;
+	struct Client;
+	struct Main;
+
+	enum {
+		NUM_OBJECTS     = 10000,
+		NUM_EPS         = 4,
+		MAX_CLIENTS     = 8,
+		STACK_SIZE      = 4*1024*sizeof(long),
+		LOOKUPS         = 200000,
+		CALLS           = 20000,
+	};
+}
+
+
+struct Test::Object_interface
+{
+	GENODE_RPC(Rpc_id, unsigned, id);
+	GENODE_RPC_INTERFACE(Rpc_id);
+};
+
+
+struct Test::Object : Rpc_object<Object_interface, Object>
+{
+	unsigned const _id;
+
+	Capability<Object_interface> cap { };
+
+	Object(unsigned id) : _id(id) { }
+
+	unsigned id() { return _id; }
+};
+
+
+struct Test::Client : Thread
+{
+	enum Mode { LOOKUP, DISPATCH };
+
+	Object         ** const _objects;
+	Rpc_entrypoint ** const _eps;
+	Mode              const _mode;
+	unsigned                _random;
+
+	unsigned long errors = 0;
+
+	/**
+	 * Return entrypoint that manages the object of index 'i'
+	 */
+	Rpc_entrypoint &_ep(unsigned i) { return *_eps[i % NUM_EPS]; }
+
+	unsigned _next_random()
+	{
+		_random ^= _random << 13;
+		_random ^= _random >> 17;
+		_random ^= _random << 5;
+		return _random;
+	}
+
+	Client(Env &env, unsigned index, Object **objects, Rpc_entrypoint **eps,
+	       Mode mode)
+	:
+		Thread(env, "client", STACK_SIZE,
+		       env.cpu().affinity_space().location_of_index(index),
+		       Weight(), env.cpu()),
+		_objects(objects), _eps(eps), _mode(mode),
+		_random(0x9e3779b9U*(index + 1))
+	{ }
+
+	void entry() override
+	{
+		unsigned const rounds = (_mode == LOOKUP) ? LOOKUPS : CALLS;
+
+		for (unsigned i = 0; i < rounds; i++) {
+
+			unsigned const idx = _next_random() % NUM_OBJECTS;
+			Object &obj = *_objects[idx];
+
+			bool const ok = (_mode == LOOKUP)
+				? _ep(idx).apply(obj.cap, [&] (Object *o) {
+					return o && o->_id == idx; })
+				: obj.cap.call<Object_interface::Rpc_id>() == idx;
+
+			if (!ok)
+				errors++;
+		}
+	}
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Rpc_entrypoint *_eps[NUM_EPS];
+
+	Object *_objects[NUM_OBJECTS];
+
+	Constructible<Client> _clients[MAX_CLIENTS];
+
+	void _measure(char const *name, Client::Mode mode, unsigned num_clients)
+	{
+		unsigned long const start_ms = _timer.elapsed_ms();
+
+		for (unsigned i = 0; i < num_clients; i++) {
+			_clients[i].construct(_env, i, _objects, _eps, mode);
+			_clients[i]->start();
+		}
+
+		unsigned long errors = 0;
+		for (unsigned i = 0; i < num_clients; i++) {
+			_clients[i]->join();
+			errors += _clients[i]->errors;
+			_clients[i].destruct();
+		}
+
+		unsigned long const duration_ms =
+			max(1UL, _timer.elapsed_ms() - start_ms);
+
+		unsigned long const ops = (unsigned long)num_clients
+		                        * ((mode == Client::LOOKUP) ? LOOKUPS : CALLS);
+
+		log(name, ": clients=", num_clients, " operations=", ops, " in ",
+		    duration_ms, " ms (", (ops*1000)/duration_ms, " ops/s)");
+
+		if (errors) {
+			error(name, ": ", errors, " lookups returned the wrong object");
+			struct Unexpected_object { };
+			throw Unexpected_object();
+		}
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- RPC dispatch benchmark started ---");
+
+		Affinity::Space space = _env.cpu().affinity_space();
+
+		for (unsigned i = 0; i < NUM_EPS; i++)
+			_eps[i] = new (_heap)
+				Rpc_entrypoint(&_env.pd(), STACK_SIZE, "ep", true,
+				               space.location_of_index(i));
+
+		for (unsigned i = 0; i < NUM_OBJECTS; i++) {
+			_objects[i] = new (_heap) Object(i);
+			_objects[i]->cap = _eps[i % NUM_EPS]->manage(_objects[i]);
+		}
+
+		log("managing ", (unsigned)NUM_OBJECTS, " objects at ",
+		    (unsigned)NUM_EPS, " entrypoints");
+
+		for (unsigned n = 1; n <= MAX_CLIENTS; n *= 2)
+			_measure("lookup", Client::LOOKUP, n);
+
+		for (unsigned n = 1; n <= MAX_CLIENTS; n *= 2)
+			_measure("dispatch", Client::DISPATCH, n);
+
+		for (unsigned i = 0; i < NUM_OBJECTS; i++) {
+			_eps[i % NUM_EPS]->dissolve(_objects[i]);
+			destroy(_heap, _objects[i]);
+		}
+
+		for (unsigned i = 0; i < NUM_EPS; i++)
+			destroy(_heap, _eps[i]);
+
+		log("--- RPC dispatch benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
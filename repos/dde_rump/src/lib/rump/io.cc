@@ -14,6 +14,7 @@
 #include "sched.h"
 #include <base/allocator_avl.h>
 #include <base/printf.h>
+#include <base/semaphore.h>
 #include <block_session/connection.h>
 #include <rump/env.h>
 #include <rump_fs/fs.h>
@@ -25,18 +26,266 @@ enum  { GENODE_FD = 64 };
 
 /**
  * Block session connection
+ *
+ * Requests of different rump threads are kept in flight concurrently. The
+ * submitting thread holds the session lock only for allocating and submitting
+ * the packet. Acknowledgements are picked up by a dedicated completion
+ * thread, which matches them to the pending requests by the offset of the
+ * packet within the bulk buffer and signals the completion to the rump
+ * kernel by calling the biodone function of the request.
  */
 class Backend
 {
 	private:
 
+		enum {
+			TX_BUF_SIZE  = 1024*1024,
+			MAX_REQUESTS = 64,
+		};
+
+		struct Request
+		{
+			Block::Packet_descriptor packet { };
+
+			bool             used    = false;
+			int              op      = 0;
+			void            *data    = nullptr;
+			size_t           length  = 0;
+			rump_biodone_fn  biodone = nullptr;
+			void            *donearg = nullptr;
+
+			/* used to wait for the completion if there is no biodone function */
+			Genode::Semaphore *done      = nullptr;
+			bool              *succeeded = nullptr;
+		};
+
 		Genode::Allocator_avl              _alloc { &Rump::env().heap() };
-		Block::Connection                  _session { Rump::env().env(), &_alloc };
+		Block::Connection                  _session { Rump::env().env(), &_alloc,
+		                                              TX_BUF_SIZE };
 		Genode::size_t                     _blk_size; /* block size of the device   */
 		Block::sector_t                    _blk_cnt;  /* number of blocks of device */
 		Block::Session::Operations         _blk_ops;
 		Genode::Lock                       _session_lock;
 
+		Request _requests[MAX_REQUESTS];
+
+		/* bounds the requests in flight, which never exceeds the queue sizes */
+		Genode::Semaphore _free_requests { MAX_REQUESTS };
+
+		/* threads waiting for space in the bulk buffer */
+		unsigned          _alloc_waiters = 0;
+		Genode::Semaphore _alloc_sem { 0 };
+
+		Hard_context_thread _completion_thread {
+			"rump_bio", &Backend::_completion_entry, this, 0, false };
+
+		bool _completion_started = false;
+
+		static void *_completion_entry(void *arg)
+		{
+			static_cast<Backend *>(arg)->_completion_loop();
+			return nullptr;
+		}
+
+		Request *_lookup(Block::Packet_descriptor const &packet)
+		{
+			for (unsigned i = 0; i < MAX_REQUESTS; i++) {
+				Request &r = _requests[i];
+				if (r.used && r.packet.offset() == packet.offset())
+					return &r;
+			}
+			return nullptr;
+		}
+
+		void _complete(Request &request, Block::Packet_descriptor const &packet)
+		{
+			using namespace Block;
+
+			/* in packet */
+			if (packet.operation() == Packet_descriptor::READ && packet.succeeded())
+				Genode::memcpy(request.data,
+				               _session.tx()->packet_content(packet),
+				               request.length);
+
+			bool const succeeded = packet.succeeded();
+
+			/* sync request, the device does not support FUA writes */
+			if ((request.op & RUMPUSER_BIO_SYNC) && !_in_band_sync())
+				_session.sync();
+
+			Request const r = request;
+
+			{
+				Genode::Lock::Guard guard(_session_lock);
+
+				_session.tx()->release_packet(packet);
+				request.used = false;
+
+				if (_alloc_waiters) {
+					_alloc_waiters--;
+					_alloc_sem.up();
+				}
+			}
+			_free_requests.up();
+
+			if (r.done) {
+				*r.succeeded = succeeded;
+				r.done->up();
+				return;
+			}
+
+			_rump_upcalls.hyp_schedule();
+			r.biodone(r.donearg, r.length, succeeded ? 0 : EIO);
+			_rump_upcalls.hyp_unschedule();
+		}
+
+		void _completion_loop()
+		{
+			/* the completion thread needs a lwp for calling biodone */
+			_rump_upcalls.hyp_schedule();
+			_rump_upcalls.hyp_lwproc_newlwp(0);
+			_rump_upcalls.hyp_unschedule();
+
+			for (;;) {
+
+				/*
+				 * The ack queue is consumed by this thread only, hence
+				 * blocking for an acknowledgement does not need the lock.
+				 */
+				Block::Packet_descriptor const packet =
+					_session.tx()->get_acked_packet();
+
+				Request *request = nullptr;
+				{
+					Genode::Lock::Guard guard(_session_lock);
+
+					request = _lookup(packet);
+					if (!request) {
+						Genode::error("I/O back end: acknowledgement of unknown packet");
+						_session.tx()->release_packet(packet);
+						continue;
+					}
+				}
+
+				_complete(*request, packet);
+			}
+		}
+
+		/**
+		 * Allocate packet and enter request into table
+		 *
+		 * Must be called with the session lock held. Returns nullptr if
+		 * the bulk buffer is exhausted.
+		 */
+		Request *_alloc_request(Block::Packet_descriptor::Opcode opcode,
+		                        int64_t offset, size_t length)
+		{
+			using namespace Block;
+
+			Request *request = nullptr;
+			for (unsigned i = 0; i < MAX_REQUESTS && !request; i++)
+				if (!_requests[i].used)
+					request = &_requests[i];
+
+			/* a SYNC request occupies one block to obtain a distinct tag */
+			size_t const size = opcode == Packet_descriptor::SYNC ? _blk_size
+			                                                      : length;
+			try {
+				request->packet = Packet_descriptor(_session.dma_alloc_packet(size),
+				                                    opcode, offset / _blk_size,
+				                                    length / _blk_size);
+			} catch (Session::Tx::Source::Packet_alloc_failed) {
+				return nullptr;
+			}
+
+			request->used = true;
+			return request;
+		}
+
+		unsigned _num_in_flight() const
+		{
+			unsigned n = 0;
+			for (unsigned i = 0; i < MAX_REQUESTS; i++)
+				if (_requests[i].used)
+					n++;
+			return n;
+		}
+
+		/*
+		 * Devices that support SYNC requests also honor FUA writes
+		 */
+		bool _in_band_sync()
+		{
+			return _blk_ops.supported(Block::Packet_descriptor::SYNC);
+		}
+
+		bool _submit(Block::Packet_descriptor::Opcode opcode, int op,
+		             int64_t offset, size_t length, void *data,
+		             rump_biodone_fn biodone, void *donearg)
+		{
+			using namespace Block;
+
+			Genode::Semaphore done { 0 };
+			bool succeeded = false;
+
+			_free_requests.down();
+
+			_session_lock.lock();
+
+			if (!_completion_started) {
+				_completion_thread.start();
+				_completion_started = true;
+			}
+
+			Request *request = nullptr;
+			while (!(request = _alloc_request(opcode, offset, length))) {
+
+				/* the request does not fit into the bulk buffer at all */
+				if (_num_in_flight() == 0) {
+					_session_lock.unlock();
+					_free_requests.up();
+					Genode::error("I/O back end: Packet allocation failed!");
+					return false;
+				}
+
+				/* wait until a completed request frees its packet */
+				_alloc_waiters++;
+				_session_lock.unlock();
+				_alloc_sem.down();
+				_session_lock.lock();
+			}
+
+			request->op        = op;
+			request->data      = data;
+			request->length    = length;
+			request->biodone   = biodone;
+			request->donearg   = donearg;
+			request->done      = biodone ? nullptr : &done;
+			request->succeeded = biodone ? nullptr : &succeeded;
+
+			/* out packet -> copy data */
+			if (opcode == Packet_descriptor::WRITE) {
+				Genode::memcpy(_session.tx()->packet_content(request->packet),
+				               data, length);
+
+				request->packet.fua((op & RUMPUSER_BIO_SYNC) && _in_band_sync());
+			}
+
+			/*
+			 * The number of requests in flight is bounded by MAX_REQUESTS,
+			 * which is below the size of the submit queue. So submitting
+			 * never blocks while holding the lock.
+			 */
+			_session.tx()->submit_packet(request->packet);
+			_session_lock.unlock();
+
+			if (biodone)
+				return true;
+
+			done.down();
+			return succeeded;
+		}
+
 	public:
 
 		Backend()
@@ -52,53 +301,43 @@ class Backend
 			return _blk_ops.supported(Block::Packet_descriptor::WRITE);
 		}
 
+		/**
+		 * Synchronize device
+		 *
+		 * A SYNC request is ordered with respect to the requests in
+		 * flight. It is acknowledged after all requests submitted before.
+		 */
 		void sync()
 		{
-			Genode::Lock::Guard guard(_session_lock);
-			_session.sync();
+			if (!_in_band_sync()) {
+				_session.sync();
+				return;
+			}
+
+			_submit(Block::Packet_descriptor::SYNC, 0, 0, 0, nullptr,
+			        nullptr, nullptr);
 		}
 
-		bool submit(int op, int64_t offset, size_t length, void *data)
+		/**
+		 * Submit request
+		 *
+		 * If 'biodone' is defined, the function returns as soon as the
+		 * request is submitted and 'biodone' is called by the completion
+		 * thread. Otherwise, the function blocks until the request is
+		 * completed.
+		 *
+		 * \return false if the request could not be submitted or failed
+		 */
+		bool submit(int op, int64_t offset, size_t length, void *data,
+		            rump_biodone_fn biodone, void *donearg)
 		{
 			using namespace Block;
 
-			Genode::Lock::Guard guard(_session_lock);
-
 			Packet_descriptor::Opcode opcode;
 			opcode = op & RUMPUSER_BIO_WRITE ? Packet_descriptor::WRITE :
 			                                   Packet_descriptor::READ;
-			/* allocate packet */
-			try {
-				Packet_descriptor packet( _session.dma_alloc_packet(length),
-				                         opcode, offset / _blk_size,
-				                         length / _blk_size);
-
-				/* out packet -> copy data */
-				if (opcode == Packet_descriptor::WRITE)
-					Genode::memcpy(_session.tx()->packet_content(packet), data, length);
-
-				_session.tx()->submit_packet(packet);
-			} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
-				Genode::error("I/O back end: Packet allocation failed!");
-				return false;
-			}
-
-			/* wait and process result */
-			Packet_descriptor packet = _session.tx()->get_acked_packet();
-
-			/* in packet */
-			if (opcode == Packet_descriptor::READ)
-				Genode::memcpy(data, _session.tx()->packet_content(packet), length);
 
-			bool succeeded = packet.succeeded();
-			_session.tx()->release_packet(packet);
-
-			/* sync request */
-			if (op & RUMPUSER_BIO_SYNC) {
-				_session.sync();
-			}
-
-			return succeeded;
+			return _submit(opcode, op, offset, length, data, biodone, donearg);
 		}
 };
 
@@ -154,12 +393,16 @@ void rumpuser_bio(int fd, int op, void *data, size_t dlen, int64_t off,
 		            "bio ",   donearg, " "
 		            "sync: ", !!(op & RUMPUSER_BIO_SYNC));
 
-	bool succeeded = backend().submit(op, off, dlen, data);
+	/*
+	 * If the request could be submitted, 'biodone' is called by the
+	 * completion thread of the back end.
+	 */
+	bool const submitted = backend().submit(op, off, dlen, data, biodone, donearg);
 
 	rumpkern_sched(nlocks, 0);
 
-	if (biodone)
-		biodone(donearg, dlen, succeeded ? 0 : EIO);
+	if (!submitted && biodone)
+		biodone(donearg, 0, EIO);
 }
 
 
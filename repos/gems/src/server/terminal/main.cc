@@ -35,6 +35,7 @@
 
 /* nitpicker graphic back end */
 #include <nitpicker_gfx/text_painter.h>
+#include <nitpicker_gfx/glyph_cache.h>
 
 namespace Terminal {
 	using namespace Genode;
@@ -49,30 +50,6 @@ typedef Text_painter::Font Font;
 static bool const verbose = false;
 
 
-inline Pixel_rgb565 blend(Pixel_rgb565 src, int alpha)
-{
-	Pixel_rgb565 res;
-	res.pixel = ((((alpha >> 3) * (src.pixel & 0xf81f)) >> 5) & 0xf81f)
-	          | ((( alpha       * (src.pixel & 0x07c0)) >> 8) & 0x07c0);
-	return res;
-}
-
-
-inline Pixel_rgb565 mix(Pixel_rgb565 p1, Pixel_rgb565 p2, int alpha)
-{
-	Pixel_rgb565 res;
-
-	/*
-	 * We substract the alpha from 264 instead of 255 to
-	 * compensate the brightness loss caused by the rounding
-	 * error of the blend function when having only 5 bits
-	 * per channel.
-	 */
-	res.pixel = blend(p1, 264 - alpha).pixel + blend(p2, alpha).pixel;
-	return res;
-}
-
-
 using Genode::Color;
 
 
@@ -125,52 +102,28 @@ class Font_family
 
 
 template <typename PT>
-inline void draw_glyph(Color                fg_color,
+inline void draw_glyph(Glyph_cache         &glyph_cache,
+                       Font const          &font,
+                       unsigned char        ascii,
+                       Color                fg_color,
                        Color                bg_color,
-                       const unsigned char *glyph_base,
-                       unsigned             glyph_width,
-                       unsigned             glyph_img_width,
-                       unsigned             glyph_img_height,
                        unsigned             cell_width,
                        PT                  *fb_base,
                        unsigned             fb_width)
 {
-	PT fg_pixel(fg_color.r, fg_color.g, fg_color.b);
-	PT bg_pixel(bg_color.r, bg_color.g, bg_color.b);
+	PT const bg_pixel(bg_color.r, bg_color.g, bg_color.b);
 
-	unsigned const horizontal_gap = cell_width
-	                              - Genode::min(glyph_width, cell_width);
-
-	unsigned const  left_gap = horizontal_gap / 2;
-	unsigned const right_gap = horizontal_gap - left_gap;
-
-	/*
-	 * Clear gaps to the left and right of the character if the character's
-	 * with is smaller than the cell width.
-	 */
-	if (horizontal_gap) {
-
-		PT *line = fb_base;
-		for (unsigned y = 0 ; y < glyph_img_height; y++, line += fb_width) {
-
-			for (unsigned x = 0; x < left_gap; x++)
-				line[x] = bg_pixel;
-
-			for (unsigned x = cell_width - right_gap; x < cell_width; x++)
-				line[x] = bg_pixel;
-		}
-	}
+	/* clear cell, the glyph is drawn on top */
+	PT *line = fb_base;
+	for (int y = 0 ; y < font.img_h; y++, line += fb_width)
+		Genode::Pixel_row<PT>::fill(line, bg_pixel, cell_width);
 
 	/* center glyph horizontally within its cell */
-	fb_base += left_gap;
-
-	for (unsigned y = 0 ; y < glyph_img_height; y++) {
-		for (unsigned x = 0; x < glyph_width; x++)
-			fb_base[x] = mix(bg_pixel, fg_pixel, glyph_base[x]);
+	unsigned const glyph_width    = font.wtab[ascii];
+	unsigned const horizontal_gap = cell_width
+	                              - Genode::min(glyph_width, cell_width);
 
-		fb_base    += fb_width;
-		glyph_base += glyph_img_width;
-	}
+	glyph_cache.draw(fb_base + horizontal_gap/2, fb_width, font, fg_color, ascii);
 }
 
 
@@ -179,7 +132,8 @@ static void convert_char_array_to_pixels(Cell_array<Char_cell> *cell_array,
                                          PT                    *fb_base,
                                          unsigned               fb_width,
                                          unsigned               fb_height,
-                                         Font_family const     &font_family)
+                                         Font_family const     &font_family,
+                                         Glyph_cache           &glyph_cache)
 {
 	Font const &regular_font = *font_family.font(Font_face::REGULAR);
 	unsigned glyph_height = regular_font.img_h,
@@ -193,8 +147,12 @@ static void convert_char_array_to_pixels(Cell_array<Char_cell> *cell_array,
 			if (verbose)
 				Genode::log("convert line ", line);
 
-			unsigned x = 0;
-			for (unsigned column = 0; column < cell_array->num_cols(); column++) {
+			unsigned const first = cell_array->first_dirty_col(line),
+			               last  = Genode::min(cell_array->last_dirty_col(line),
+			                                   cell_array->num_cols() - 1);
+
+			unsigned x = first*glyph_step_x;
+			for (unsigned column = first; column <= last; column++) {
 
 				Char_cell      cell  = cell_array->get_cell(column, line);
 				Font const    *font  = font_family.font(cell.font_face());
@@ -203,8 +161,6 @@ static void convert_char_array_to_pixels(Cell_array<Char_cell> *cell_array,
 				if (ascii == 0)
 					ascii = ' ';
 
-				unsigned char const *glyph_base  = font->img + font->otab[ascii];
-
 				unsigned glyph_width = regular_font.wtab[ascii];
 
 				if (x + glyph_width > fb_width)	break;
@@ -217,9 +173,7 @@ static void convert_char_array_to_pixels(Cell_array<Char_cell> *cell_array,
 					bg_color = Color(255, 255, 255);
 				}
 
-				draw_glyph<PT>(fg_color, bg_color,
-				               glyph_base, glyph_width,
-				               (unsigned)font->img_w, (unsigned)font->img_h,
+				draw_glyph<PT>(glyph_cache, *font, ascii, fg_color, bg_color,
 				               glyph_step_x, fb_base + x, fb_width);
 
 				x += glyph_step_x;
@@ -306,6 +260,8 @@ namespace Terminal {
 
 			Font_family const               &_font_family;
 
+			Glyph_cache                      _glyph_cache;
+
 			/**
 			 * Initialize framebuffer-related attributes
 			 */
@@ -353,7 +309,8 @@ namespace Terminal {
 				_char_cell_array_character_screen(_char_cell_array),
 				_decoder(_char_cell_array_character_screen),
 
-				_font_family(font_family)
+				_font_family(font_family),
+				_glyph_cache(alloc)
 			{
 				using namespace Genode;
 
@@ -372,19 +329,61 @@ namespace Terminal {
 				_flush_callback_registry.remove(this);
 			}
 
+			/**
+			 * Move the pixels of the lines of the scroll region
+			 */
+			void _scroll_pixels(Cell_array<Char_cell>::Scroll const &scroll)
+			{
+				unsigned const num_lines = scroll.end - scroll.start + 1,
+				               shift     = Genode::abs(scroll.lines);
+
+				/* all lines were scrolled out and are dirty */
+				if (shift >= num_lines)
+					return;
+
+				bool     const up        = scroll.lines > 0;
+				size_t   const row_bytes = _fb_mode.width()*sizeof(Pixel_rgb565);
+				unsigned const rows      = (num_lines - shift)*_char_height,
+				               offset    = shift*_char_height;
+
+				char * const base = (char *)_fb_addr
+				                  + scroll.start*_char_height*row_bytes;
+
+				/*
+				 * Each row is copied to a different row. When scrolling down,
+				 * start at the bottom to not overwrite rows that are yet to be
+				 * copied.
+				 */
+				for (unsigned i = 0; i < rows; i++) {
+					unsigned const row  = up ? i : rows - 1 - i;
+					char          *from = base + row*row_bytes, *to = from;
+					if (up) from += offset*row_bytes;
+					else    to   += offset*row_bytes;
+					Genode::memcpy(to, from, row_bytes);
+				}
+			}
+
 			void flush()
 			{
 				Genode::Lock::Guard guard(_lock);
 
+				/* only the lines scrolled in are dirty, move the others */
+				Cell_array<Char_cell>::Scroll const scroll = _char_cell_array.scroll();
+				if (scroll.pending())
+					_scroll_pixels(scroll);
+
+				_char_cell_array.mark_scroll_as_done();
+
 				convert_char_array_to_pixels<Pixel_rgb565>(&_char_cell_array,
 				                                           (Pixel_rgb565 *)_fb_addr,
 				                                           _fb_mode.width(),
 				                                           _fb_mode.height(),
-				                                           _font_family);
+				                                           _font_family,
+				                                           _glyph_cache);
 
-				
-				int first_dirty_line =  10000,
-				    last_dirty_line  = -10000;
+				/* determine bounding box of the dirty cells */
+				int first_dirty_line =  10000, last_dirty_line = -10000,
+				    first_dirty_col  =  10000, last_dirty_col  = -10000;
 
 				for (int line = 0; line < (int)_char_cell_array.num_lines(); line++) {
 					if (!_char_cell_array.line_dirty(line)) continue;
@@ -392,13 +391,29 @@ namespace Terminal {
 					first_dirty_line = Genode::min(line, first_dirty_line);
 					last_dirty_line  = Genode::max(line, last_dirty_line);
 
+					first_dirty_col = Genode::min((int)_char_cell_array.first_dirty_col(line),
+					                              first_dirty_col);
+					last_dirty_col  = Genode::max((int)_char_cell_array.last_dirty_col(line),
+					                              last_dirty_col);
+
 					_char_cell_array.mark_line_as_clean(line);
 				}
 
+				if (scroll.pending())
+					_framebuffer.refresh(0, scroll.start*_char_height,
+					                     _fb_mode.width(),
+					                     (scroll.end - scroll.start + 1)*_char_height);
+
+				/* skip dirty cells within the already refreshed scroll region */
+				if (scroll.pending() && first_dirty_line >= scroll.start
+				                     && last_dirty_line  <= scroll.end)
+					return;
+
 				int num_dirty_lines = last_dirty_line - first_dirty_line + 1;
 				if (num_dirty_lines > 0)
-					_framebuffer.refresh(0, first_dirty_line*_char_height,
-					                     _fb_mode.width(),
+					_framebuffer.refresh(first_dirty_col*_char_width,
+					                     first_dirty_line*_char_height,
+					                     (last_dirty_col - first_dirty_col + 1)*_char_width,
 					                     num_dirty_lines*_char_height);
 			}
 
@@ -240,6 +240,9 @@ class Terminal::Session_component : public Genode::Rpc_object<Session, Session_c
 
 		void flush() override
 		{
+			/* the window has no means to move lines, redraw them instead */
+			_char_cell_array.mark_scroll_as_dirty();
+
 			convert_char_array_to_window(&_char_cell_array, _window);
 
 			int first_dirty_line =  10000,
@@ -0,0 +1,109 @@
+/*
+ * \brief  Throughput benchmark of the terminal session
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The benchmark writes lines of text of varying lengths through a terminal
+ * session, similar to the output of a build process, and reports the time
+ * needed for the configured amount of data.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+#include <terminal_session/connection.h>
+#include <os/bench.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	size_t const _size =
+		_config.xml().attribute_value("size", Number_of_bytes(100*1024*1024));
+
+	size_t const _chunk =
+		_config.xml().attribute_value("chunk", Number_of_bytes(4096));
+
+	Timer::Connection _timer { _env };
+
+	Terminal::Connection _terminal { _env };
+
+	/* text written repeatedly, a multiple of the chunk size */
+	size_t const _text_size = 16*_chunk;
+
+	Attached_ram_dataspace _text { _env.ram(), _env.rm(), _text_size };
+
+	Lcg_random _random { };
+
+	void _generate_text()
+	{
+		char * const text = _text.local_addr<char>();
+		size_t const size = _text_size;
+
+		/* lines of up to 160 characters, some of them wrapped by the terminal */
+		for (size_t pos = 0; pos < size; ) {
+
+			size_t const len = min(size - pos - 1, (size_t)(_random.next() >> 16) % 160);
+
+			for (size_t i = 0; i < len; i++)
+				text[pos + i] = 32 + (_random.next() >> 16) % 95;
+
+			text[pos + len] = '\n';
+			pos += len + 1;
+		}
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- terminal throughput test started ---");
+
+		_generate_text();
+
+		char const * const text = _text.local_addr<char>();
+
+		unsigned long const start_ms = _timer.elapsed_ms();
+
+		size_t offset = 0;
+		for (size_t pos = 0; pos < _size; ) {
+
+			size_t const n = min(_chunk, _size - pos);
+
+			for (size_t done = 0; done < n; )
+				done += _terminal.write(text + offset + done, n - done);
+
+			pos   += n;
+			offset = (offset + n) % _text_size;
+		}
+
+		unsigned long const ms  = _timer.elapsed_ms() - start_ms;
+		unsigned long const kib = _size/1024;
+
+		log("wrote ", kib, " KiB in ", ms, " ms, ",
+		    ms ? kib*1000/ms : 0, " KiB/s");
+
+		log("--- terminal throughput test finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
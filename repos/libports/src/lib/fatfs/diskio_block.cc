@@ -185,6 +185,23 @@ extern "C" DRESULT disk_write (BYTE pdrv, const BYTE* buff, DWORD sector, UINT c
 #endif /* _READONLY */
 
 
+/**
+ * Submit request without payload and wait for its completion
+ */
+static DRESULT request(Drive &drive, Block::Packet_descriptor::Opcode op,
+                       Block::sector_t sector, Genode::size_t count)
+{
+	Block::Packet_descriptor p(drive.tx()->alloc_packet(0), op, sector, count);
+	drive.tx()->submit_packet(p);
+	p = drive.tx()->get_acked_packet();
+
+	DRESULT const res = p.succeeded() ? RES_OK : RES_ERROR;
+
+	drive.tx()->release_packet(p);
+	return res;
+}
+
+
 extern "C" DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff)
 {
 	if (!_platform->drives[pdrv])
@@ -194,9 +211,27 @@ extern "C" DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff)
 
 	switch (cmd) {
 	case CTRL_SYNC:
+		if (drive.ops.supported(Block::Packet_descriptor::SYNC))
+			return request(drive, Block::Packet_descriptor::SYNC, 0, 0);
+
 		drive.sync();
 		return RES_OK;
 
+	case CTRL_TRIM:
+		{
+			/* start and end sector of the range, both inclusive */
+			DWORD const start = ((DWORD*)buff)[0];
+			DWORD const end   = ((DWORD*)buff)[1];
+
+			/* trimming is a hint, devices without support ignore it */
+			if (end < start
+			 || !drive.ops.supported(Block::Packet_descriptor::TRIM))
+				return RES_OK;
+
+			return request(drive, Block::Packet_descriptor::TRIM,
+			               start, end - start + 1);
+		}
+
 	case GET_SECTOR_COUNT:
 		*((DWORD*)buff) = drive.block_count;
 		return RES_OK;
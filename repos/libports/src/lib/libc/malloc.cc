@@ -1,8 +1,18 @@
 /*
- * \brief  Simplistic malloc and free implementation
+ * \brief  Thread-caching malloc and free implementation
  * \author Norman Feske
  * \author Sebastian Sumpf
  * \date   2006-07-21
+ *
+ * Small allocations are served from size classes that are spaced at most
+ * 25% apart. Each class has a central bin of superblocks protected by a
+ * lock of its own. In front of the bins, threads use caches that hold a
+ * few free objects per class. Because the libc has no thread-local
+ * storage, the caches are selected by the address of the calling thread
+ * object. Each cache is protected by a lock, which is uncontended as long
+ * as no two threads hash to the same cache. Superblocks that become empty
+ * are handed back to the backing store. Allocations larger than the
+ * biggest size class are directly forwarded to the backing store.
  */
 
 /*
@@ -15,7 +25,7 @@
 /* Genode includes */
 #include <base/env.h>
 #include <base/log.h>
-#include <base/slab.h>
+#include <base/thread.h>
 #include <util/construct_at.h>
 #include <util/string.h>
 #include <util/misc_math.h>
@@ -24,6 +34,7 @@
 extern "C" {
 #include <string.h>
 #include <stdlib.h>
+#include <errno.h>
 }
 
 /* libc-internal includes */
@@ -31,41 +42,8 @@ extern "C" {
 #include <base/internal/unmanaged_singleton.h>
 
 
-namespace Genode {
-
-	class Slab_alloc : public Slab
-	{
-		private:
-
-			size_t const _object_size;
-
-			size_t _calculate_block_size(size_t object_size)
-			{
-				size_t block_size = 16*object_size;
-				return align_addr(block_size, 12);
-			}
-
-		public:
-
-			Slab_alloc(size_t object_size, Allocator *backing_store)
-			:
-				Slab(object_size, _calculate_block_size(object_size), 0, backing_store),
-				_object_size(object_size)
-			{ }
-
-			void *alloc()
-			{
-				void *result;
-				return (Slab::alloc(_object_size, &result) ? result : 0);
-			}
-
-			void free(void *ptr) { Slab::free(ptr, _object_size); }
-	};
-}
-
-
 /**
- * Allocator that uses slabs for small objects sizes
+ * Allocator with per-thread caches in front of per-class bins
  */
 class Malloc
 {
@@ -73,71 +51,396 @@ class Malloc
 
 		typedef Genode::size_t size_t;
 		typedef Genode::addr_t addr_t;
+		typedef Genode::Lock   Lock;
 
 		enum {
-			SLAB_START = 5,  /* 32 bytes (log2) */
-			SLAB_STOP  = 11, /* 2048 bytes (log2) */
-			NUM_SLABS  = (SLAB_STOP - SLAB_START) + 1
+			ALIGN           = 16,
+			LINEAR_CLASSES  = 8,    /* 16-byte steps up to 128 bytes */
+			LINEAR_LIMIT    = LINEAR_CLASSES*ALIGN,
+			SUB_CLASSES     = 4,    /* classes per power of two above */
+			MAX_CLASS_LOG2  = 13,   /* largest class of 8 KiB */
+			NUM_CLASSES     = LINEAR_CLASSES
+			                + SUB_CLASSES*(MAX_CLASS_LOG2 - 7),
+			NUM_CACHES      = 16,
+
+			/*
+			 * Superblocks grow from the minimum to the maximum size with
+			 * each superblock added to a bin. Blocks of the maximum size
+			 * are backed by dedicated dataspaces of the heap. Hence,
+			 * freeing such an empty superblock releases its memory to
+			 * the RAM allocator of the component.
+			 */
+			MIN_SUPERBLOCK  = 4*1024,
+			MAX_SUPERBLOCK  = 64*1024,
+
+			/* upper bound of the memory held per class in a cache */
+			CACHE_BYTES     = 8*1024,
+			MAX_CACHED      = 32,
+			MIN_CACHED      = 2,
 		};
 
-		struct Metadata
+		struct Superblock;
+
+		/**
+		 * Metadata stored right before each pointer returned to the caller
+		 */
+		struct Header
 		{
+			Superblock *superblock; /* nullptr for large blocks */
+
 			unsigned long long value; /* bits 63..5 size and 4..0 offset */
 
 			/**
 			 * Allocation metadata
 			 *
-			 * \param size    allocation size
-			 * \param offset  offset of pointer from allocation
+			 * \param size    size of the block
+			 * \param offset  offset of pointer from block
 			 */
-			Metadata(size_t size, unsigned offset)
-			: value(((unsigned long long)size << 5) | (offset & 0x1f)) { }
+			Header(Superblock *superblock, size_t size, unsigned offset)
+			:
+				superblock(superblock),
+				value(((unsigned long long)size << 5) | (offset & 0x1f))
+			{ }
 
 			size_t   size()   const { return value >> 5; }
 			unsigned offset() const { return value & 0x1f; }
 		};
 
 		/**
-		 * Allocation overhead due to alignment and metadata storage
+		 * Room in front of small objects for the header
 		 *
-		 * We store the metadata of the allocation right before the pointer
-		 * returned to the caller and can then retrieve the information when
-		 * freeing the block. Therefore, we add room for metadata and 16-byte
-		 * alignment.
+		 * Objects of all size classes are 16-byte aligned. So the pointer
+		 * returned to the caller stays aligned if the header is padded.
+		 */
+		enum { HEADER_ROOM = ALIGN };
+
+		static_assert(sizeof(Header) <= HEADER_ROOM, "header exceeds room");
+
+		/**
+		 * Allocation overhead of large blocks due to alignment and header
 		 *
-		 * Note, the worst case is an allocation that starts at
-		 * 16 byte - sizeof(Metadata) + 1 because it misses one byte of space
-		 * for the metadata and therefore increases the worst-case allocation
-		 * by 15 bytes additionally to the metadata space.
+		 * The worst case is a block that starts at 16 byte - sizeof(Header)
+		 * + 1 because it misses one byte of space for the header and
+		 * therefore increases the allocation by 15 bytes in addition to the
+		 * header space.
+		 */
+		static constexpr size_t _room() { return sizeof(Header) + ALIGN - 1; }
+
+		/**
+		 * Free object, linked through its payload
+		 */
+		struct Free_object { Free_object *next; };
+
+		struct Superblock
+		{
+			Superblock  *prev = nullptr, *next = nullptr;
+			size_t const size;
+			size_t const object_size;
+			unsigned     used      = 0;
+			Free_object *free_list = nullptr;
+			addr_t       bump;     /* start of never-used area */
+			addr_t const end;
+			bool         partial   = false;
+
+			Superblock(size_t size, size_t object_size)
+			:
+				size(size), object_size(object_size),
+				bump(Genode::align_addr((addr_t)(this + 1), 4)),
+				end((addr_t)this + size)
+			{ }
+
+			bool empty() const { return used == 0; }
+
+			bool full() const {
+				return !free_list && bump + object_size > end; }
+
+			/**
+			 * Take object from superblock, return pointer for the caller
+			 */
+			void *take()
+			{
+				used++;
+
+				if (Free_object *o = free_list) {
+					free_list = o->next;
+					return o;
+				}
+
+				/* the header of an object is written once at its first use */
+				addr_t const block = bump;
+				bump += object_size;
+
+				*((Header *)(block + HEADER_ROOM) - 1) =
+					Header(this, object_size, HEADER_ROOM);
+
+				return (void *)(block + HEADER_ROOM);
+			}
+
+			void give(void *ptr)
+			{
+				Free_object * const o = (Free_object *)ptr;
+				o->next   = free_list;
+				free_list = o;
+				used--;
+			}
+		};
+
+		/**
+		 * Central bin of a size class
 		 */
-		static constexpr size_t _room() { return sizeof(Metadata) + 15; }
+		struct Bin
+		{
+			Lock        lock { };
+			Superblock *partial = nullptr; /* superblocks with free objects */
+			Superblock *spare   = nullptr; /* empty superblock kept for reuse */
+			size_t      object_size = 0;
+			size_t      superblock_size = 0;
 
-		Genode::Allocator  &_backing_store;        /* back-end allocator */
-		Genode::Slab_alloc *_allocator[NUM_SLABS]; /* slab allocators */
-		Genode::Lock        _lock;
+			void link(Superblock &sb)
+			{
+				sb.prev = nullptr;
+				sb.next = partial;
+				if (partial) partial->prev = &sb;
+				partial    = &sb;
+				sb.partial = true;
+			}
 
-		unsigned _slab_log2(size_t size) const
+			void unlink(Superblock &sb)
+			{
+				if (sb.prev) sb.prev->next = sb.next;
+				else         partial       = sb.next;
+				if (sb.next) sb.next->prev = sb.prev;
+				sb.prev = sb.next = nullptr;
+				sb.partial = false;
+			}
+		};
+
+		/**
+		 * Objects of one size class held by a cache
+		 */
+		struct Cached
 		{
-			unsigned msb = Genode::log2(size);
+			Free_object *head  = nullptr;
+			unsigned     count = 0;
 
-			/* size is greater than msb */
-			if (size > (1U << msb))
-				msb++;
+			void push(void *ptr)
+			{
+				Free_object * const o = (Free_object *)ptr;
+				o->next = head;
+				head    = o;
+				count++;
+			}
 
-			/* use smallest slab */
-			if (size < (1U << SLAB_START))
-				msb = SLAB_START;
+			void *pop()
+			{
+				Free_object * const o = head;
+				head = o->next;
+				count--;
+				return o;
+			}
+		};
+
+		struct Cache
+		{
+			Lock   lock { };
+			Cached classes[NUM_CLASSES];
+		};
 
-			return msb;
+		Genode::Allocator &_backing_store; /* back-end allocator */
+
+		Bin   _bins[NUM_CLASSES];
+		Cache _caches[NUM_CACHES];
+
+		unsigned _max_cached[NUM_CLASSES];
+
+		/**
+		 * Return index of smallest class that fits 'size' bytes
+		 */
+		static unsigned _class_index(size_t size)
+		{
+			if (size <= LINEAR_LIMIT)
+				return size ? (size + ALIGN - 1)/ALIGN - 1 : 0;
+
+			/* size lies within (2^msb, 2^(msb + 1)] */
+			unsigned const msb  = Genode::log2(size - 1);
+			size_t   const base = 1UL << msb;
+			size_t   const step = base/SUB_CLASSES;
+			unsigned const sub  = (size - base + step - 1)/step - 1;
+
+			return LINEAR_CLASSES + (msb - 7)*SUB_CLASSES + sub;
+		}
+
+		static size_t _class_size(unsigned index)
+		{
+			if (index < LINEAR_CLASSES)
+				return (index + 1)*ALIGN;
+
+			unsigned const k    = index - LINEAR_CLASSES;
+			size_t   const base = 1UL << (7 + k/SUB_CLASSES);
+
+			return base + (k % SUB_CLASSES + 1)*(base/SUB_CLASSES);
+		}
+
+		static Header *_header(void *ptr) { return (Header *)ptr - 1; }
+
+		/**
+		 * Return size of the small block needed for 'size' bytes
+		 */
+		static size_t _small_size(size_t size)
+		{
+			/* leave room for linking the object into a free list */
+			return Genode::max(size, sizeof(Free_object)) + HEADER_ROOM;
+		}
+
+		/**
+		 * Return size of the block needed for an allocation of 'size' bytes
+		 */
+		static size_t _block_size(size_t size)
+		{
+			size_t const small_size = _small_size(size);
+			return (small_size <= (1UL << MAX_CLASS_LOG2))
+			       ? _class_size(_class_index(small_size))
+			       : size + _room();
+		}
+
+		/**
+		 * Return cache of the calling thread
+		 */
+		Cache &_cache()
+		{
+			/*
+			 * Thread objects reside at the top of their stacks, which are
+			 * spaced 1 MiB apart within the stack area.
+			 */
+			addr_t const a = (addr_t)Genode::Thread::myself();
+			return _caches[((a >> 20) ^ (a >> 12)) % NUM_CACHES];
+		}
+
+		/**
+		 * Add new superblock to bin
+		 *
+		 * Must be called with the bin lock held.
+		 */
+		Superblock *_grow(Bin &bin)
+		{
+			if (Superblock *sb = bin.spare) {
+				bin.spare = nullptr;
+				bin.link(*sb);
+				return sb;
+			}
+
+			size_t size = bin.superblock_size;
+			if (!size) {
+				size = MIN_SUPERBLOCK;
+				while (size < 4*bin.object_size + sizeof(Superblock))
+					size *= 2;
+			}
+
+			void *addr = nullptr;
+			if (!_backing_store.alloc(size, &addr))
+				return nullptr;
+
+			bin.superblock_size = Genode::min(2*size, (size_t)MAX_SUPERBLOCK);
+
+			Superblock *sb = Genode::construct_at<Superblock>(addr, size,
+			                                                  bin.object_size);
+			bin.link(*sb);
+			return sb;
+		}
+
+		/**
+		 * Return object to its superblock
+		 *
+		 * Must be called with the bin lock held.
+		 */
+		void _release(Bin &bin, void *ptr)
+		{
+			Superblock &sb = *_header(ptr)->superblock;
+
+			sb.give(ptr);
+
+			if (!sb.partial)
+				bin.link(sb);
+
+			if (!sb.empty())
+				return;
+
+			bin.unlink(sb);
+
+			/* keep one empty superblock to absorb alloc/free oscillation */
+			if (!bin.spare) {
+				bin.spare = &sb;
+				return;
+			}
+
+			_backing_store.free(&sb, sb.size);
+		}
+
+		/**
+		 * Fill cache with a batch of objects from the central bin
+		 */
+		void _refill(unsigned index, Cached &cached)
+		{
+			Bin &bin = _bins[index];
+			Lock::Guard guard(bin.lock);
+
+			unsigned const batch = Genode::max(1U, _max_cached[index]/2);
+
+			for (unsigned i = 0; i < batch; i++) {
+
+				Superblock *sb = bin.partial ? bin.partial : _grow(bin);
+				if (!sb)
+					return;
+
+				cached.push(sb->take());
+
+				if (sb->full())
+					bin.unlink(*sb);
+			}
+		}
+
+		/**
+		 * Return half of the cached objects to the central bin
+		 */
+		void _flush(unsigned index, Cached &cached)
+		{
+			Bin &bin = _bins[index];
+			Lock::Guard guard(bin.lock);
+
+			for (unsigned n = cached.count/2; n; n--)
+				_release(bin, cached.pop());
+		}
+
+		void *_alloc_large(size_t size)
+		{
+			size_t const real_size = size + _room();
+
+			void *alloc_addr = nullptr;
+			if (real_size < size || !_backing_store.alloc(real_size, &alloc_addr))
+				return nullptr;
+
+			/* correctly align the allocation address */
+			addr_t const aligned_addr =
+				((addr_t)alloc_addr + _room()) & ~(addr_t)(ALIGN - 1);
+
+			unsigned const offset = aligned_addr - (addr_t)alloc_addr;
+
+			*_header((void *)aligned_addr) = Header(nullptr, real_size, offset);
+
+			return (void *)aligned_addr;
 		}
 
 	public:
 
 		Malloc(Genode::Allocator &backing_store) : _backing_store(backing_store)
 		{
-			for (unsigned i = SLAB_START; i <= SLAB_STOP; i++) {
-				_allocator[i - SLAB_START] =
-					new (backing_store) Genode::Slab_alloc(1U << i, &backing_store);
+			for (unsigned i = 0; i < NUM_CLASSES; i++) {
+				size_t const size = _class_size(i);
+
+				_bins[i].object_size = size;
+				_max_cached[i] = Genode::max((unsigned)MIN_CACHED,
+				                             Genode::min((unsigned)MAX_CACHED,
+				                                         (unsigned)(CACHE_BYTES/size)));
 			}
 		}
 
@@ -149,71 +452,80 @@ class Malloc
 
 		void * alloc(size_t size)
 		{
-			Genode::Lock::Guard lock_guard(_lock);
+			size_t const small_size = _small_size(size);
 
-			size_t   const real_size = size + _room();
-			unsigned const msb       = _slab_log2(real_size);
+			if (small_size < size || small_size > (1UL << MAX_CLASS_LOG2))
+				return _alloc_large(size);
 
-			void *alloc_addr = nullptr;
+			unsigned const index = _class_index(small_size);
 
-			/* use backing store if requested memory is larger than largest slab */
-			if (msb > SLAB_STOP)
-				_backing_store.alloc(real_size, &alloc_addr);
-			else
-				alloc_addr = _allocator[msb - SLAB_START]->alloc();
+			Cache &cache = _cache();
+			Lock::Guard guard(cache.lock);
 
-			if (!alloc_addr) return nullptr;
+			Cached &cached = cache.classes[index];
+			if (!cached.count)
+				_refill(index, cached);
 
-			/* correctly align the allocation address */
-			Metadata * const aligned_addr =
-				(Metadata *)(((addr_t)alloc_addr + _room()) & ~15UL);
-
-			unsigned const offset = (addr_t)aligned_addr - (addr_t)alloc_addr;
-
-			*(aligned_addr - 1) = Metadata(real_size, offset);
+			return cached.count ? cached.pop() : nullptr;
+		}
 
-			return aligned_addr;
+		/**
+		 * Return number of bytes usable at 'ptr'
+		 */
+		size_t usable_size(void *ptr) const
+		{
+			Header const &header = *_header(ptr);
+			return header.size() - header.offset();
 		}
 
 		void *realloc(void *ptr, size_t size)
 		{
-			size_t const real_size     = size + _room();
-			size_t const old_real_size = ((Metadata *)ptr - 1)->size();
+			size_t const old_size       = usable_size(ptr);
+			size_t const old_block_size = _header(ptr)->size();
 
-			/* do not reallocate if new size is less than the current size */
-			if (real_size <= old_real_size)
+			/*
+			 * Keep the block if the new size fits unless a smaller block
+			 * would save at least half of the memory.
+			 */
+			if (size <= old_size && 2*_block_size(size) > old_block_size)
 				return ptr;
 
 			/* allocate new block */
 			void *new_addr = alloc(size);
 
-			if (new_addr) {
-				/* copy content from old block into new block */
-				memcpy(new_addr, ptr, old_real_size - _room());
+			/* a shrinking block can stay in place if no memory is left */
+			if (!new_addr)
+				return size <= old_size ? ptr : nullptr;
 
-				/* free old block */
-				free(ptr);
-			}
+			/* copy content from old block into new block */
+			memcpy(new_addr, ptr, Genode::min(old_size, size));
+
+			/* free old block */
+			free(ptr);
 
 			return new_addr;
 		}
 
 		void free(void *ptr)
 		{
-			Genode::Lock::Guard lock_guard(_lock);
+			Header const &header = *_header(ptr);
+
+			if (!header.superblock) {
+				void *alloc_addr = (void *)((addr_t)ptr - header.offset());
+				_backing_store.free(alloc_addr, header.size());
+				return;
+			}
 
-			Metadata *md = (Metadata *)ptr - 1;
+			unsigned const index = _class_index(header.size());
 
-			size_t   const  real_size  = md->size();
-			unsigned const  msb        = _slab_log2(real_size);
+			Cache &cache = _cache();
+			Lock::Guard guard(cache.lock);
 
-			void *alloc_addr = (void *)((addr_t)ptr - md->offset());
+			Cached &cached = cache.classes[index];
+			cached.push(ptr);
 
-			if (msb > SLAB_STOP) {
-				_backing_store.free(alloc_addr, real_size);
-			} else {
-				_allocator[msb - SLAB_START]->free(alloc_addr);
-			}
+			if (cached.count > _max_cached[index])
+				_flush(index, cached);
 		}
 };
 
@@ -229,6 +541,11 @@ extern "C" void *malloc(size_t size)
 
 extern "C" void *calloc(size_t nmemb, size_t size)
 {
+	if (size && nmemb > ~(size_t)0/size) {
+		errno = ENOMEM;
+		return nullptr;
+	}
+
 	void *addr = malloc(nmemb*size);
 	if (addr)
 		Genode::memset(addr, 0, nmemb*size);
@@ -0,0 +1,88 @@
+/*
+ * \brief  Benchmark of loading and relocating large shared objects
+ * \author agent
+ * \date   2026-10-17
+ *
+ * Each library listed in the config is repeatedly loaded along with its
+ * dependencies and unloaded again, once with lazy binding and once with
+ * all jump slots resolved immediately. The duration is dominated by the
+ * symbol resolution of the dynamic linker.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/shared_object.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+
+	typedef String<64> Name;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	unsigned const _iterations =
+		_config.xml().attribute_value("iterations", 10U);
+
+	void _measure(Name const &name, Shared_object::Bind bind)
+	{
+		unsigned long const start_ms = _timer.elapsed_ms();
+
+		for (unsigned i = 0; i < _iterations; i++) {
+			try {
+				Shared_object obj(_env, _heap, name.string(), bind,
+				                  Shared_object::DONT_KEEP);
+			}
+			catch (...) {
+				error("failed to load ", name);
+				return;
+			}
+		}
+
+		unsigned long const duration_ms = _timer.elapsed_ms() - start_ms;
+
+		log(name, " (", bind == Shared_object::BIND_NOW ? "bind now" : "lazy", "): ",
+		    duration_ms*1000/_iterations, " us per load");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- ldso benchmark started ---");
+
+		_config.xml().for_each_sub_node("library", [&] (Xml_node library) {
+
+			Name const name = library.attribute_value("name", Name());
+
+			_measure(name, Shared_object::BIND_LAZY);
+			_measure(name, Shared_object::BIND_NOW);
+		});
+
+		log("--- ldso benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
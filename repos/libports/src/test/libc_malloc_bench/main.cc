@@ -0,0 +1,153 @@
+/*
+ * \brief  Libc malloc benchmark
+ * \author agent
+ * \date   2026-10-17
+ *
+ * Each thread performs a fixed number of allocations and deallocations of
+ * mixed sizes on a private working set. The benchmark is executed with
+ * 1 to 16 threads. With an allocator that scales, the number of operations
+ * per second grows with the number of threads up to the number of CPUs
+ * and stays constant beyond.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+enum {
+	MAX_THREADS  = 16,
+	WORKING_SET  = 256,     /* live objects per thread */
+	OPERATIONS   = 200000,  /* allocations per thread */
+};
+
+
+struct Thread_args
+{
+	unsigned seed;
+	unsigned long checksum;
+};
+
+
+static unsigned xorshift(unsigned &state)
+{
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+
+/**
+ * Return allocation size following a mix typical for ported software
+ *
+ * Most allocations are small, some are medium sized, and a few are large.
+ */
+static size_t random_size(unsigned &state)
+{
+	unsigned const r = xorshift(state) % 100;
+
+	if (r < 80) return 1 + xorshift(state) % 256;
+	if (r < 98) return 257 + xorshift(state) % 4096;
+	return 4353 + xorshift(state) % (64*1024);
+}
+
+
+static void *thread_func(void *arg)
+{
+	Thread_args &args = *(Thread_args *)arg;
+
+	void    *objects[WORKING_SET];
+	unsigned state = args.seed;
+
+	memset(objects, 0, sizeof(objects));
+
+	for (unsigned i = 0; i < OPERATIONS; i++) {
+
+		unsigned const slot = xorshift(state) % WORKING_SET;
+
+		free(objects[slot]);
+
+		size_t const size = random_size(state);
+
+		char * const ptr = (char *)malloc(size);
+		if (!ptr) {
+			printf("error: malloc of %zu bytes failed\n", size);
+			exit(-1);
+		}
+
+		/* touch first and last byte to resemble the use of the object */
+		ptr[0] = ptr[size - 1] = (char)i;
+		args.checksum += ptr[0];
+
+		objects[slot] = ptr;
+
+		/* let some objects change their size */
+		if (i % 16 == 0) {
+			unsigned const other = xorshift(state) % WORKING_SET;
+			if (objects[other])
+				objects[other] = realloc(objects[other], random_size(state));
+		}
+	}
+
+	for (unsigned i = 0; i < WORKING_SET; i++)
+		free(objects[i]);
+
+	return nullptr;
+}
+
+
+static unsigned long now_ms()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec*1000UL + ts.tv_nsec/1000000;
+}
+
+
+static void run(unsigned num_threads)
+{
+	pthread_t   threads[MAX_THREADS];
+	Thread_args args[MAX_THREADS];
+
+	unsigned long const start = now_ms();
+
+	for (unsigned i = 0; i < num_threads; i++) {
+		args[i] = Thread_args { 0x9e3779b9U*(i + 1), 0 };
+		if (pthread_create(&threads[i], 0, thread_func, &args[i]) != 0) {
+			printf("error: pthread_create() failed\n");
+			exit(-1);
+		}
+	}
+
+	for (unsigned i = 0; i < num_threads; i++)
+		pthread_join(threads[i], 0);
+
+	unsigned long const duration = now_ms() - start;
+	unsigned long const ops      = (unsigned long)num_threads*OPERATIONS;
+
+	printf("threads=%2u operations=%lu duration=%lu ms ops/s=%lu\n",
+	       num_threads, ops, duration,
+	       duration ? ops*1000/duration : 0);
+}
+
+
+int main(int, char **)
+{
+	printf("--- libc malloc benchmark ---\n");
+
+	for (unsigned n = 1; n <= MAX_THREADS; n *= 2)
+		run(n);
+
+	printf("--- libc malloc benchmark finished ---\n");
+	return 0;
+}
@@ -76,6 +76,7 @@ class Block::Session_component : public Block::Session_component_base,
 		bool                              _ack_queue_full;
 		Packet_descriptor                 _p_to_handle;
 		unsigned                          _p_in_fly;
+		unsigned                          _p_pending;   /* passed to driver */
 		bool                              _writeable;
 
 		/**
@@ -88,6 +89,7 @@ class Block::Session_component : public Block::Session_component_base,
 
 			tx_sink()->acknowledge_packet(packet);
 			_p_in_fly--;
+			_p_pending--;
 		}
 
 		/**
@@ -97,6 +99,17 @@ class Block::Session_component : public Block::Session_component_base,
 			return p.block_number() + p.block_count() - 1
 			       < _driver.block_count(); }
 
+		/**
+		 * Check validity of packet request
+		 */
+		inline bool _valid(Packet_descriptor &p)
+		{
+			if (p.operation() == Block::Packet_descriptor::SYNC)
+				return true;
+
+			return (!p.payload() || p.size()) && _range_check(p);
+		}
+
 		/**
 		 * Handle a single request
 		 */
@@ -105,8 +118,21 @@ class Block::Session_component : public Block::Session_component_base,
 			_p_to_handle = packet;
 			_p_to_handle.succeeded(false);
 
+			/*
+			 * A SYNC request is a barrier, defer it until all preceding
+			 * requests are acknowledged. Like a congested request, it is
+			 * handled again whenever the driver acknowledges a packet.
+			 */
+			if (packet.operation() == Block::Packet_descriptor::SYNC
+			 && _p_pending) {
+				_req_queue_full = true;
+				return;
+			}
+
+			_p_pending++;
+
 			/* ignore invalid packets */
-			if (!packet.size() || !_range_check(_p_to_handle)) {
+			if (!_valid(_p_to_handle)) {
 				_ack_packet(_p_to_handle);
 				return;
 			}
@@ -144,10 +170,24 @@ class Block::Session_component : public Block::Session_component_base,
 						              _p_to_handle);
 					break;
 
+				case Block::Packet_descriptor::SYNC:
+					_driver.sync(_p_to_handle);
+					break;
+
+				case Block::Packet_descriptor::TRIM:
+					if (!_writeable) {
+						_ack_packet(_p_to_handle);
+						break;
+					}
+					_driver.trim(packet.block_number(), packet.block_count(),
+					             _p_to_handle);
+					break;
+
 				default:
 					throw Driver::Io_error();
 				}
 			} catch (Driver::Request_congestion) {
+				_p_pending--;
 				_req_queue_full = true;
 			} catch (Driver::Io_error) {
 				_ack_packet(_p_to_handle);
@@ -192,6 +232,7 @@ class Block::Session_component : public Block::Session_component_base,
 		  _sink_submit(ep, *this, &Session_component::_signal),
 		  _req_queue_full(false),
 		  _p_in_fly(0),
+		  _p_pending(0),
 		  _writeable(writeable)
 		{
 			_tx.sigh_ready_to_ack(_sink_ack);
@@ -212,6 +253,12 @@ class Block::Session_component : public Block::Session_component_base,
 		 */
 		void ack_packet(Packet_descriptor &packet, bool success)
 		{
+			/* write through to stable storage before reporting completion */
+			if (success && packet.fua()
+			 && packet.operation() == Block::Packet_descriptor::WRITE
+			 && !_driver.fua_supported())
+				_driver.sync();
+
 			packet.succeeded(success);
 			_ack_packet(packet);
 
@@ -251,6 +298,11 @@ class Block::Session_component : public Block::Session_component_base,
 				ops->set_operation(Opcode::READ);
 			if (_writeable && driver_ops.supported(Opcode::WRITE))
 				ops->set_operation(Opcode::WRITE);
+			if (_writeable && driver_ops.supported(Opcode::TRIM))
+				ops->set_operation(Opcode::TRIM);
+
+			/* drivers without support are synchronized via 'sync' */
+			ops->set_operation(Opcode::SYNC);
 
 		}
 
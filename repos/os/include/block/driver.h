@@ -193,6 +193,23 @@ class Block::Driver
 		                       Packet_descriptor &packet) {
 			throw Io_error(); }
 
+		/**
+		 * Mark blocks as unused
+		 *
+		 * \param block_number  number of first block to trim
+		 * \param block_count   number of blocks to trim
+		 * \param packet        packet descriptor from the client
+		 *
+		 * \throw Request_congestion
+		 *
+		 * Note: should be overridden by devices that report the TRIM
+		 *       operation as supported
+		 */
+		virtual void trim(sector_t           block_number,
+		                  Genode::size_t     block_count,
+		                  Packet_descriptor &packet) {
+			throw Io_error(); }
+
 		/**
 		 * Check if DMA is enabled for driver
 		 *
@@ -202,6 +219,19 @@ class Block::Driver
 		 */
 		virtual bool dma_enabled() { return false; }
 
+		/**
+		 * Check if driver completes FUA writes on its own
+		 *
+		 * \return  true if the driver acknowledges a write marked as 'fua'
+		 *          not before its data reached stable storage, false if
+		 *          the session component has to call 'sync' before
+		 *          acknowledging the write
+		 *
+		 * Note: should be overridden by components that cache data and
+		 *       handle FUA writes asynchronously
+		 */
+		virtual bool fua_supported() { return false; }
+
 		/**
 		 * Allocate buffer which is suitable for DMA.
 		 *
@@ -227,6 +257,26 @@ class Block::Driver
 		 */
 		virtual void sync() {}
 
+		/**
+		 * Synchronize with device in response to a SYNC request
+		 *
+		 * The request is passed to the driver not before all requests
+		 * submitted earlier are acknowledged. The default implementation
+		 * synchronizes via 'sync' and acknowledges the request right away.
+		 *
+		 * \param packet  packet descriptor from the client
+		 *
+		 * \throw Request_congestion
+		 *
+		 * Note: should be overridden by components that synchronize
+		 *       asynchronously, e.g., by forwarding the request
+		 */
+		virtual void sync(Packet_descriptor &packet)
+		{
+			sync();
+			ack_packet(packet);
+		}
+
 		/**
 		 * Informs the driver that the client session was closed
 		 *
@@ -36,12 +36,27 @@ namespace Block {
  * The data associated with the 'Packet_descriptor' is either
  * the data read from or written to the block indicated by
  * its number.
+ *
+ * Besides transferring data, a request may be one of the following
+ * operations, which carry no payload:
+ *
+ * SYNC  The request is acknowledged once all requests submitted before have
+ *       been completed and their data reached stable storage. Requests
+ *       submitted after the SYNC are not processed before, which makes the
+ *       request a write barrier. Block number and count are ignored.
+ *
+ * TRIM  The client no longer uses the specified blocks. The content of the
+ *       blocks is undefined afterwards. Devices may use the hint to release
+ *       resources.
+ *
+ * A WRITE request may be marked as 'fua' (force unit access). Such a request
+ * is acknowledged not before its data reached stable storage.
  */
 class Block::Packet_descriptor : public Genode::Packet_descriptor
 {
 	public:
 
-		enum Opcode    { READ, WRITE, END };
+		enum Opcode    { READ, WRITE, SYNC, TRIM, END };
 		enum Alignment { PACKET_ALIGNMENT = 11 };
 
 	private:
@@ -50,6 +65,7 @@ class Block::Packet_descriptor : public Genode::Packet_descriptor
 		sector_t        _block_number; /* requested block number */
 		Genode::size_t  _block_count;  /* number of blocks to transfer */
 		unsigned        _success :1;   /* indicates success of operation */
+		unsigned        _fua     :1;   /* write through to stable storage */
 
 	public:
 
@@ -59,7 +75,8 @@ class Block::Packet_descriptor : public Genode::Packet_descriptor
 		Packet_descriptor(Genode::off_t offset=0, Genode::size_t size = 0)
 		:
 			Genode::Packet_descriptor(offset, size),
-			_op(READ), _block_number(0), _block_count(0), _success(false)
+			_op(READ), _block_number(0), _block_count(0), _success(false),
+			_fua(false)
 		{ }
 
 		/**
@@ -70,15 +87,22 @@ class Block::Packet_descriptor : public Genode::Packet_descriptor
 		:
 			Genode::Packet_descriptor(p.offset(), p.size()),
 			_op(op), _block_number(blk_nr),
-			_block_count(blk_count), _success(false)
+			_block_count(blk_count), _success(false), _fua(false)
 		{ }
 
 		Opcode         operation()    const { return _op;           }
 		sector_t       block_number() const { return _block_number; }
 		Genode::size_t block_count()  const { return _block_count;  }
 		bool           succeeded()    const { return _success;      }
+		bool           fua()          const { return _fua;          }
 
 		void succeeded(bool b) { _success = b ? 1 : 0; }
+		void fua(bool b)       { _fua     = b ? 1 : 0; }
+
+		/**
+		 * Return true if the operation transfers data via the bulk buffer
+		 */
+		bool payload() const { return _op == READ || _op == WRITE; }
 };
 
 
@@ -149,6 +173,10 @@ struct Block::Session : public Genode::Session
 
 	/**
 	 * Synchronize with block device, like ensuring data to be written
+	 *
+	 * In contrast to submitting a 'SYNC' request, the call blocks until
+	 * the device is synchronized and does not order the requests of the
+	 * packet stream.
 	 */
 	virtual void sync() = 0;
 
@@ -254,7 +254,17 @@ struct File_system::Directory_entry
 
 struct File_system::Session : public Genode::Session
 {
-	enum { TX_QUEUE_SIZE = 16 };
+	/*
+	 * Maximum number of requests in flight
+	 *
+	 * A server may process the packets of different nodes concurrently and
+	 * acknowledge them in a different order than submitted. The packets
+	 * referring to the same node are acknowledged in submission order. A
+	 * client associates an acknowledgement with its request by the offset
+	 * of the packet within the bulk buffer, which is unique among all
+	 * packets in flight that carry payload.
+	 */
+	enum { TX_QUEUE_SIZE = 64 };
 
 	typedef Genode::Packet_stream_policy<File_system::Packet_descriptor,
 	                                     TX_QUEUE_SIZE, TX_QUEUE_SIZE,
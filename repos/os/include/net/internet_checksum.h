@@ -0,0 +1,107 @@
+/*
+ * \brief  Computation of the Internet checksum (RFC 1071)
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INTERNET_CHECKSUM_H_
+#define _INTERNET_CHECKSUM_H_
+
+/* Genode */
+#include <base/stdint.h>
+#include <net/ipv4.h>
+
+namespace Net
+{
+	class Internet_checksum_diff;
+
+	/**
+	 * Return the checksum of 'size' bytes at 'data' in host byte order
+	 *
+	 * \param sum  partial one's complement sum of further data covered by
+	 *             the checksum in host byte order, e.g., of a pseudo header
+	 *
+	 * The data is summed up in machine words, which is independent from
+	 * the byte order of the machine (RFC 1071, section 2.B).
+	 */
+	Genode::uint16_t internet_checksum(void const       *data,
+	                                   Genode::size_t    size,
+	                                   Genode::uint32_t  sum = 0);
+
+	/**
+	 * Return partial one's complement sum of an IPv4 pseudo header
+	 *
+	 *  --------------------------------------------------------------
+	 * | src-ipaddr | dst-ipaddr | zero-field | prot.-id |   length   |
+	 * |  4 bytes   |  4 bytes   |   1 byte   |  1 byte  |  2 bytes   |
+	 *  --------------------------------------------------------------
+	 */
+	Genode::uint32_t internet_checksum_pseudo_ip(Ipv4_address const &src,
+	                                             Ipv4_address const &dst,
+	                                             Genode::uint8_t     protocol,
+	                                             Genode::size_t      length);
+}
+
+
+/**
+ * Accumulated modifications of data covered by an Internet checksum
+ *
+ * The checksum can be adapted to modified header fields without summing up
+ * the whole packet again (RFC 1624, equation 3).
+ */
+class Net::Internet_checksum_diff
+{
+	private:
+
+		Genode::uint32_t _value { 0 };
+
+		void _add_up(Genode::uint16_t old_word, Genode::uint16_t new_word) {
+			_value += (Genode::uint16_t)~old_word + new_word; }
+
+	public:
+
+		/**
+		 * Account for a modified 16-bit field given in host byte order
+		 */
+		void add_up_diff(Genode::uint16_t old_value, Genode::uint16_t new_value)
+		{
+			if (old_value != new_value)
+				_add_up(old_value, new_value);
+		}
+
+		/**
+		 * Account for a modified IPv4 address
+		 */
+		void add_up_diff(Ipv4_address const &old_addr, Ipv4_address const &new_addr)
+		{
+			if (old_addr == new_addr)
+				return;
+
+			for (unsigned i = 0; i < Ipv4_packet::ADDR_LEN; i += 2)
+				_add_up(old_addr.addr[i] << 8 | old_addr.addr[i + 1],
+				        new_addr.addr[i] << 8 | new_addr.addr[i + 1]);
+		}
+
+		/**
+		 * Return checksum adapted to the accumulated modifications
+		 *
+		 * \param checksum  original checksum in host byte order
+		 */
+		Genode::uint16_t apply_to(Genode::uint16_t checksum) const
+		{
+			Genode::uint32_t sum = (Genode::uint16_t)~checksum + _value;
+			while (sum >> 16)
+				sum = (sum & 0xffff) + (sum >> 16);
+
+			return (Genode::uint16_t)~sum;
+		}
+};
+
+#endif /* _INTERNET_CHECKSUM_H_ */
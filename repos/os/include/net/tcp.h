@@ -22,6 +22,7 @@
 #include <net/ipv4.h>
 #include <util/register.h>
 #include <net/port.h>
+#include <net/internet_checksum.h>
 
 namespace Net
 {
@@ -122,34 +123,21 @@ class Net::Tcp_packet
 			/* have to reset the checksum field for calculation */
 			_checksum = 0;
 
-			/* sum up pseudo header */
-			uint32_t sum = 0;
-			for (size_t i = 0; i < Ipv4_packet::ADDR_LEN; i += sizeof(uint16_t)) {
-				uint16_t s = ip_src.addr[i] << 8 | ip_src.addr[i + 1];
-				uint16_t d = ip_dst.addr[i] << 8 | ip_dst.addr[i + 1];
-				sum += s + d;
-			}
-			uint8_t prot[] = { 0, (uint8_t)Ipv4_packet::Protocol::TCP };
-			sum += host_to_big_endian(*(uint16_t *)&prot) + tcp_size;
-
-			/* sum up TCP packet itself */
-			size_t max = (tcp_size & 1) ? (tcp_size - 1) : tcp_size;
-			uint16_t * tcp = (uint16_t *)this;
-			for (size_t i = 0; i < max; i = i + sizeof(*tcp)) {
-				sum += host_to_big_endian(*tcp++); }
-
-			/* if TCP size is odd, append a zero byte */
-			if (tcp_size & 1) {
-				uint8_t last[] = { *((uint8_t *)this + (tcp_size - 1)), 0 };
-				sum += host_to_big_endian(*(uint16_t *)&last);
-			}
-			/* keep the last 16 bits of the 32 bit sum and add the carries */
-			while (sum >> 16) { sum = (sum & 0xffff) + (sum >> 16); }
-
-			/* one's complement of sum */
-			_checksum = host_to_big_endian((uint16_t)~sum);
+			uint32_t const pseudo_sum =
+				internet_checksum_pseudo_ip(ip_src, ip_dst,
+				                            (uint8_t)Ipv4_packet::Protocol::TCP,
+				                            tcp_size);
+
+			_checksum = host_to_big_endian(internet_checksum(this, tcp_size,
+			                                                 pseudo_sum));
 		}
 
+		/**
+		 * Adapt checksum to modified header fields or pseudo-header addresses
+		 */
+		void update_checksum(Internet_checksum_diff const &diff) {
+			_checksum = host_to_big_endian(diff.apply_to(checksum())); }
+
 		/**
 		 * Placement new
 		 */
@@ -15,6 +15,7 @@
 #define _INCLUDE__NITPICKER_GFX__BOX_PAINTER_H_
 
 #include <os/surface.h>
+#include <os/pixel_row.h>
 
 
 struct Box_painter
@@ -36,20 +37,22 @@ struct Box_painter
 
 		if (!clipped.valid()) return;
 
+		typedef Genode::Pixel_row<PT> Row;
+
 		PT pix(color.r, color.g, color.b);
-		PT *dst, *dst_line = surface.addr() + surface.size().w()*clipped.y1() + clipped.x1();
+		PT *dst_line = surface.addr() + surface.size().w()*clipped.y1() + clipped.x1();
+
+		unsigned const w = clipped.w();
 
 		int const alpha = color.a;
 
 		if (color.opaque())
-			for (int w, h = clipped.h() ; h--; dst_line += surface.size().w())
-				for (dst = dst_line, w = clipped.w(); w--; dst++)
-					*dst = pix;
+			for (int h = clipped.h() ; h--; dst_line += surface.size().w())
+				Row::fill(dst_line, pix, w);
 
 		else if (!color.transparent())
-			for (int w, h = clipped.h() ; h--; dst_line += surface.size().w())
-				for (dst = dst_line, w = clipped.w(); w--; dst++)
-					*dst = PT::mix(*dst, pix, alpha);
+			for (int h = clipped.h() ; h--; dst_line += surface.size().w())
+				Row::mix(dst_line, pix, alpha, w);
 
 		surface.flush_pixels(clipped);
 	}
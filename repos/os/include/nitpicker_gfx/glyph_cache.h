@@ -0,0 +1,343 @@
+/*
+ * \brief  Cache of glyphs prepared for drawing
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The 'Text_painter' inspects each alpha value of a glyph within the font
+ * image whenever it draws the glyph. The glyph cache keeps each glyph drawn
+ * with a given font and alpha value of the text color as a sequence of
+ * horizontal spans of visible pixels. Spans of opaque pixels are drawn by
+ * filling a row of pixels, the alpha values of the other spans are already
+ * combined with the alpha value of the color. Invisible pixels are skipped
+ * without being looked at. Because the spans are independent from the pixel
+ * format and the RGB values of the color, one cached glyph serves all
+ * surfaces and colors.
+ *
+ * Glyphs are drawn at whole-pixel positions only. TFF fonts are bitmap
+ * fonts with integer glyph widths, and text is positioned at integer
+ * coordinates. Hence, there is no subpixel offset that would call for
+ * separately cached variants of a glyph.
+ *
+ * The cache refers to fonts by their address. Hence, it must be flushed
+ * whenever a font is destructed.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__NITPICKER_GFX__GLYPH_CACHE_H_
+#define _INCLUDE__NITPICKER_GFX__GLYPH_CACHE_H_
+
+#include <base/allocator.h>
+#include <util/noncopyable.h>
+#include <util/color.h>
+#include <os/pixel_row.h>
+#include <nitpicker_gfx/text_painter.h>
+
+
+class Glyph_cache : Genode::Noncopyable
+{
+	public:
+
+		typedef Text_painter::Font  Font;
+		typedef Text_painter::Point Point;
+		typedef Text_painter::Area  Area;
+		typedef Text_painter::Rect  Rect;
+
+	private:
+
+		typedef Genode::size_t   size_t;
+		typedef Genode::uint8_t  uint8_t;
+		typedef Genode::uint16_t uint16_t;
+
+		enum {
+			NUM_BUCKETS = 512,
+
+			/* number of glyphs of a string looked up at once */
+			BATCH = 64,
+		};
+
+		/**
+		 * Horizontal span of visible pixels within one row of a glyph
+		 */
+		struct Span
+		{
+			enum : unsigned { OPAQUE = ~0U };
+
+			uint16_t x, len;
+			unsigned alpha;   /* offset of alpha values, or 'OPAQUE' */
+		};
+
+		struct Glyph
+		{
+			Glyph         *next;      /* next glyph of the same hash bucket */
+			size_t         size;      /* size of the allocation */
+			Font    const *font;
+			unsigned char  c;
+			uint8_t        alpha;     /* alpha value of the text color */
+			unsigned       h;
+			unsigned      *rows;      /* first span of each row, h + 1 entries */
+			Span          *spans;
+			uint8_t       *alphas;
+		};
+
+		Genode::Allocator &_alloc;
+
+		size_t const _max_bytes;
+		size_t       _bytes = 0;
+
+		Glyph *_buckets[NUM_BUCKETS] { };
+
+		static unsigned _bucket(Font const &font, unsigned char c, uint8_t alpha)
+		{
+			return ((Genode::addr_t)&font/sizeof(long) + c*31 + alpha*7)
+			       % NUM_BUCKETS;
+		}
+
+		/**
+		 * Call 'fn' for each span of a glyph row
+		 *
+		 * \param fn  functor called with the start, length, and whether the
+		 *            span is opaque
+		 */
+		template <typename FN>
+		static void _for_each_span(unsigned char const *src, int w,
+		                           uint8_t alpha, FN const &fn)
+		{
+			for (int x = 0; x < w; ) {
+
+				if (!src[x]) { x++; continue; }
+
+				bool const opaque = (src[x] == 255 && alpha == 255);
+
+				int len = 1;
+				for (; x + len < w && src[x + len]
+				     && (src[x + len] == 255 && alpha == 255) == opaque; len++);
+
+				fn(x, len, opaque);
+				x += len;
+			}
+		}
+
+		Glyph &_create(Font const &font, unsigned char c, uint8_t alpha)
+		{
+			int const w = font.wtab[c], h = font.img_h;
+
+			unsigned char const * const img = font.img + font.otab[c];
+
+			/* count spans and alpha values */
+			unsigned num_spans = 0, num_alphas = 0;
+			for (int y = 0; y < h; y++)
+				_for_each_span(img + y*font.img_w, w, alpha,
+				               [&] (int, int len, bool opaque) {
+					num_spans++;
+					if (!opaque) num_alphas += len;
+				});
+
+			size_t const size = sizeof(Glyph)
+			                  + (h + 1)*sizeof(unsigned)
+			                  + num_spans*sizeof(Span)
+			                  + num_alphas;
+
+			Glyph &glyph = *(Glyph *)_alloc.alloc(size);
+
+			glyph.size   = size;
+			glyph.font   = &font;
+			glyph.c      = c;
+			glyph.alpha  = alpha;
+			glyph.h      = h;
+			glyph.rows   = (unsigned *)(&glyph + 1);
+			glyph.spans  = (Span *)(glyph.rows + h + 1);
+			glyph.alphas = (uint8_t *)(glyph.spans + num_spans);
+
+			/* populate spans */
+			unsigned span = 0, offset = 0;
+			for (int y = 0; y < h; y++) {
+
+				glyph.rows[y] = span;
+
+				unsigned char const *src = img + y*font.img_w;
+				_for_each_span(src, w, alpha, [&] (int x, int len, bool opaque) {
+
+					glyph.spans[span++] = Span { (uint16_t)x, (uint16_t)len,
+					                             opaque ? Span::OPAQUE : offset };
+					if (opaque)
+						return;
+
+					for (int i = 0; i < len; i++)
+						glyph.alphas[offset++] = (alpha*src[x + i]) >> 8;
+				});
+			}
+			glyph.rows[h] = span;
+
+			unsigned const bucket = _bucket(font, c, alpha);
+			glyph.next = _buckets[bucket];
+			_buckets[bucket] = &glyph;
+
+			_bytes += size;
+			return glyph;
+		}
+
+		Glyph const &_lookup(Font const &font, unsigned char c, uint8_t alpha)
+		{
+			for (Glyph *g = _buckets[_bucket(font, c, alpha)]; g; g = g->next)
+				if (g->font == &font && g->c == c && g->alpha == alpha)
+					return *g;
+
+			return _create(font, c, alpha);
+		}
+
+		/**
+		 * Draw the part of a glyph row between the columns 'x1' and 'x2'
+		 */
+		template <typename PT>
+		static void _draw_row(Glyph const &glyph, unsigned row, PT *dst,
+		                      PT pixel, int x1, int x2)
+		{
+			for (unsigned i = glyph.rows[row]; i < glyph.rows[row + 1]; i++) {
+
+				Span const &span = glyph.spans[i];
+
+				int const from = Genode::max(x1, (int)span.x),
+				          to   = Genode::min(x2, span.x + span.len - 1);
+
+				if (from > to)
+					continue;
+
+				if (span.alpha == Span::OPAQUE) {
+					Genode::Pixel_row<PT>::fill(dst + from, pixel, to - from + 1);
+					continue;
+				}
+
+				uint8_t const *alpha = glyph.alphas + span.alpha + from - span.x;
+				for (int x = from; x <= to; x++, alpha++)
+					dst[x] = PT::mix(dst[x], pixel, *alpha);
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param max_bytes  memory used for cached glyphs, if exceeded,
+		 *                   the cache is flushed
+		 */
+		Glyph_cache(Genode::Allocator &alloc, size_t max_bytes = 256*1024)
+		: _alloc(alloc), _max_bytes(max_bytes) { }
+
+		~Glyph_cache() { flush(); }
+
+		/**
+		 * Remove all glyphs from the cache
+		 */
+		void flush()
+		{
+			for (unsigned i = 0; i < NUM_BUCKETS; i++)
+				while (Glyph *g = _buckets[i]) {
+					_buckets[i] = g->next;
+					_alloc.free(g, g->size);
+				}
+
+			_bytes = 0;
+		}
+
+		/**
+		 * Draw string into surface
+		 *
+		 * The result is the same as the one of 'Text_painter::paint'. The
+		 * glyphs are drawn row by row for up to 'BATCH' characters at a time.
+		 *
+		 * \throw Out_of_ram
+		 */
+		template <typename PT>
+		void paint(Genode::Surface<PT> &surface, Point p, Font const &font,
+		           Genode::Color color, char const *sstr)
+		{
+			unsigned char const *str = (unsigned char const *)sstr;
+			int x = p.x(), y = p.y();
+
+			Rect const clip = surface.clip();
+
+			int d, row = 0, h = font.img_h;
+
+			/* check top clipping */
+			if ((d = clip.y1() - y) > 0) {
+				row += d;
+				y   += d;
+				h   -= d;
+			}
+
+			/* check bottom clipping */
+			if ((d = y + h - 1 - clip.y2()) > 0)
+				h -= d;
+
+			if (h < 1) return;
+
+			/* skip hidden glyphs */
+			for ( ; *str && (x + font.wtab[*str] < clip.x1()); )
+				x += font.wtab[*str++];
+
+			int const x_start = x;
+
+			PT * const dst = surface.addr() + y*surface.size().w();
+
+			PT const pixel(color.r, color.g, color.b);
+
+			struct { Glyph const *glyph; int x, w; } batch[BATCH];
+
+			while (*str && x <= clip.x2()) {
+
+				/* make room before obtaining the glyphs of the batch */
+				if (_bytes > _max_bytes)
+					flush();
+
+				unsigned n = 0;
+				for (; n < BATCH && *str && x <= clip.x2(); n++, str++) {
+					batch[n].glyph = &_lookup(font, *str, color.a);
+					batch[n].x     = x;
+					batch[n].w     = font.wtab[*str];
+					x += batch[n].w;
+				}
+
+				PT *line = dst;
+				for (int j = 0; j < h; j++, line += surface.size().w())
+					for (unsigned i = 0; i < n; i++)
+						_draw_row(*batch[i].glyph, row + j, line + batch[i].x, pixel,
+						          Genode::max(0, clip.x1() - batch[i].x),
+						          Genode::min(batch[i].w - 1, clip.x2() - batch[i].x));
+			}
+
+			surface.flush_pixels(Rect(Point(x_start, y), Area(x - x_start + 1, h)));
+		}
+
+		/**
+		 * Draw glyph without clipping
+		 *
+		 * \param dst     pixel position of the top-left corner of the glyph
+		 * \param line_w  number of pixels per line of the destination
+		 *
+		 * \throw Out_of_ram
+		 */
+		template <typename PT>
+		void draw(PT *dst, unsigned line_w, Font const &font,
+		          Genode::Color color, unsigned char c)
+		{
+			if (_bytes > _max_bytes)
+				flush();
+
+			Glyph const &glyph = _lookup(font, c, color.a);
+
+			PT const pixel(color.r, color.g, color.b);
+			int  const w = font.wtab[c];
+
+			for (unsigned j = 0; j < glyph.h; j++, dst += line_w)
+				_draw_row(glyph, j, dst, pixel, 0, w - 1);
+		}
+};
+
+#endif /* _INCLUDE__NITPICKER_GFX__GLYPH_CACHE_H_ */
@@ -16,6 +16,7 @@
 
 #include <blit/blit.h>
 #include <os/texture.h>
+#include <os/pixel_row.h>
 
 
 struct Texture_painter
@@ -74,10 +75,11 @@ struct Texture_painter
 
 		PT const mix_pixel(mix_color.r, mix_color.g, mix_color.b);
 
-		int i, j;
-		PT            const *s;
-		PT                  *d;
-		unsigned char const *a;
+		typedef Genode::Pixel_row<PT> Row;
+
+		unsigned const w = clipped.w();
+
+		int j;
 
 		switch (mode) {
 
@@ -98,23 +100,19 @@ struct Texture_painter
 			 * Copy texture with alpha blending
 			 */
 			for (j = clipped.h(); j--; src += src_w, alpha += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, a = alpha, d = dst; i--; s++, d++, a++)
-					if (*a)
-						*d = PT::mix(*d, *s, *a);
+				Row::mix(dst, src, alpha, w);
 			break;
 
 		case MIXED:
 	
 			for (j = clipped.h(); j--; src += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, d = dst; i--; s++, d++)
-					*d = PT::avr(mix_pixel, *s);
+				Row::avr(dst, mix_pixel, src, w);
 			break;
 
 		case MASKED:
 
 			for (j = clipped.h(); j--; src += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, d = dst; i--; s++, d++)
-					if (s->pixel) *d = *s;
+				Row::masked(dst, src, w);
 			break;
 		}
 
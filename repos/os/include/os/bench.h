@@ -0,0 +1,77 @@
+/*
+ * \brief  Utilities shared by benchmarks and tests
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__OS__BENCH_H_
+#define _INCLUDE__OS__BENCH_H_
+
+/* Genode includes */
+#include <timer_session/connection.h>
+
+namespace Genode {
+
+	class Lcg_random;
+	struct Bench_result;
+
+	template <typename FN>
+	inline Bench_result bench_for(Timer::Connection &, unsigned long, FN const &);
+}
+
+
+/**
+ * Linear congruential generator for reproducible test data
+ *
+ * The low-order bits of the generated numbers have short periods. Hence,
+ * users should take the bits they need from the upper part.
+ */
+class Genode::Lcg_random
+{
+	private:
+
+		unsigned _state;
+
+	public:
+
+		Lcg_random(unsigned seed = 1) : _state(seed) { }
+
+		unsigned next() { return _state = _state*1103515245 + 12345; }
+};
+
+
+struct Genode::Bench_result
+{
+	unsigned long rounds;
+	unsigned long ms;      /* never zero */
+};
+
+
+/**
+ * Call 'fn' repeatedly until 'duration_ms' milliseconds have passed
+ */
+template <typename FN>
+Genode::Bench_result Genode::bench_for(Timer::Connection &timer,
+                                       unsigned long      duration_ms,
+                                       FN          const &fn)
+{
+	unsigned long const start_ms = timer.elapsed_ms();
+
+	unsigned long rounds = 0, ms = 0;
+	do {
+		fn();
+		rounds++;
+		ms = timer.elapsed_ms() - start_ms;
+	} while (ms < duration_ms);
+
+	return Bench_result { rounds, ms ? ms : 1 };
+}
+
+#endif /* _INCLUDE__OS__BENCH_H_ */
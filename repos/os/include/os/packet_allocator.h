@@ -16,7 +16,8 @@
 #define _INCLUDE__OS__PACKET_ALLOCATOR__
 
 #include <base/allocator.h>
-#include <util/bit_array.h>
+#include <util/misc_math.h>
+#include <util/string.h>
 
 namespace Genode { class Packet_allocator; }
 
@@ -25,29 +26,149 @@ namespace Genode { class Packet_allocator; }
  * This allocator is designed to be used as packet allocator for the
  * packet stream interface. It uses a minimal block size, which is the
  * granularity packets will be allocated with. As backend, it uses a
- * simple bit array to manage free, and allocated blocks.
+ * two-level bitmap to manage free and allocated blocks. Each bit of the
+ * first level marks a free block. Each bit of the summary level marks a
+ * word of the first level that contains at least one free block. Fully
+ * allocated regions of the buffer are thereby skipped one summary word
+ * at a time.
  */
 class Genode::Packet_allocator : public Genode::Range_allocator
 {
 	private:
 
-		Allocator      *_md_alloc;   /* meta-data allocator                 */
-		size_t          _block_size; /* granularity of packet allocations   */
-		void           *_bits;       /* memory chunk containing the bits    */
-		Bit_array_base *_array;      /* bit array managing available blocks */
-		addr_t          _base;       /* allocation base                     */
-		addr_t          _next;       /* next free bit index                 */
+		enum { BITS_PER_WORD = sizeof(addr_t)*8 };
+
+		enum : addr_t { INVALID = ~0UL };
+
+		Allocator *_md_alloc;         /* meta-data allocator                  */
+		size_t     _block_size;       /* granularity of packet allocations    */
+		addr_t    *_free_bits;        /* bit set for each free block          */
+		addr_t    *_summary_bits;     /* bit set for each word with free bits */
+		size_t     _num_words;        /* number of words of '_free_bits'      */
+		size_t     _num_summary_words;
+		addr_t     _base;             /* allocation base                      */
 
 		/*
 		 * Returns the count of blocks fitting the given size
 		 *
 		 * The block count returned is aligned to the bit count
-		 * of a machine word to fit the needs of the used bit array.
+		 * of a machine word to fit the needs of the bitmap.
 		 */
 		inline size_t _block_cnt(size_t bytes)
 		{
 			bytes /= _block_size;
-			return bytes - (bytes % (sizeof(addr_t)*8));
+			return bytes - (bytes % BITS_PER_WORD);
+		}
+
+		size_t _blocks_for_size(size_t size) const
+		{
+			return (size % _block_size) ? size / _block_size + 1
+			                            : size / _block_size;
+		}
+
+		static unsigned _first_bit(addr_t word) { return __builtin_ctzl(word); }
+
+		static addr_t _mask(unsigned first, unsigned cnt)
+		{
+			return (cnt == BITS_PER_WORD ? ~0UL : ((1UL << cnt) - 1)) << first;
+		}
+
+		void _update_summary(size_t word_idx)
+		{
+			addr_t &summary = _summary_bits[word_idx / BITS_PER_WORD];
+			addr_t  bit     = 1UL << (word_idx % BITS_PER_WORD);
+
+			summary = _free_bits[word_idx] ? summary | bit : summary & ~bit;
+		}
+
+		/**
+		 * Mark 'cnt' blocks starting at block 'idx' as free or allocated
+		 */
+		void _mark(addr_t idx, size_t cnt, bool free)
+		{
+			while (cnt) {
+				size_t   const word  = idx / BITS_PER_WORD;
+				unsigned const first = idx % BITS_PER_WORD;
+				unsigned const n     = min(cnt, (size_t)(BITS_PER_WORD - first));
+				addr_t   const mask  = _mask(first, n);
+
+				_free_bits[word] = free ? _free_bits[word] | mask
+				                        : _free_bits[word] & ~mask;
+				_update_summary(word);
+
+				idx += n;
+				cnt -= n;
+			}
+		}
+
+		/**
+		 * Return index of first word at or after 'word_idx' with a free block
+		 */
+		addr_t _next_free_word(size_t word_idx) const
+		{
+			size_t s = word_idx / BITS_PER_WORD;
+			if (s >= _num_summary_words)
+				return INVALID;
+
+			addr_t bits = _summary_bits[s] & (~0UL << (word_idx % BITS_PER_WORD));
+			for (;;) {
+				if (bits)
+					return s*BITS_PER_WORD + _first_bit(bits);
+
+				if (++s >= _num_summary_words)
+					return INVALID;
+
+				bits = _summary_bits[s];
+			}
+		}
+
+		/**
+		 * Return index of first free block, used for single-block packets
+		 */
+		addr_t _first_free_block() const
+		{
+			addr_t const word = _next_free_word(0);
+			return (word == INVALID) ? INVALID
+			                         : word*BITS_PER_WORD + _first_bit(_free_bits[word]);
+		}
+
+		/**
+		 * Return index of first range of 'cnt' consecutive free blocks
+		 */
+		addr_t _first_free_range(size_t cnt) const
+		{
+			size_t run = 0;
+			addr_t start = 0;
+
+			for (addr_t w = _next_free_word(0); w != INVALID; ) {
+
+				addr_t const word = _free_bits[w];
+
+				if (word == ~0UL) {
+					if (!run) start = w*BITS_PER_WORD;
+					run += BITS_PER_WORD;
+					if (run >= cnt)
+						return start;
+				} else {
+					for (unsigned b = 0; b < BITS_PER_WORD; b++) {
+						if (!(word & (1UL << b))) {
+							run = 0;
+							continue;
+						}
+						if (!run) start = w*BITS_PER_WORD + b;
+						if (++run >= cnt)
+							return start;
+					}
+				}
+
+				/* a run cannot span a fully allocated word */
+				addr_t const next = _next_free_word(w + 1);
+				if (next != w + 1)
+					run = 0;
+
+				w = next;
+			}
+			return INVALID;
 		}
 
 	public:
@@ -59,8 +180,9 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 		 * \param block_size     Granularity of packets in stream
 		 */
 		Packet_allocator(Allocator *md_alloc, size_t block_size)
-		: _md_alloc(md_alloc), _block_size(block_size), _bits(0),
-		  _array(nullptr), _base(0) {}
+		: _md_alloc(md_alloc), _block_size(block_size), _free_bits(nullptr),
+		  _summary_bits(nullptr), _num_words(0), _num_summary_words(0),
+		  _base(0) {}
 
 
 		/*******************************
@@ -69,13 +191,19 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 
 		int add_range(addr_t base, size_t size) override
 		{
-			if (_base || _array) return -1;
+			if (_base || _free_bits) return -1;
+
+			_num_words         = _block_cnt(size) / BITS_PER_WORD;
+			_num_summary_words = (_num_words + BITS_PER_WORD - 1) / BITS_PER_WORD;
 
-			_base  = base;
-			_bits  = _md_alloc->alloc(_block_cnt(size)/8);
-			_array = new (_md_alloc) Bit_array_base(_block_cnt(size),
-			                                        (addr_t*)_bits,
-			                                        true);
+			if (!_num_words) return -1;
+
+			_base         = base;
+			_free_bits    = (addr_t *)_md_alloc->alloc(_num_words*sizeof(addr_t));
+			_summary_bits = (addr_t *)_md_alloc->alloc(_num_summary_words*sizeof(addr_t));
+
+			memset(_summary_bits, 0, _num_summary_words*sizeof(addr_t));
+			_mark(0, _num_words*BITS_PER_WORD, true);
 			return 0;
 		}
 
@@ -83,8 +211,13 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 		{
 			if (_base != base) return -1;
 
-			if (_array) destroy(_md_alloc, _array);
-			if (_bits)  _md_alloc->free(_bits, _block_cnt(size)/8);
+			if (_free_bits)
+				_md_alloc->free(_free_bits, _num_words*sizeof(addr_t));
+			if (_summary_bits)
+				_md_alloc->free(_summary_bits, _num_summary_words*sizeof(addr_t));
+
+			_free_bits    = nullptr;
+			_summary_bits = nullptr;
 			return 0;
 		}
 
@@ -97,40 +230,31 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 
 		bool alloc(size_t size, void **out_addr) override
 		{
-			addr_t const cnt = (size % _block_size) ? size / _block_size + 1
-			                                        : size / _block_size;
-			addr_t max = ~0UL;
-
-			do {
-				try {
-					/* throws exception if array is accessed outside bounds */
-					for (addr_t i = _next & ~(cnt - 1); i < max; i += cnt) {
-						if (_array->get(i, cnt))
-							continue;
-
-						_array->set(i, cnt);
-						_next = i + cnt;
-						*out_addr = reinterpret_cast<void *>(i * _block_size
-						                                     + _base);
-						return true;
-					}
-				} catch (typename Bit_array_base::Invalid_index_access) { }
+			size_t const cnt = _blocks_for_size(size);
+			if (!cnt || !_free_bits)
+				return false;
 
-				max = _next;
-				_next = 0;
+			addr_t const i = (cnt == 1) ? _first_free_block()
+			                            : _first_free_range(cnt);
+			if (i == INVALID)
+				return false;
 
-			} while (max != 0);
-
-			return false;
+			_mark(i, cnt, false);
+			*out_addr = reinterpret_cast<void *>(i * _block_size + _base);
+			return true;
 		}
 
 		void free(void *addr, size_t size) override
 		{
-			addr_t i   = (((addr_t)addr) - _base) / _block_size;
-			size_t cnt = (size % _block_size) ? size / _block_size + 1
-			                                  : size / _block_size;
-			try { _array->clear(i, cnt); } catch(...) { }
-			_next = i;
+			addr_t const i   = (((addr_t)addr) - _base) / _block_size;
+			size_t const cnt = _blocks_for_size(size);
+
+			/* ignore attempts to free blocks outside of the managed range */
+			size_t const num_blocks = _num_words*BITS_PER_WORD;
+			if (i >= num_blocks || cnt > num_blocks - i)
+				return;
+
+			_mark(i, cnt, true);
 		}
 
 
@@ -63,6 +63,13 @@
  *
  * If bidirectional data exchange between two processes is desired, two pairs
  * of 'Packet_stream_source' and 'Packet_stream_sink' should be instantiated.
+ *
+ * The operations of a source or a sink may be called by multiple threads,
+ * which are serialized by a lock per queue. If a source or a sink is used
+ * by a single thread only, e.g., the entrypoint of a component, the locking
+ * can be skipped by calling 'single_threaded'. The batch operations
+ * 'submit_packets', 'get_acked_packets', 'get_packets', and
+ * 'acknowledge_packets' take the lock once per batch.
  */
 
 /*
@@ -78,15 +85,20 @@
 /* Genode includes */
 #include <base/env.h>
 #include <base/signal.h>
+#include <base/lock.h>
+#include <base/lock_guard.h>
 #include <dataspace/client.h>
 #include <util/string.h>
 #include <util/construct_at.h>
+#include <util/misc_math.h>
+#include <cpu/memory_barrier.h>
 
 namespace Genode {
 
 	class Packet_descriptor;
 
 	template <typename, int> class Packet_descriptor_queue;
+	class Packet_queue_lock;
 	template <typename>      class Packet_descriptor_transmitter;
 	template <typename>      class Packet_descriptor_receiver;
 
@@ -150,15 +162,34 @@ class Genode::Packet_descriptor
  * Ring buffer shared between source and sink, containing packet descriptors
  *
  * This class is private to the packet-stream interface.
+ *
+ * The queue is a single-producer/single-consumer ring buffer. The head index
+ * is solely written by the producer, the tail index solely by the consumer.
+ * Both indices are free-running counters that are masked when accessing the
+ * ring. They are placed in distinct cache lines to avoid false sharing
+ * between the producer and the consumer.
  */
 template <typename PACKET_DESCRIPTOR, int QUEUE_SIZE>
 class Genode::Packet_descriptor_queue
 {
 	private:
 
-		unsigned          _head;
-		unsigned          _tail;
-		PACKET_DESCRIPTOR _queue[QUEUE_SIZE];
+		static_assert(QUEUE_SIZE > 1 && (QUEUE_SIZE & (QUEUE_SIZE - 1)) == 0,
+		              "queue size must be a power of two");
+
+		enum { CACHE_LINE_SIZE = 64, INDEX_MASK = QUEUE_SIZE - 1 };
+
+		unsigned volatile _head __attribute__((aligned(CACHE_LINE_SIZE)));
+		unsigned volatile _tail __attribute__((aligned(CACHE_LINE_SIZE)));
+
+		PACKET_DESCRIPTOR _queue[QUEUE_SIZE] __attribute__((aligned(CACHE_LINE_SIZE)));
+
+		/*
+		 * The indices are controlled by the respective other side of the
+		 * shared-memory communication. Hence, the number of queued elements
+		 * is clamped to the queue size.
+		 */
+		unsigned _used() const { return Genode::min(_head - _tail, (unsigned)QUEUE_SIZE); }
 
 	public:
 
@@ -193,8 +224,15 @@ class Genode::Packet_descriptor_queue
 		{
 			if (full()) return false;
 
-			_queue[_head%QUEUE_SIZE] = packet;
-			_head = (_head + 1)%QUEUE_SIZE;
+			/* make sure that the consumer is done with reading the slot */
+			Genode::memory_barrier();
+
+			_queue[_head & INDEX_MASK] = packet;
+
+			/* publish the descriptor before advancing the head */
+			Genode::memory_barrier();
+
+			_head = _head + 1;
 			return true;
 		}
 
@@ -205,8 +243,12 @@ class Genode::Packet_descriptor_queue
 		 */
 		PACKET_DESCRIPTOR get()
 		{
-			PACKET_DESCRIPTOR packet = _queue[_tail%QUEUE_SIZE];
-			_tail = (_tail + 1)%QUEUE_SIZE;
+			PACKET_DESCRIPTOR packet = peek();
+
+			/* read the descriptor before handing back the slot */
+			Genode::memory_barrier();
+
+			_tail = _tail + 1;
 			return packet;
 		}
 
@@ -215,7 +257,10 @@ class Genode::Packet_descriptor_queue
 		 */
 		PACKET_DESCRIPTOR peek() const
 		{
-			return _queue[_tail%QUEUE_SIZE];
+			/* observe the head before reading the descriptor */
+			Genode::memory_barrier();
+
+			return _queue[_tail & INDEX_MASK];
 		}
 
 		/**
@@ -226,25 +271,58 @@ class Genode::Packet_descriptor_queue
 		/**
 		 * Return true if packet-descriptor queue is full
 		 */
-		bool full() { return (_head + 1)%QUEUE_SIZE == _tail; }
+		bool full() { return _used() == QUEUE_SIZE; }
 
 		/**
 		 * Return true if a single element is stored in the queue
 		 */
-		bool single_element() { return (_tail + 1)%QUEUE_SIZE == _head; }
+		bool single_element() { return _used() == 1; }
 
 
 		/**
 		 * Return true if a single slot is left to be put into the queue
 		 */
-		bool single_slot_free() { return (_head + 2)%QUEUE_SIZE == _tail; }
+		bool single_slot_free() { return slots_free() == 1; }
 
 		/**
 		 * Return number of slots left to be put into the queue
 		 */
-		unsigned slots_free() {
-			return ((_tail > _head) ? _tail - _head
-			                        : QUEUE_SIZE - _head + _tail) - 1; }
+		unsigned slots_free() { return QUEUE_SIZE - _used(); }
+
+		/**
+		 * Return number of elements stored in the queue
+		 */
+		unsigned elements() { return _used(); }
+};
+
+
+/**
+ * Lock that serializes the threads using one end of a queue
+ *
+ * This class is private to the packet-stream interface.
+ *
+ * The queue itself supports one producer and one consumer without locking.
+ * The lock is needed only if one end of the queue is used by multiple
+ * threads.
+ */
+class Genode::Packet_queue_lock
+{
+	private:
+
+		Genode::Lock _lock { };
+		bool         _enabled = true;
+
+	public:
+
+		typedef Genode::Lock_guard<Packet_queue_lock> Guard;
+
+		/**
+		 * Skip the locking, the queue end is used by one thread only
+		 */
+		void disable() { _enabled = false; }
+
+		void lock()   { if (_enabled) _lock.lock(); }
+		void unlock() { if (_enabled) _lock.unlock(); }
 };
 
 
@@ -266,11 +344,13 @@ class Genode::Packet_descriptor_transmitter
 		/* facility to send ready-to-receive signals */
 		Genode::Signal_transmitter         _rx_ready;
 
-		Genode::Lock _tx_queue_lock;
-		TX_QUEUE    *_tx_queue;
+		Packet_queue_lock _tx_queue_lock;
+		TX_QUEUE         *_tx_queue;
 
 	public:
 
+		typedef typename TX_QUEUE::Packet_descriptor Packet_descriptor;
+
 		/**
 		 * Constructor
 		 */
@@ -303,15 +383,17 @@ class Genode::Packet_descriptor_transmitter
 				_rx_ready.submit();
 		}
 
+		void single_threaded() { _tx_queue_lock.disable(); }
+
 		bool ready_for_tx()
 		{
-			Genode::Lock::Guard lock_guard(_tx_queue_lock);
+			Packet_queue_lock::Guard lock_guard(_tx_queue_lock);
 			return !_tx_queue->full();
 		}
 
-		void tx(typename TX_QUEUE::Packet_descriptor packet)
+		void tx(Packet_descriptor packet)
 		{
-			Genode::Lock::Guard lock_guard(_tx_queue_lock);
+			Packet_queue_lock::Guard lock_guard(_tx_queue_lock);
 
 			do {
 				/* block for signal if tx queue is full */
@@ -330,6 +412,31 @@ class Genode::Packet_descriptor_transmitter
 				_rx_ready.submit();
 		}
 
+		/**
+		 * Transmit as many of the given packets as fit into the tx queue
+		 *
+		 * In contrast to 'tx', this method never blocks and delivers at most
+		 * one signal to the receiver for the whole batch.
+		 *
+		 * \return number of transmitted packets
+		 */
+		unsigned tx_burst(Packet_descriptor const *packets, unsigned count)
+		{
+			Packet_queue_lock::Guard lock_guard(_tx_queue_lock);
+
+			unsigned n = 0;
+			for (; n < count && _tx_queue->add(packets[n]); n++);
+
+			/*
+			 * If the receiver may have observed an empty queue while we
+			 * were adding the batch, it may have gone to sleep.
+			 */
+			if (n && _tx_queue->elements() <= n)
+				_rx_ready.submit();
+
+			return n;
+		}
+
 		/**
 		 * Return number of slots left to be put into the tx queue
 		 */
@@ -355,11 +462,13 @@ class Genode::Packet_descriptor_receiver
 		/* facility to send ready-to-transmit signals */
 		Genode::Signal_transmitter        _tx_ready;
 
-		Genode::Lock mutable  _rx_queue_lock;
-		RX_QUEUE             *_rx_queue;
+		Packet_queue_lock mutable  _rx_queue_lock;
+		RX_QUEUE                  *_rx_queue;
 
 	public:
 
+		typedef typename RX_QUEUE::Packet_descriptor Packet_descriptor;
+
 		/**
 		 * Constructor
 		 */
@@ -392,15 +501,17 @@ class Genode::Packet_descriptor_receiver
 				_tx_ready.submit();
 		}
 
+		void single_threaded() { _rx_queue_lock.disable(); }
+
 		bool ready_for_rx()
 		{
-			Genode::Lock::Guard lock_guard(_rx_queue_lock);
+			Packet_queue_lock::Guard lock_guard(_rx_queue_lock);
 			return !_rx_queue->empty();
 		}
 
-		void rx(typename RX_QUEUE::Packet_descriptor *out_packet)
+		void rx(Packet_descriptor *out_packet)
 		{
-			Genode::Lock::Guard lock_guard(_rx_queue_lock);
+			Packet_queue_lock::Guard lock_guard(_rx_queue_lock);
 
 			while (_rx_queue->empty())
 				_rx_ready.wait_for_signal();
@@ -411,9 +522,35 @@ class Genode::Packet_descriptor_receiver
 				_tx_ready.submit();
 		}
 
-		typename RX_QUEUE::Packet_descriptor rx_peek() const
+		/**
+		 * Receive up to 'max_count' packets without blocking
+		 *
+		 * At most one signal is delivered to the transmitter for the whole
+		 * batch.
+		 *
+		 * \return number of received packets
+		 */
+		unsigned rx_burst(Packet_descriptor *out_packets, unsigned max_count)
+		{
+			Packet_queue_lock::Guard lock_guard(_rx_queue_lock);
+
+			unsigned n = 0;
+			for (; n < max_count && !_rx_queue->empty(); n++)
+				out_packets[n] = _rx_queue->get();
+
+			/*
+			 * If the transmitter may have observed a full queue while we
+			 * were removing the batch, it may have gone to sleep.
+			 */
+			if (n && _rx_queue->slots_free() <= n)
+				_tx_ready.submit();
+
+			return n;
+		}
+
+		Packet_descriptor rx_peek() const
 		{
-			Genode::Lock::Guard lock_guard(_rx_queue_lock);
+			Packet_queue_lock::Guard lock_guard(_rx_queue_lock);
 			return _rx_queue->peek();
 		}
 };
@@ -673,6 +810,18 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return (Content_type *)((Genode::addr_t)_ds_local_base + packet.offset());
 		}
 
+		/**
+		 * Skip the locking of the submit and acknowledgement queues
+		 *
+		 * This is an optimization for a source that is used by one thread
+		 * only. It must be called before the source is used.
+		 */
+		void single_threaded()
+		{
+			_submit_transmitter.single_threaded();
+			_ack_receiver.single_threaded();
+		}
+
 		/**
 		 * Return true if submit queue can hold another packet
 		 */
@@ -681,6 +830,12 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return _submit_transmitter.ready_for_tx();
 		}
 
+		/**
+		 * Return number of slots left in the submit queue
+		 */
+		unsigned submit_slots_free() {
+			return _submit_transmitter.tx_slots_free(); }
+
 		/**
 		 * Tell sink about a packet to process
 		 */
@@ -689,6 +844,19 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			_submit_transmitter.tx(packet);
 		}
 
+		/**
+		 * Tell sink about a batch of packets to process
+		 *
+		 * This method does not block. The sink is notified at most once.
+		 *
+		 * \return number of submitted packets, which is less than 'count'
+		 *         if the submit queue became full
+		 */
+		unsigned submit_packets(Packet_descriptor const packets[], unsigned count)
+		{
+			return _submit_transmitter.tx_burst(packets, count);
+		}
+
 		/**
 		 * Returns true if one or more packet acknowledgements are available
 		 */
@@ -704,6 +872,18 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return packet;
 		}
 
+		/**
+		 * Get up to 'max_count' acknowledged packets
+		 *
+		 * This method does not block.
+		 *
+		 * \return number of packets stored in 'packets'
+		 */
+		unsigned get_acked_packets(Packet_descriptor packets[], unsigned max_count)
+		{
+			return _ack_receiver.rx_burst(packets, max_count);
+		}
+
 		/**
 		 * Release bulk-buffer space consumed by the packet
 		 */
@@ -795,6 +975,18 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			return _submit_receiver.rx_ready_cap();
 		}
 
+		/**
+		 * Skip the locking of the submit and acknowledgement queues
+		 *
+		 * This is an optimization for a sink that is used by one thread
+		 * only. It must be called before the sink is used.
+		 */
+		void single_threaded()
+		{
+			_submit_receiver.single_threaded();
+			_ack_transmitter.single_threaded();
+		}
+
 		/**
 		 * Return true if a packet is available
 		 */
@@ -822,6 +1014,18 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			return packet;
 		}
 
+		/**
+		 * Get up to 'max_count' packets from source
+		 *
+		 * This method does not block.
+		 *
+		 * \return number of packets stored in 'packets'
+		 */
+		unsigned get_packets(Packet_descriptor packets[], unsigned max_count)
+		{
+			return _submit_receiver.rx_burst(packets, max_count);
+		}
+
 		/**
 		 * Return but do not dequeue next packet
 		 *
@@ -866,6 +1070,19 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			_ack_transmitter.tx(packet);
 		}
 
+		/**
+		 * Acknowledge a batch of processed packets
+		 *
+		 * This method does not block. The source is notified at most once.
+		 *
+		 * \return number of acknowledged packets, which is less than 'count'
+		 *         if the acknowledgement queue became full
+		 */
+		unsigned acknowledge_packets(Packet_descriptor const packets[], unsigned count)
+		{
+			return _ack_transmitter.tx_burst(packets, count);
+		}
+
 		void debug_print_buffers() {
 			Packet_stream_base::_debug_print_buffers(); }
 
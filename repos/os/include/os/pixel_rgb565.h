@@ -15,6 +15,7 @@
 #define _INCLUDE__OS__PIXEL_RGB565_H_
 
 #include <os/pixel_rgba.h>
+#include <os/pixel_row.h>
 
 namespace Genode {
 
@@ -56,6 +57,98 @@ namespace Genode {
 		res.pixel = blend(p1, 264 - alpha).pixel + blend(p2, alpha).pixel;
 		return res;
 	}
+
+
+#ifdef GENODE_PIXEL_ROW_SIMD
+	/**
+	 * Vectorized row operations, yielding the same results as the
+	 * per-pixel functions above
+	 */
+	template <>
+	struct Pixel_row<Pixel_rgb565> : Pixel_row_scalar<Pixel_rgb565>
+	{
+		typedef Pixel_row_scalar<Pixel_rgb565> Scalar;
+		typedef Pixel_simd::U16                V;
+
+		enum { N = sizeof(V)/sizeof(Pixel_rgb565) };
+
+		/*
+		 * Because the factor of the red and blue channels is at most 33
+		 * and the one of the green channel at most 264, all products fit
+		 * into 16 bits when the channels are separated.
+		 */
+		static inline V _blend(V p, V alpha)
+		{
+			V const a3 = alpha >> 3;
+			return ((((p >> 11)*a3) >> 5) << 11)
+			     | (((((p >> 6) & 0x1f)*alpha) >> 8) << 6)
+			     |  (((p & 0x1f)*a3) >> 5);
+		}
+
+		static inline V _mix(V p1, V p2, V alpha) {
+			return _blend(p1, 264 - alpha) + _blend(p2, alpha); }
+
+		static inline void fill(Pixel_rgb565 *dst, Pixel_rgb565 pixel, unsigned n)
+		{
+			V const v = Pixel_simd::broadcast<V>(pixel.pixel);
+			for (; n >= N; n -= N, dst += N)
+				Pixel_simd::store(dst, v);
+
+			Scalar::fill(dst, pixel, n);
+		}
+
+		static inline void mix(Pixel_rgb565 *dst, Pixel_rgb565 pixel, int alpha,
+		                       unsigned n)
+		{
+			V const p = Pixel_simd::broadcast<V>(pixel.pixel);
+			V const a = Pixel_simd::broadcast<V>(alpha);
+			for (; n >= N; n -= N, dst += N)
+				Pixel_simd::store(dst, _mix(Pixel_simd::load<V>(dst), p, a));
+
+			Scalar::mix(dst, pixel, alpha, n);
+		}
+
+		static inline void mix(Pixel_rgb565 *dst, Pixel_rgb565 const *src,
+		                       unsigned char const *alpha, unsigned n)
+		{
+			for (; n >= N; n -= N, dst += N, src += N, alpha += N) {
+
+				if (Pixel_simd::transparent(alpha, N))
+					continue;
+
+				V const a    = Pixel_simd::alpha<V>(alpha);
+				V const d    = Pixel_simd::load<V>(dst);
+				V const keep = (V)(a == 0);
+
+				Pixel_simd::store(dst, (d & keep)
+				                     | (_mix(d, Pixel_simd::load<V>(src), a) & ~keep));
+			}
+
+			Scalar::mix(dst, src, alpha, n);
+		}
+
+		static inline void avr(Pixel_rgb565 *dst, Pixel_rgb565 pixel,
+		                       Pixel_rgb565 const *src, unsigned n)
+		{
+			V const p = (Pixel_simd::broadcast<V>(pixel.pixel) & 0xf7df) >> 1;
+			for (; n >= N; n -= N, dst += N, src += N)
+				Pixel_simd::store(dst, p + ((Pixel_simd::load<V>(src) & 0xf7df) >> 1));
+
+			Scalar::avr(dst, pixel, src, n);
+		}
+
+		static inline void masked(Pixel_rgb565 *dst, Pixel_rgb565 const *src,
+		                          unsigned n)
+		{
+			for (; n >= N; n -= N, dst += N, src += N) {
+				V const s = Pixel_simd::load<V>(src);
+				Pixel_simd::store(dst, (Pixel_simd::load<V>(dst) & (V)(s == 0)) | s);
+			}
+
+			Scalar::masked(dst, src, n);
+		}
+	};
+#endif /* GENODE_PIXEL_ROW_SIMD */
 }
 
 #endif /* _INCLUDE__OS__PIXEL_RGB565_H_ */
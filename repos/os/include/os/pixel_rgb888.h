@@ -15,6 +15,7 @@
 #define _INCLUDE__OS__PIXEL_RGB888_H_
 
 #include <os/pixel_rgba.h>
+#include <os/pixel_row.h>
 
 namespace Genode {
 
@@ -22,6 +23,15 @@ namespace Genode {
 	                  0xff0000, 16, 0xff00, 8, 0xff, 0, 0, 0>
 	        Pixel_rgb888;
 
+	template <>
+	inline Pixel_rgb888 Pixel_rgb888::avr(Pixel_rgb888 p1, Pixel_rgb888 p2)
+	{
+		Pixel_rgb888 res;
+		res.pixel = ((p1.pixel&0xfefefe)>>1) + ((p2.pixel&0xfefefe)>>1);
+		return res;
+	}
+
+
 	template <>
 	inline Pixel_rgb888 Pixel_rgb888::blend(Pixel_rgb888 src, int alpha)
 	{
@@ -40,6 +50,102 @@ namespace Genode {
 		res.pixel = blend(p1, 255 - alpha).pixel + blend(p2, alpha).pixel;
 		return res;
 	}
+
+
+#ifdef GENODE_PIXEL_ROW_SIMD
+	/**
+	 * Vectorized row operations, yielding the same results as the
+	 * per-pixel functions above
+	 */
+	template <>
+	struct Pixel_row<Pixel_rgb888> : Pixel_row_scalar<Pixel_rgb888>
+	{
+		typedef Pixel_row_scalar<Pixel_rgb888> Scalar;
+		typedef Pixel_simd::U32                V;
+		typedef Pixel_simd::U16                W;
+
+		enum { N = sizeof(V)/sizeof(Pixel_rgb888) };
+
+		/*
+		 * The channels are processed as 16-bit values, the lower byte of
+		 * each 16-bit half of a pixel holds blue or red, the upper byte
+		 * holds green or the unused alpha channel. The 'alpha' vector
+		 * contains the alpha value in both halves of each pixel.
+		 */
+		static inline W _blend(W p, W alpha) {
+			return (((p & 0xff)*alpha) >> 8) | (((p >> 8)*alpha) & 0xff00); }
+
+		/*
+		 * The sum of both blended channels never exceeds 255. Hence, no
+		 * carry crosses the channel boundaries.
+		 */
+		static inline V _mix(V p1, V p2, V alpha)
+		{
+			W const a = (W)(alpha | (alpha << 16));
+			return (V)(_blend((W)p1, 255 - a) + _blend((W)p2, a)) & 0xffffff;
+		}
+
+		static inline void fill(Pixel_rgb888 *dst, Pixel_rgb888 pixel, unsigned n)
+		{
+			V const v = Pixel_simd::broadcast<V>(pixel.pixel);
+			for (; n >= N; n -= N, dst += N)
+				Pixel_simd::store(dst, v);
+
+			Scalar::fill(dst, pixel, n);
+		}
+
+		static inline void mix(Pixel_rgb888 *dst, Pixel_rgb888 pixel, int alpha,
+		                       unsigned n)
+		{
+			V const p = Pixel_simd::broadcast<V>(pixel.pixel);
+			V const a = Pixel_simd::broadcast<V>(alpha);
+			for (; n >= N; n -= N, dst += N)
+				Pixel_simd::store(dst, _mix(Pixel_simd::load<V>(dst), p, a));
+
+			Scalar::mix(dst, pixel, alpha, n);
+		}
+
+		static inline void mix(Pixel_rgb888 *dst, Pixel_rgb888 const *src,
+		                       unsigned char const *alpha, unsigned n)
+		{
+			for (; n >= N; n -= N, dst += N, src += N, alpha += N) {
+
+				if (Pixel_simd::transparent(alpha, N))
+					continue;
+
+				V const a    = Pixel_simd::alpha<V>(alpha);
+				V const d    = Pixel_simd::load<V>(dst);
+				V const keep = (V)(a == 0);
+
+				Pixel_simd::store(dst, (d & keep)
+				                     | (_mix(d, Pixel_simd::load<V>(src), a) & ~keep));
+			}
+
+			Scalar::mix(dst, src, alpha, n);
+		}
+
+		static inline void avr(Pixel_rgb888 *dst, Pixel_rgb888 pixel,
+		                       Pixel_rgb888 const *src, unsigned n)
+		{
+			V const p = (Pixel_simd::broadcast<V>(pixel.pixel) & 0xfefefe) >> 1;
+			for (; n >= N; n -= N, dst += N, src += N)
+				Pixel_simd::store(dst, p + ((Pixel_simd::load<V>(src) & 0xfefefe) >> 1));
+
+			Scalar::avr(dst, pixel, src, n);
+		}
+
+		static inline void masked(Pixel_rgb888 *dst, Pixel_rgb888 const *src,
+		                          unsigned n)
+		{
+			for (; n >= N; n -= N, dst += N, src += N) {
+				V const s = Pixel_simd::load<V>(src);
+				Pixel_simd::store(dst, (Pixel_simd::load<V>(dst) & (V)(s == 0)) | s);
+			}
+
+			Scalar::masked(dst, src, n);
+		}
+	};
+#endif /* GENODE_PIXEL_ROW_SIMD */
 }
 
 #endif /* _INCLUDE__OS__PIXEL_RGB888_H_ */
@@ -0,0 +1,189 @@
+/*
+ * \brief  Operations on rows of pixels
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The painters apply the same operation to each pixel of a row. The generic
+ * implementation processes one pixel per iteration by using the functions
+ * of the pixel type. Pixel types may specialize 'Pixel_row' to process
+ * several pixels at once. The specializations for the RGB565 and RGB888
+ * formats use the vector extensions of the compiler, which are translated
+ * to SSE2 or AVX2 instructions on x86 and to NEON instructions on ARM. They
+ * are enabled only if the compiler targets one of these instruction sets.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__OS__PIXEL_ROW_H_
+#define _INCLUDE__OS__PIXEL_ROW_H_
+
+#include <base/stdint.h>
+
+#if defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define GENODE_PIXEL_ROW_SIMD 1
+#endif
+
+namespace Genode {
+
+	template <typename PT> struct Pixel_row_scalar;
+	template <typename PT> struct Pixel_row;
+
+#ifdef GENODE_PIXEL_ROW_SIMD
+	namespace Pixel_simd {
+
+		/* number of bytes processed by one vector operation */
+#ifdef __AVX2__
+		enum { BYTES = 32 };
+#else
+		enum { BYTES = 16 };
+#endif
+
+		typedef uint64_t U64 __attribute__((vector_size(BYTES)));
+		typedef uint32_t U32 __attribute__((vector_size(BYTES)));
+		typedef uint16_t U16 __attribute__((vector_size(BYTES)));
+		typedef uint8_t  U8  __attribute__((vector_size(BYTES)));
+
+		template <typename V>
+		static inline V load(void const *src)
+		{
+			V v;
+			__builtin_memcpy(&v, src, sizeof(V));
+			return v;
+		}
+
+		template <typename V>
+		static inline void store(void *dst, V v) {
+			__builtin_memcpy(dst, &v, sizeof(V)); }
+
+		/**
+		 * Return vector with all elements set to 'value'
+		 */
+		template <typename V>
+		static inline V broadcast(unsigned value)
+		{
+			V v;
+			for (unsigned i = 0; i < sizeof(V)/sizeof(v[0]); i++)
+				v[i] = value;
+			return v;
+		}
+
+		/**
+		 * Return vector of alpha values, one element per pixel
+		 *
+		 * The alpha values are zero-extended by interleaving them with
+		 * zeros, which the compiler translates to unpack instructions.
+		 */
+		template <typename V>
+		static inline V alpha(unsigned char const *alpha)
+		{
+			enum { N = sizeof(V)/sizeof((V){}[0]) };
+
+			uint64_t a[2] = { 0, 0 };
+			__builtin_memcpy(a, alpha, N);
+
+			U8 const bytes = (U8)(U64){ a[0], a[1] };
+
+#ifdef __AVX2__
+			U8 const to_16 = {  0, 32,  1, 33,  2, 34,  3, 35,  4, 36,  5, 37,
+			                    6, 38,  7, 39,  8, 40,  9, 41, 10, 42, 11, 43,
+			                   12, 44, 13, 45, 14, 46, 15, 47 };
+			U16 const to_32 = { 0, 16, 1, 17, 2, 18, 3, 19,
+			                    4, 20, 5, 21, 6, 22, 7, 23 };
+#else
+			U8 const to_16 = { 0, 16, 1, 17, 2, 18, 3, 19,
+			                   4, 20, 5, 21, 6, 22, 7, 23 };
+			U16 const to_32 = { 0, 8, 1, 9, 2, 10, 3, 11 };
+#endif
+			U16 const words = (U16)__builtin_shuffle(bytes, U8(), to_16);
+
+			if (sizeof((V){}[0]) == sizeof(uint16_t))
+				return (V)words;
+
+			return (V)__builtin_shuffle(words, U16(), to_32);
+		}
+
+		/**
+		 * Return true if 'n' alpha values starting at 'alpha' are zero
+		 */
+		static inline bool transparent(unsigned char const *alpha, unsigned n)
+		{
+			uint64_t any = 0;
+			for (unsigned i = 0; i < n; i += sizeof(any)) {
+				uint64_t v = 0;
+				__builtin_memcpy(&v, alpha + i, n - i < sizeof(v) ? n - i : sizeof(v));
+				any |= v;
+			}
+			return !any;
+		}
+	}
+#endif /* GENODE_PIXEL_ROW_SIMD */
+}
+
+
+/**
+ * Generic implementation that processes one pixel per iteration
+ */
+template <typename PT>
+struct Genode::Pixel_row_scalar
+{
+	/**
+	 * Set 'n' pixels to 'pixel'
+	 */
+	static inline void fill(PT *dst, PT pixel, unsigned n)
+	{
+		for (; n--; dst++)
+			*dst = pixel;
+	}
+
+	/**
+	 * Mix 'n' pixels with 'pixel' at the ratio of 'alpha'
+	 */
+	static inline void mix(PT *dst, PT pixel, int alpha, unsigned n)
+	{
+		for (; n--; dst++)
+			*dst = PT::mix(*dst, pixel, alpha);
+	}
+
+	/**
+	 * Mix 'n' pixels with the source pixels using per-pixel alpha values
+	 *
+	 * Destination pixels with a zero alpha value remain untouched.
+	 */
+	static inline void mix(PT *dst, PT const *src, unsigned char const *alpha,
+	                       unsigned n)
+	{
+		for (; n--; dst++, src++, alpha++)
+			if (*alpha)
+				*dst = PT::mix(*dst, *src, *alpha);
+	}
+
+	/**
+	 * Set 'n' pixels to the average of 'pixel' and the source pixels
+	 */
+	static inline void avr(PT *dst, PT pixel, PT const *src, unsigned n)
+	{
+		for (; n--; dst++, src++)
+			*dst = PT::avr(pixel, *src);
+	}
+
+	/**
+	 * Copy the source pixels that differ from zero
+	 */
+	static inline void masked(PT *dst, PT const *src, unsigned n)
+	{
+		for (; n--; dst++, src++)
+			if (src->pixel)
+				*dst = *src;
+	}
+};
+
+
+template <typename PT>
+struct Genode::Pixel_row : Pixel_row_scalar<PT> { };
+
+#endif /* _INCLUDE__OS__PIXEL_ROW_H_ */
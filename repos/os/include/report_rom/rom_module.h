@@ -18,6 +18,7 @@
 #include <util/reconstructible.h>
 #include <os/session_policy.h>
 #include <base/attached_ram_dataspace.h>
+#include <base/allocator.h>
 
 namespace Rom {
 	using Genode::size_t;
@@ -25,6 +26,7 @@ namespace Rom {
 	using Genode::Attached_ram_dataspace;
 
 	class Module;
+	class Snapshot;
 	class Readable_module;
 	class Registry;
 	class Writer;
@@ -50,6 +52,43 @@ struct Rom::Reader : Reader_list::Element
 };
 
 
+/**
+ * Immutable content of a ROM module at the time of a report
+ *
+ * A snapshot stays unchanged once published. It can thereby be handed out
+ * to any number of readers at the same time. It is freed once it is neither
+ * the current content of its module nor referenced by a reader.
+ */
+class Rom::Snapshot : Genode::Noncopyable
+{
+	private:
+
+		friend class Module;
+
+		Attached_ram_dataspace _ds;
+
+		size_t        _size;        /* content size w/o zero termination */
+		unsigned long _generation;
+		unsigned      _refs = 0;
+
+		Snapshot(Genode::Ram_session &ram, Genode::Region_map &rm,
+		         size_t capacity, unsigned long generation)
+		:
+			_ds(ram, rm, capacity), _size(0), _generation(generation)
+		{ }
+
+	public:
+
+		Genode::Ram_dataspace_capability cap() const { return _ds.cap(); }
+
+		char const *content() const { return _ds.local_addr<char const>(); }
+
+		size_t size() const { return _size; }
+
+		unsigned long generation() const { return _generation; }
+};
+
+
 struct Rom::Readable_module
 {
 	/**
@@ -68,6 +107,28 @@ struct Rom::Readable_module
 	                            size_t dst_len) const = 0;
 
 	virtual size_t size() const = 0;
+
+	/**
+	 * Return true if the reader may currently obtain the content
+	 */
+	virtual bool read_permitted(Reader const &reader) const = 0;
+
+	/**
+	 * Return number that changes whenever the content changes
+	 */
+	virtual unsigned long generation() const = 0;
+
+	/**
+	 * Obtain reference to the current content
+	 *
+	 * \return snapshot, or nullptr if the module has no content or the
+	 *         reader is not permitted to read it
+	 *
+	 * Each acquired snapshot must be released via 'release_snapshot'.
+	 */
+	virtual Snapshot *acquire_snapshot(Reader const &reader) = 0;
+
+	virtual void release_snapshot(Snapshot &snapshot) = 0;
 };
 
 
@@ -132,19 +193,71 @@ struct Rom::Module : Module_list::Element, Readable_module
 		Writer const *_last_writer = nullptr;
 
 		/**
-		 * Dataspace used as backing store
+		 * Allocator for the meta data of the snapshots
 		 *
-		 * The buffer for the content is not allocated from the heap to
-		 * allow for the immediate release of the underlying backing store when
-		 * the module gets destructed.
+		 * The content of each snapshot is not allocated from the heap but
+		 * kept in a dedicated dataspace. This allows for the immediate
+		 * release of the underlying backing store when the snapshot gets
+		 * destructed, and for handing out the dataspace to readers.
 		 */
-		Constructible<Attached_ram_dataspace> _ds;
+		Genode::Allocator &_snapshot_alloc;
 
 		/**
-		 * Content size, which may less than the capacilty of '_ds'.
+		 * Snapshot of the current content
+		 */
+		Snapshot *_snapshot = nullptr;
+
+		/**
+		 * Content size, which may less than the capacity of '_snapshot'.
 		 */
 		size_t _size = 0;
 
+		unsigned long _generation = 0;
+
+		void _destroy_if_unused(Snapshot &snapshot)
+		{
+			if (&snapshot != _snapshot && snapshot._refs == 0)
+				Genode::destroy(_snapshot_alloc, &snapshot);
+		}
+
+		/**
+		 * Replace current snapshot by one that can hold 'capacity' bytes
+		 *
+		 * The snapshot is modified in place if no reader refers to it.
+		 */
+		Snapshot &_writable_snapshot(size_t capacity)
+		{
+			_generation++;
+
+			if (_snapshot && _snapshot->_refs == 0
+			 && _snapshot->_ds.size() >= capacity) {
+				_snapshot->_generation = _generation;
+				return *_snapshot;
+			}
+
+			Snapshot *old = _snapshot;
+
+			_snapshot = new (_snapshot_alloc)
+				Snapshot(_ram, _rm, capacity, _generation);
+
+			if (old)
+				_destroy_if_unused(*old);
+
+			return *_snapshot;
+		}
+
+		void _clear()
+		{
+			_generation++;
+			_size = 0;
+
+			Snapshot *old = _snapshot;
+			_snapshot = nullptr;
+
+			if (old)
+				_destroy_if_unused(*old);
+		}
+
 
 		/********************************
 		 ** Interface used by registry **
@@ -159,6 +272,8 @@ struct Rom::Module : Module_list::Element, Readable_module
 		 *                      backing store
 		 * \param rm            region map of the local address space, needed
 		 *                      to access the allocated backing store
+		 * \param alloc         allocator for the meta data of the module's
+		 *                      snapshots, may be shared among modules
 		 * \param name          module name
 		 * \param read_policy   policy hook function that is evaluated each
 		 *                      time when the module content is obtained
@@ -167,12 +282,14 @@ struct Rom::Module : Module_list::Element, Readable_module
 		 */
 		Module(Genode::Ram_session &ram,
 		       Genode::Region_map  &rm,
+		       Genode::Allocator   &alloc,
 		       Name          const &name,
 		       Read_policy   const &read_policy,
 		       Write_policy  const &write_policy)
 		:
 			_name(name), _ram(ram), _rm(rm),
-			_read_policy(read_policy), _write_policy(write_policy)
+			_read_policy(read_policy), _write_policy(write_policy),
+			_snapshot_alloc(alloc)
 		{ }
 
 
@@ -204,8 +321,7 @@ struct Rom::Module : Module_list::Element, Readable_module
 
 			/* clear content if its origin disappears */
 			if (_last_writer == &writer) {
-				Genode::memset(_ds->local_addr<char>(), 0, _size);
-				_size = 0;
+				_clear();
 				_last_writer = nullptr;
 			}
 		}
@@ -228,6 +344,8 @@ struct Rom::Module : Module_list::Element, Readable_module
 
 	public:
 
+		~Module() { if (_snapshot) _clear(); }
+
 		/**
 		 * Assign new content to the ROM module
 		 *
@@ -238,26 +356,30 @@ struct Rom::Module : Module_list::Element, Readable_module
 			if (!_write_policy.write_permitted(*this, writer))
 				return;
 
-			_size = 0;
+			/* skip the notification of the readers if nothing changed */
+			if (_snapshot && _last_writer == &writer && _size == src_len
+			 && Genode::memcmp(_snapshot->content(), src, src_len) == 0)
+				return;
 
 			_last_writer = &writer;
 
 			/*
-			 * Realloc backing store if needed
-			 *
 			 * Take a terminating zero into account, which we append to each
 			 * report. This way, we do not need to trust report clients to
 			 * append a zero termination to textual reports.
 			 */
-			if (!_ds.constructed() || _ds->size() < (src_len + 1))
-				_ds.construct(_ram, _rm, (src_len + 1));
+			Snapshot &snapshot = _writable_snapshot(src_len + 1);
+
+			char * const dst = snapshot._ds.local_addr<char>();
 
 			/* copy content into backing store */
-			_size = src_len;
-			Genode::memcpy(_ds->local_addr<char>(), src, _size);
+			Genode::memcpy(dst, src, src_len);
 
-			/* append zero termination */
-			_ds->local_addr<char>()[src_len] = 0;
+			/* append zero termination, clear remainder of previous content */
+			Genode::memset(dst + src_len, 0,
+			               Genode::max(snapshot._size, src_len) - src_len + 1);
+
+			_size = snapshot._size = src_len;
 
 			/* notify ROM clients that access the module */
 			for (Reader *r = _readers.first(); r; r = r->next()) {
@@ -274,21 +396,41 @@ struct Rom::Module : Module_list::Element, Readable_module
 		 */
 		size_t read_content(Reader const &reader, char *dst, size_t dst_len) const override
 		{
-			if (!_ds.constructed() || !_last_writer)
-				return 0;
-
-			if (!_read_policy.read_permitted(*this, *_last_writer, reader))
+			if (!read_permitted(reader))
 				return 0;
 
 			if (dst_len < _size)
 				throw Buffer_too_small();
 
-			Genode::memcpy(dst, _ds->local_addr<char>(), _size);
+			Genode::memcpy(dst, _snapshot->content(), _size);
 			return _size;
 		}
 
 		virtual size_t size() const override { return _size; }
 
+		bool read_permitted(Reader const &reader) const override
+		{
+			return _snapshot && _last_writer
+			    && _read_policy.read_permitted(*this, *_last_writer, reader);
+		}
+
+		unsigned long generation() const override { return _generation; }
+
+		Snapshot *acquire_snapshot(Reader const &reader) override
+		{
+			if (!read_permitted(reader))
+				return nullptr;
+
+			_snapshot->_refs++;
+			return _snapshot;
+		}
+
+		void release_snapshot(Snapshot &snapshot) override
+		{
+			snapshot._refs--;
+			_destroy_if_unused(snapshot);
+		}
+
 		Name name() const { return _name; }
 };
 
@@ -51,10 +51,41 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 				throw Genode::Service_denied(); }
 		}
 
+		/**
+		 * Hand out the snapshots of the module instead of private copies
+		 *
+		 * A snapshot is shared by all readers of the module. Because the
+		 * dataspace cannot be attached read-only by the client, sharing is
+		 * suitable only if the readers of a module trust each other.
+		 */
+		bool const _zero_copy;
+
 		Constructible<Genode::Attached_ram_dataspace> _ds;
 
+		Snapshot *_snapshot = nullptr;
+
 		size_t _content_size = 0;
 
+		/**
+		 * Module generation and read permission of the delivered content
+		 */
+		unsigned long _generation = 0;
+		bool          _permitted  = false;
+
+		bool _up_to_date() const
+		{
+			return _generation == _module.generation()
+			    && _permitted  == _module.read_permitted(*this);
+		}
+
+		void _release_snapshot()
+		{
+			if (_snapshot)
+				_module.release_snapshot(*_snapshot);
+
+			_snapshot = nullptr;
+		}
+
 		/**
 		 * Keep state of valid content to notify the client only once when
 		 * the ROM module becomes invalid.
@@ -73,10 +104,12 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		Session_component(Genode::Ram_session &ram, Genode::Region_map &rm,
 		                  Registry_for_reader &registry,
-		                  Genode::Session_label const &label)
+		                  Genode::Session_label const &label,
+		                  bool zero_copy = false)
 		:
 			_ram(ram), _rm(rm),
-			_registry(registry), _label(label), _module(_init_module(label))
+			_registry(registry), _label(label), _module(_init_module(label)),
+			_zero_copy(zero_copy)
 		{ }
 
 		/**
@@ -90,11 +123,13 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 		:
 			_ram(*Genode::env_deprecated()->ram_session()),
 			_rm(*Genode::env_deprecated()->rm_session()),
-			_registry(registry), _label(label), _module(_init_module(label))
+			_registry(registry), _label(label), _module(_init_module(label)),
+			_zero_copy(false)
 		{ }
 
 		~Session_component()
 		{
+			_release_snapshot();
 			_registry.release(*this, _module);
 		}
 
@@ -104,6 +139,29 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 		{
 			using namespace Genode;
 
+				_generation = _module.generation();
+				_permitted  = _module.read_permitted(*this);
+
+				/* hand out current snapshot if possible */
+				if (_zero_copy) {
+					Snapshot * const old = _snapshot;
+
+					_snapshot = _module.acquire_snapshot(*this);
+
+					if (old)
+						_module.release_snapshot(*old);
+
+					if (_snapshot) {
+						_ds.destruct();
+						_content_size = _snapshot->size();
+						_valid = _content_size > 0;
+
+						Dataspace_capability ds_cap =
+							static_cap_cast<Dataspace>(_snapshot->cap());
+						return static_cap_cast<Rom_dataspace>(ds_cap);
+					}
+				}
+
 				/* replace dataspace by new one */
 				/* XXX we could keep the old dataspace if the size fits */
 				_ds.construct(_ram, _rm, _module.size());
@@ -121,9 +179,24 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		bool update() override
 		{
+			/* skip the update if the content has not changed */
+			if ((_ds.constructed() || _snapshot) && _up_to_date())
+				return true;
+
+			/* a snapshot is never modified, the client must obtain a new one */
+			if (_snapshot)
+				return false;
+
 			if (!_ds.constructed() || _module.size() > _ds->size())
 				return false;
 
+			/* a private copy is not needed if the snapshot can be shared */
+			if (_zero_copy && _module.read_permitted(*this))
+				return false;
+
+			_generation = _module.generation();
+			_permitted  = _module.read_permitted(*this);
+
 			size_t const new_content_size =
 				_module.read_content(*this, _ds->local_addr<char>(), _ds->size());
 
@@ -180,6 +253,7 @@ class Rom::Root : public Genode::Root_component<Session_component>
 
 		Genode::Env         &_env;
 		Registry_for_reader &_registry;
+		bool const           _zero_copy;
 
 	protected:
 
@@ -188,17 +262,25 @@ class Rom::Root : public Genode::Root_component<Session_component>
 			using namespace Genode;
 
 			return new (md_alloc())
-				Session_component(_env.ram(), _env.rm(), _registry, label_from_args(args));
+				Session_component(_env.ram(), _env.rm(), _registry,
+				                  label_from_args(args), _zero_copy);
 		}
 
 	public:
 
+		/**
+		 * Constructor
+		 *
+		 * \param zero_copy  share the snapshots of the modules among the
+		 *                   readers instead of handing out private copies
+		 */
 		Root(Genode::Env          &env,
 		     Genode::Allocator    &md_alloc,
-		     Registry_for_reader  &registry)
+		     Registry_for_reader  &registry,
+		     bool                  zero_copy = false)
 		:
 			Genode::Root_component<Session_component>(&env.ep().rpc_ep(), &md_alloc),
-			_env(env), _registry(registry)
+			_env(env), _registry(registry), _zero_copy(zero_copy)
 		{ }
 };
 
@@ -16,6 +16,7 @@
 
 /* Genode includes */
 #include <base/allocator.h>
+#include <util/misc_math.h>
 
 
 /**
@@ -24,50 +25,118 @@
  *
  * The 'CELL' type must have a default constructor and has to provide the
  * methods 'set_cursor()' and 'clear_cursor'.
+ *
+ * Each line keeps track of the range of columns changed since the line was
+ * marked as clean. Scroll operations do not mark the lines of the scroll
+ * region as dirty. Instead, they are recorded such that the consumer can
+ * move the already rendered lines and draw only the lines scrolled in.
  */
 template <typename CELL>
 class Cell_array
 {
+	public:
+
+		/**
+		 * Scroll operations not yet reflected by the consumer
+		 */
+		struct Scroll
+		{
+			int start, end;   /* first and last line of the scroll region */
+			int lines;        /* number of lines, positive if scrolled up */
+
+			bool pending() const { return lines != 0; }
+		};
+
 	private:
 
+		struct Line
+		{
+			CELL *cells;
+
+			/* range of dirty columns, empty if 'first_dirty' > 'last_dirty' */
+			unsigned first_dirty, last_dirty;
+		};
+
 		unsigned           _num_cols;
 		unsigned           _num_lines;
 		Genode::Allocator *_alloc;
-		CELL             **_array;
-		bool              *_line_dirty;
+		Line              *_lines;
+		Scroll             _scroll { 0, 0, 0 };
 
-		typedef CELL *Char_cell_line;
-
-		void _clear_line(Char_cell_line line)
+		void _clear_line(Line &line)
 		{
 			for (unsigned col = 0; col < _num_cols; col++)
-				*line++ = CELL();
+				line.cells[col] = CELL();
+		}
+
+		static void _mark_as_clean(Line &line)
+		{
+			line.first_dirty = ~0U;
+			line.last_dirty  = 0;
+		}
+
+		static void _mark_as_dirty(Line &line, unsigned first, unsigned last)
+		{
+			line.first_dirty = Genode::min(first, line.first_dirty);
+			line.last_dirty  = Genode::max(last,  line.last_dirty);
 		}
 
 		void _mark_lines_as_dirty(int start, int end)
 		{
 			for (int line = start; line <= end; line++)
-				_line_dirty[line] = true;
+				_mark_as_dirty(_lines[line], 0, _num_cols - 1);
+		}
+
+		/**
+		 * Record scroll operation of one line
+		 *
+		 * Scroll operations of the same region in the same direction are
+		 * accumulated. Any other scroll operation is reflected by marking
+		 * the lines of its region as dirty. Because the dirty state of each
+		 * line moves along with its content, lines that do not match the
+		 * recorded operation are always dirty.
+		 */
+		void _record_scroll(int start, int end, int lines)
+		{
+			if (!_scroll.pending())
+				_scroll = Scroll { start, end, 0 };
+
+			bool const same = _scroll.start == start && _scroll.end == end
+			               && (_scroll.lines == 0 || (_scroll.lines > 0) == (lines > 0));
+
+			if (!same) {
+				_mark_lines_as_dirty(start, end);
+				return;
+			}
+
+			/* once all lines are scrolled out, the whole region is dirty */
+			if (Genode::abs(_scroll.lines) <= end - start)
+				_scroll.lines += lines;
 		}
 
 		void _scroll_vertically(int start, int end, bool up)
 		{
+			/* rotating an empty region would duplicate a line */
+			if (start > end || start < 0 || end >= (int)_num_lines)
+				return;
+
 			/* rotate lines of the scroll region */
-			Char_cell_line yanked_line = _array[up ? start : end];
+			Line yanked_line = _lines[up ? start : end];
 
 			if (up) {
 				for (int line = start; line <= end - 1; line++)
-					_array[line] = _array[line + 1];
+					_lines[line] = _lines[line + 1];
 			} else {
 				for (int line = end; line >= start + 1; line--)
-					_array[line] = _array[line - 1];
+					_lines[line] = _lines[line - 1];
 			}
 
 			_clear_line(yanked_line);
+			_mark_as_dirty(yanked_line, 0, _num_cols - 1);
 
-			_array[up ? end: start] = yanked_line;
+			_lines[up ? end: start] = yanked_line;
 
-			_mark_lines_as_dirty(start, end);
+			_record_scroll(start, end, up ? 1 : -1);
 		}
 
 	public:
@@ -79,46 +148,56 @@ class Cell_array
 			_num_lines(num_lines),
 			_alloc(alloc)
 		{
-			_array = new (alloc) Char_cell_line[num_lines];
-
-			_line_dirty = new (alloc) bool[num_lines];
-			for (unsigned i = 0; i < num_lines; i++)
-				_line_dirty[i] = false;
+			_lines = new (alloc) Line[num_lines];
 
-			for (unsigned i = 0; i < num_lines; i++)
-				_array[i] = new (alloc) CELL[num_cols];
+			for (unsigned i = 0; i < num_lines; i++) {
+				_lines[i].cells = new (alloc) CELL[num_cols];
+				_mark_as_clean(_lines[i]);
+			}
 		}
 
 		~Cell_array()
 		{
 			for (unsigned i = 0; i < _num_lines; i++)
-				Genode::destroy(_alloc, _array[i]);
+				Genode::destroy(_alloc, _lines[i].cells);
 
-			Genode::destroy(_alloc, _line_dirty);
-			Genode::destroy(_alloc, _array);
+			Genode::destroy(_alloc, _lines);
 		}
 
 		void set_cell(int column, int line, CELL cell)
 		{
-			_array[line][column] = cell;
-			_line_dirty[line] = true;
+			_lines[line].cells[column] = cell;
+			_mark_as_dirty(_lines[line], column, column);
 		}
 
 		CELL get_cell(int column, int line)
 		{
-			return _array[line][column];
+			return _lines[line].cells[column];
 		}
 
-		bool line_dirty(int line) { return _line_dirty[line]; }
+		bool line_dirty(int line)
+		{
+			return _lines[line].first_dirty <= _lines[line].last_dirty;
+		}
+
+		/**
+		 * Return first dirty column of a dirty line
+		 */
+		unsigned first_dirty_col(int line) { return _lines[line].first_dirty; }
+
+		/**
+		 * Return last dirty column of a dirty line
+		 */
+		unsigned last_dirty_col(int line) { return _lines[line].last_dirty; }
 
 		void mark_line_as_clean(int line)
 		{
-			_line_dirty[line] = false;
+			_mark_as_clean(_lines[line]);
 		}
 
 		void mark_line_as_dirty(int line)
 		{
-			_line_dirty[line] = true;
+			_mark_as_dirty(_lines[line], 0, _num_cols - 1);
 		}
 
 		void scroll_up(int region_start, int region_end)
@@ -131,29 +210,58 @@ class Cell_array
 			_scroll_vertically(region_start, region_end, false);
 		}
 
+		/**
+		 * Return scroll operations since the last call of
+		 * 'mark_scroll_as_done' or 'mark_scroll_as_dirty'
+		 */
+		Scroll scroll() const { return _scroll; }
+
+		/**
+		 * Acknowledge that the consumer moved the lines of the scroll region
+		 */
+		void mark_scroll_as_done() { _scroll = Scroll { 0, 0, 0 }; }
+
+		/**
+		 * Mark all lines of the scroll region as dirty
+		 *
+		 * This method is meant for consumers that are unable to move lines.
+		 */
+		void mark_scroll_as_dirty()
+		{
+			if (_scroll.pending())
+				_mark_lines_as_dirty(_scroll.start, _scroll.end);
+
+			mark_scroll_as_done();
+		}
+
 		void clear(int region_start, int region_end)
 		{
 			for (int line = region_start; line <= region_end; line++)
-				_clear_line(_array[line]);
+				_clear_line(_lines[line]);
 
 			_mark_lines_as_dirty(region_start, region_end);
 		}
 
-		void cursor(Terminal::Position pos, bool enable, bool mark_dirty = false)
+		/**
+		 * Show or hide cursor at the given position
+		 *
+		 * The cell is marked as dirty because the cursor is drawn as part of
+		 * the cell.
+		 */
+		void cursor(Terminal::Position pos, bool enable)
 		{
 			if (((unsigned)pos.x >= _num_cols) ||
 			    ((unsigned)pos.y >= _num_lines))
 				return;
 
-			CELL &cell = _array[pos.y][pos.x];
+			CELL &cell = _lines[pos.y].cells[pos.x];
 
 			if (enable)
 				cell.set_cursor();
 			else
 				cell.clear_cursor();
 
-			if (mark_dirty)
-				_line_dirty[pos.y] = true;
+			_mark_as_dirty(_lines[pos.y], pos.x, pos.x);
 		}
 
 		unsigned num_cols()  { return _num_cols; }
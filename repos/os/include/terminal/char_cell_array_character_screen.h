@@ -107,8 +107,8 @@ class Char_cell_array_character_screen : public Terminal::Character_screen
 				Terminal::Position &new_cursor_pos = cs._cursor_pos;
 				if (old_cursor_pos != new_cursor_pos) {
 
-					cs._char_cell_array.cursor(old_cursor_pos, false, true);
-					cs._char_cell_array.cursor(new_cursor_pos, true,  true);
+					cs._char_cell_array.cursor(old_cursor_pos, false);
+					cs._char_cell_array.cursor(new_cursor_pos, true);
 				}
 			}
 		};
@@ -119,6 +119,7 @@ Init::Child::apply_config(Xml_node start_node)
 		_binary_name = _binary_from_xml(start_node, _unique_name);
 
 		/* import new start node */
+		_route_table.destruct();
 		_start_node.construct(_alloc, start_node);
 	}
 
@@ -433,95 +434,111 @@ Init::Child::Route Init::Child::resolve_session_request(Service::Name const &ser
 	 && label.last_element() == Session_requester::rom_name())
 		return Route { _session_requester.service() };
 
-	try {
-		Xml_node route_node = _default_route_accessor.default_route();
-		try {
-			route_node = _start_node->xml().sub_node("route"); }
-		catch (...) { }
-		Xml_node service_node = route_node.sub_node();
+	Route_table const *routes = nullptr;
+	try { routes = &_routes(); }
+	catch (Out_of_ram)  { warning(name(), ": out of RAM while routing"); }
+	catch (Out_of_caps) { warning(name(), ": out of caps while routing"); }
+	if (!routes)
+		throw Service_denied();
 
-		for (; ; service_node = service_node.next()) {
+	for (Route_table::Rule const *rule = routes->first(); rule; rule = rule->next()) {
 
-			bool service_wildcard = service_node.has_type("any-service");
+		if (!rule->may_match(service_name) ||
+		    !service_node_matches(rule->node, label, name(), service_name))
+			continue;
 
-			if (!service_node_matches(service_node, label, name(), service_name))
-				continue;
+		/* a rule without targets terminates the lookup */
+		if (!rule->targets.first())
+			break;
 
-			Xml_node target = service_node.sub_node();
-			for (; ; target = target.next()) {
+		bool const service_wildcard = rule->any_service;
 
-				/*
-				 * Determine session label to be provided to the server
-				 *
-				 * By default, the client's identity (accompanied with the a
-				 * client-provided label) is presented as session label to the
-				 * server. However, the target node can explicitly override the
-				 * client's identity by a custom label via the 'label'
-				 * attribute.
-				 */
-				typedef String<Session_label::capacity()> Label;
-				Label const target_label =
-					target.attribute_value("label", Label(label.string()));
+		for (Route_table::Target const *target = rule->targets.first();
+		     target; target = target->next()) {
 
-				Session::Diag const
-					target_diag { target.attribute_value("diag", false) };
+			/*
+			 * Determine session label to be provided to the server
+			 *
+			 * By default, the client's identity (accompanied with the a
+			 * client-provided label) is presented as session label to the
+			 * server. However, the target node can explicitly override the
+			 * client's identity by a custom label via the 'label'
+			 * attribute.
+			 */
+			typedef String<Session_label::capacity()> Label;
+			Label const target_label =
+				target->node.attribute_value("label", Label(label.string()));
 
-				auto no_filter = [] (Service &) -> bool { return false; };
+			Session::Diag const
+				target_diag { target->node.attribute_value("diag", false) };
 
-				if (target.has_type("parent")) {
+			auto no_filter = [] (Service &) -> bool { return false; };
 
-					try {
-						return Route { find_service(_parent_services, service_name, no_filter),
-						               target_label, target_diag };
-					} catch (Service_denied) { }
-				}
+			if (target->type == Route_table::Target::PARENT) {
 
-				if (target.has_type("child")) {
-
-					typedef Name_registry::Name Name;
-					Name server_name = target.attribute_value("name", Name());
-					server_name = _name_registry.deref_alias(server_name);
+				try {
+					return Route { find_service(_parent_services, service_name, no_filter),
+					               target_label, target_diag };
+				} catch (Service_denied) { }
+			}
 
-					auto filter_server_name = [&] (Routed_service &s) -> bool {
-						return s.child_name() != server_name; };
+			if (target->type == Route_table::Target::CHILD) {
 
-					try {
-						return Route { find_service(_child_services, service_name, filter_server_name),
-						               target_label, target_diag };
+				Name_registry::Name const server_name =
+					_name_registry.deref_alias(target->server);
 
-					} catch (Service_denied) { }
-				}
+				auto filter_server_name = [&] (Routed_service &s) -> bool {
+					return s.child_name() != server_name; };
 
-				if (target.has_type("any-child")) {
+				try {
+					return Route { find_service(_child_services, service_name, filter_server_name),
+					               target_label, target_diag };
 
-					if (is_ambiguous(_child_services, service_name)) {
-						error(name(), ": ambiguous routes to "
-						      "service \"", service_name, "\"");
-						throw Service_denied();
-					}
-					try {
-						return Route { find_service(_child_services, service_name, no_filter),
-						               target_label, target_diag };
+				} catch (Service_denied) { }
+			}
 
-					} catch (Service_denied) { }
-				}
+			if (target->type == Route_table::Target::ANY_CHILD) {
 
-				if (!service_wildcard) {
-					warning(name(), ": lookup for service \"", service_name, "\" failed");
+				if (is_ambiguous(_child_services, service_name)) {
+					error(name(), ": ambiguous routes to "
+					      "service \"", service_name, "\"");
 					throw Service_denied();
 				}
+				try {
+					return Route { find_service(_child_services, service_name, no_filter),
+					               target_label, target_diag };
 
-				if (target.last())
-					break;
+				} catch (Service_denied) { }
+			}
+
+			if (!service_wildcard) {
+				warning(name(), ": lookup for service \"", service_name, "\" failed");
+				throw Service_denied();
 			}
 		}
-	} catch (Xml_node::Nonexistent_sub_node) { }
+	}
 
 	warning(name(), ": no route to service \"", service_name, "\"");
 	throw Service_denied();
 }
 
 
+Init::Route_table const &Init::Child::_routes()
+{
+	if (_route_table.constructed())
+		return *_route_table;
+
+	Xml_node const start_node = _start_node->xml();
+
+	_route_table_from_default_route = !start_node.has_sub_node("route");
+
+	_route_table.construct(_alloc, _route_table_from_default_route
+	                               ? _default_route_accessor.default_route()
+	                               : start_node.sub_node("route"));
+	return *_route_table;
+}
+
+
 void Init::Child::filter_session_args(Service::Name const &service,
                                       char *args, size_t args_len)
 {
@@ -648,7 +665,7 @@ Init::Child::Child(Env                      &env,
 :
 	_env(env), _alloc(alloc), _verbose(verbose), _id(id),
 	_report_update_trigger(report_update_trigger),
-	_list_element(this),
+	_list_element(this), _hash_element(this),
 	_start_node(_alloc, start_node),
 	_default_route_accessor(default_route_accessor),
 	_ram_limit_accessor(ram_limit_accessor),
@@ -28,6 +28,7 @@
 #include <name_registry.h>
 #include <service.h>
 #include <utils.h>
+#include <route_table.h>
 
 namespace Init { class Child; }
 
@@ -72,6 +73,13 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 		Report_update_trigger &_report_update_trigger;
 
 		List_element<Child> _list_element;
+		List_element<Child> _hash_element;
+
+		/*
+		 * Set while checking the configuration for start nodes that
+		 * vanished
+		 */
+		bool _configured = true;
 
 		Reconstructible<Buffered_xml> _start_node;
 
@@ -87,6 +95,16 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 
 		Name_registry &_name_registry;
 
+		/*
+		 * Routing rules of the child, created on demand from either the
+		 * '<route>' node of the start node or the default route
+		 */
+		Constructible<Route_table> _route_table;
+
+		bool _route_table_from_default_route = false;
+
+		Route_table const &_routes();
+
 		/**
 		 * Read name from XML and check for name confict with other children
 		 *
@@ -495,6 +513,34 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 
 		bool abandoned() const { return _state == STATE_ABANDONED; }
 
+		void configured(bool configured) { _configured = configured; }
+		bool configured() const          { return _configured; }
+
+		/**
+		 * Return true if applying 'start_node' would leave the child as is
+		 *
+		 * This is the case if the start node is unchanged and the child's
+		 * environment is complete. The caller must make sure that no other
+		 * change of the configuration may affect the routing of the child's
+		 * sessions.
+		 */
+		bool config_unchanged(Xml_node start_node) const
+		{
+			return _child.active()
+			    && start_node.size() == _start_node->xml().size()
+			    && !Genode::memcmp(start_node.addr(), _start_node->xml().addr(),
+			                       start_node.size());
+		}
+
+		/**
+		 * Discard routing rules that refer to the former default route
+		 */
+		void default_route_changed()
+		{
+			if (_route_table_from_default_route)
+				_route_table.destruct();
+		}
+
 		enum Apply_config_result { MAY_HAVE_SIDE_EFFECTS, NO_SIDE_EFFECTS };
 
 		/**
@@ -29,13 +29,29 @@ class Init::Child_registry : public Name_registry, Child_list
 
 		List<Alias> _aliases;
 
+		/*
+		 * Children hashed by name, which avoids scanning all children when
+		 * looking up the child of a start node
+		 */
+		enum { NUM_BUCKETS = 256 };
+
+		Child_list _buckets[NUM_BUCKETS];
+
+		static unsigned _bucket(Child_policy::Name const &name)
+		{
+			/* FNV-1a */
+			unsigned hash = 2166136261u;
+			for (char const *s = name.string(); *s; s++)
+				hash = (hash ^ (unsigned char)*s) * 16777619u;
+
+			return hash % NUM_BUCKETS;
+		}
+
 		bool _unique(const char *name) const
 		{
 			/* check for name clash with an existing child */
-			Genode::List_element<Init::Child> const *curr = first();
-			for (; curr; curr = curr->next())
-				if (curr->object()->has_name(name))
-					return false;
+			if (find(Child_policy::Name(name)))
+				return false;
 
 			/* check for name clash with an existing alias */
 			for (Alias const *a = _aliases.first(); a; a = a->next()) {
@@ -59,6 +75,7 @@ class Init::Child_registry : public Name_registry, Child_list
 		void insert(Child *child)
 		{
 			Child_list::insert(&child->_list_element);
+			_buckets[_bucket(child->name())].insert(&child->_hash_element);
 		}
 
 		/**
@@ -67,6 +84,22 @@ class Init::Child_registry : public Name_registry, Child_list
 		void remove(Child *child)
 		{
 			Child_list::remove(&child->_list_element);
+			_buckets[_bucket(child->name())].remove(&child->_hash_element);
+		}
+
+		/**
+		 * Return child with the specified name, or nullptr if no such child
+		 * exists
+		 */
+		Child *find(Child_policy::Name const &name) const
+		{
+			Child_list const &bucket = _buckets[_bucket(name)];
+
+			for (List_element<Child> const *e = bucket.first(); e; e = e->next())
+				if (e->object()->has_name(name))
+					return e->object();
+
+			return nullptr;
 		}
 
 		/**
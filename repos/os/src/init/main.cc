@@ -14,6 +14,7 @@
 /* Genode includes */
 #include <base/component.h>
 #include <base/attached_rom_dataspace.h>
+#include <util/xml_index.h>
 
 /* local includes */
 #include <child_registry.h>
@@ -38,6 +39,12 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 
 	Attached_rom_dataspace _config { _env, "config" };
 
+	/*
+	 * Index of the config ROM, which makes the repeated traversal of
+	 * configurations with many start nodes cheap
+	 */
+	Constructible<Xml_index> _config_index;
+
 	Xml_node _config_xml = _config.xml();
 
 	Reconstructible<Verbose> _verbose { _config_xml };
@@ -138,10 +145,11 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 	Signal_handler<Main> _resource_avail_handler {
 		_env.ep(), *this, &Main::_handle_resource_avail };
 
-	void _update_aliases_from_config();
-	void _update_parent_services_from_config();
-	void _abandon_obsolete_children();
-	void _update_children_config();
+	bool _update_default_route_from_config();
+	bool _update_aliases_from_config();
+	bool _update_parent_services_from_config();
+	bool _abandon_obsolete_children();
+	void _update_children_config(bool);
 	void _destroy_abandoned_parent_services();
 	void _handle_config();
 
@@ -162,8 +170,15 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 };
 
 
-void Init::Main::_update_parent_services_from_config()
+/**
+ * Update parent services
+ *
+ * \return true if services vanished or appeared
+ */
+bool Init::Main::_update_parent_services_from_config()
 {
+	bool changed = false;
+
 	Xml_node const node = _config_xml.has_sub_node("parent-provides")
 	                    ? _config_xml.sub_node("parent-provides")
 	                    : Xml_node("<empty/>");
@@ -178,8 +193,10 @@ void Init::Main::_update_parent_services_from_config()
 			if (name == service.attribute_value("name", Service::Name())) {
 				obsolete = false; }});
 
-		if (obsolete)
+		if (obsolete) {
 			service.abandon();
+			changed = true;
+		}
 	});
 
 	if (_verbose->enabled())
@@ -197,10 +214,12 @@ void Init::Main::_update_parent_services_from_config()
 
 		if (!registered) {
 			new (_heap) Init::Parent_service(_parent_services, _env, name);
+			changed = true;
 			if (_verbose->enabled())
 				log("  service \"", name, "\"");
 		}
 	});
+	return changed;
 }
 
 
@@ -212,8 +231,32 @@ void Init::Main::_destroy_abandoned_parent_services()
 }
 
 
-void Init::Main::_update_aliases_from_config()
+/**
+ * Update aliases
+ *
+ * \return true if the set of aliases changed
+ */
+bool Init::Main::_update_aliases_from_config()
 {
+	/* determine whether the aliases differ from the known ones */
+	unsigned num_aliases = 0, num_known = 0;
+	_config_xml.for_each_sub_node("alias", [&] (Xml_node alias_node) {
+		num_aliases++;
+		for (Alias const *a = _children.any_alias(); a; a = a->next())
+			if (a->name  == alias_node.attribute_value("name",  Alias::Name()) &&
+			    a->child == alias_node.attribute_value("child", Alias::Child())) {
+				num_known++;
+				break;
+			}
+	});
+
+	unsigned num_old_aliases = 0;
+	for (Alias const *a = _children.any_alias(); a; a = a->next())
+		num_old_aliases++;
+
+	bool const changed = num_aliases != num_known
+	                  || num_aliases != num_old_aliases;
+
 	/* remove all known aliases */
 	while (_children.any_alias()) {
 		Init::Alias *alias = _children.any_alias();
@@ -231,27 +274,45 @@ void Init::Main::_update_aliases_from_config()
 		catch (Alias::Child_is_missing) {
 			warning("missing 'child' attribute in '<alias>' entry"); }
 	});
+	return changed;
 }
 
 
-void Init::Main::_abandon_obsolete_children()
+/**
+ * Abandon children whose start node vanished from the config
+ *
+ * \return true if any child was abandoned
+ */
+bool Init::Main::_abandon_obsolete_children()
 {
-	_children.for_each_child([&] (Child &child) {
+	_children.for_each_child([&] (Child &child) { child.configured(false); });
 
-		Child_policy::Name const name = child.name();
+	_config_xml.for_each_sub_node("start", [&] (Xml_node node) {
+		Child *child = _children.find(node.attribute_value("name", Child_policy::Name()));
+		if (child)
+			child->configured(true); });
 
-		bool obsolete = true;
-		_config_xml.for_each_sub_node("start", [&] (Xml_node node) {
-			if (node.attribute_value("name", Child_policy::Name()) == name)
-				obsolete = false; });
-
-		if (obsolete)
+	bool abandoned = false;
+	_children.for_each_child([&] (Child &child) {
+		if (!child.configured()) {
 			child.abandon();
+			abandoned = true;
+		}
 	});
+	return abandoned;
 }
 
 
-void Init::Main::_update_children_config()
+/**
+ * Apply start nodes to the existing children
+ *
+ * \param routing_changed  true if the update may affect the routing of
+ *                         sessions of unchanged children
+ *
+ * Unless the routing changed, only the children with a changed start node
+ * are considered.
+ */
+void Init::Main::_update_children_config(bool routing_changed)
 {
 	for (;;) {
 
@@ -265,38 +326,72 @@ void Init::Main::_update_children_config()
 
 		_config_xml.for_each_sub_node("start", [&] (Xml_node node) {
 
-			Child_policy::Name const start_node_name =
-				node.attribute_value("name", Child_policy::Name());
-
-			_children.for_each_child([&] (Child &child) {
-				if (child.name() == start_node_name) {
-					switch (child.apply_config(node)) {
-					case Child::NO_SIDE_EFFECTS: break;
-					case Child::MAY_HAVE_SIDE_EFFECTS: side_effects = true; break;
-					};
-				}
-			});
+			Child *child = _children.find(node.attribute_value("name", Child_policy::Name()));
+			if (!child)
+				return;
+
+			if (!routing_changed && child->config_unchanged(node))
+				return;
+
+			switch (child->apply_config(node)) {
+			case Child::NO_SIDE_EFFECTS: break;
+			case Child::MAY_HAVE_SIDE_EFFECTS: side_effects = true; break;
+			};
 		});
 
 		if (!side_effects)
 			break;
+
+		/* side effects may affect the routes of any child */
+		routing_changed = true;
 	}
 }
 
 
+/**
+ * Update default route
+ *
+ * \return true if the default route changed
+ */
+bool Init::Main::_update_default_route_from_config()
+{
+	if (!_config_xml.has_sub_node("default-route"))
+		return false;
+
+	Xml_node const node = _config_xml.sub_node("default-route");
+
+	if (_default_route.constructed()
+	 && node.size() == _default_route->xml().size()
+	 && !memcmp(node.addr(), _default_route->xml().addr(), node.size()))
+		return false;
+
+	_default_route.construct(_heap, node);
+
+	/* the routing rules of the children refer to the former default route */
+	_children.for_each_child([&] (Child &child) { child.default_route_changed(); });
+	return true;
+}
+
+
 void Init::Main::_handle_config()
 {
 	_config.update();
 
+	_config_index.destruct();
 	_config_xml = _config.xml();
+	try {
+		_config_index.construct(_heap, _config_xml);
+		_config_xml = _config_index->xml();
+	}
+	catch (Xml_node::Invalid_syntax) { }
+	catch (Out_of_ram)  { warning("out of RAM while indexing config"); }
+	catch (Out_of_caps) { warning("out of caps while indexing config"); }
 
 	_verbose.construct(_config_xml);
 	_state_reporter.apply_config(_config_xml);
 
 	/* determine default route for resolving service requests */
-	try {
-		_default_route.construct(_heap, _config_xml.sub_node("default-route")); }
-	catch (...) { }
+	bool routing_changed = _update_default_route_from_config();
 
 	_default_caps = Cap_quota { 0 };
 	try {
@@ -307,10 +402,10 @@ void Init::Main::_handle_config()
 	Prio_levels     const prio_levels    = prio_levels_from_xml(_config_xml);
 	Affinity::Space const affinity_space = affinity_space_from_xml(_config_xml);
 
-	_update_aliases_from_config();
-	_update_parent_services_from_config();
-	_abandon_obsolete_children();
-	_update_children_config();
+	routing_changed |= _update_aliases_from_config();
+	routing_changed |= _update_parent_services_from_config();
+	routing_changed |= _abandon_obsolete_children();
+	_update_children_config(routing_changed);
 
 	/* kill abandoned children */
 	_children.for_each_child([&] (Child &child) {
@@ -335,13 +430,8 @@ void Init::Main::_handle_config()
 		_config_xml.for_each_sub_node("start", [&] (Xml_node start_node) {
 
 			/* skip start node if corresponding child already exists */
-			bool exists = false;
-			_children.for_each_child([&] (Child const &child) {
-				if (child.name() == start_node.attribute_value("name", Child_policy::Name()))
-					exists = true; });
-			if (exists) {
+			if (_children.find(start_node.attribute_value("name", Child_policy::Name())))
 				return;
-			}
 
 			if (used_ram.value > avail_ram.value) {
 				error("RAM exhausted while starting childen");
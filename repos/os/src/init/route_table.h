@@ -0,0 +1,153 @@
+/*
+ * \brief  Pre-processed routing policy of a child
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SRC__INIT__ROUTE_TABLE_H_
+#define _SRC__INIT__ROUTE_TABLE_H_
+
+/* Genode includes */
+#include <util/noncopyable.h>
+#include <util/xml_node.h>
+#include <base/allocator.h>
+
+/* local includes */
+#include <types.h>
+#include <name_registry.h>
+
+namespace Init { class Route_table; }
+
+
+/**
+ * Routing rules of a '<route>' or '<default-route>' node
+ *
+ * Resolving a session request used to walk the route node for each request,
+ * re-parsing the XML of all preceding rules. The route table captures the
+ * type and service name of each rule and the type and server of each
+ * target once. The XML nodes of the rules are retained for the evaluation
+ * of label-dependent policies. Hence, the table must not outlive the XML
+ * data it was created from.
+ */
+class Init::Route_table : Noncopyable
+{
+	public:
+
+		struct Target : List<Target>::Element
+		{
+			enum Type { PARENT, CHILD, ANY_CHILD, UNKNOWN };
+
+			Xml_node            const node;
+			Type                const type;
+			Name_registry::Name const server;
+
+			static Type _type(Xml_node node)
+			{
+				if (node.has_type("parent"))    return PARENT;
+				if (node.has_type("child"))     return CHILD;
+				if (node.has_type("any-child")) return ANY_CHILD;
+				return UNKNOWN;
+			}
+
+			Target(Xml_node node)
+			:
+				node(node), type(_type(node)),
+				server(node.attribute_value("name", Name_registry::Name()))
+			{ }
+		};
+
+		struct Rule : List<Rule>::Element
+		{
+			Xml_node      const node;
+			bool          const any_service;
+			Service::Name const service;
+
+			List<Target> targets { };
+
+			Rule(Xml_node node)
+			:
+				node(node), any_service(node.has_type("any-service")),
+				service(node.has_type("service")
+				        ? node.attribute_value("name", Service::Name())
+				        : Service::Name())
+			{ }
+
+			/**
+			 * Return true if rule may apply to requests of the service
+			 *
+			 * The label-dependent part of the rule must be checked by the
+			 * caller via 'service_node_matches'.
+			 */
+			bool may_match(Service::Name const &name) const {
+				return any_service || (service.valid() && service == name); }
+		};
+
+	private:
+
+		Allocator &_alloc;
+
+		List<Rule> _rules { };
+
+		template <typename T>
+		static void _destroy_all(Allocator &alloc, List<T> &list)
+		{
+			while (T *t = list.first()) {
+				list.remove(t);
+				destroy(alloc, t);
+			}
+		}
+
+		void _destroy()
+		{
+			while (Rule *rule = _rules.first()) {
+				_destroy_all(_alloc, rule->targets);
+				_rules.remove(rule);
+				destroy(_alloc, rule);
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Route_table(Allocator &alloc, Xml_node route) : _alloc(alloc)
+		{
+			try {
+				Rule *last_rule = nullptr;
+				route.for_each_sub_node([&] (Xml_node service_node) {
+
+					Rule *rule = new (_alloc) Rule(service_node);
+					_rules.insert(rule, last_rule);
+					last_rule = rule;
+
+					Target *last_target = nullptr;
+					service_node.for_each_sub_node([&] (Xml_node target_node) {
+						Target *target = new (_alloc) Target(target_node);
+						rule->targets.insert(target, last_target);
+						last_target = target;
+					});
+				});
+			}
+			catch (...) { _destroy(); throw; }
+		}
+
+		~Route_table() { _destroy(); }
+
+		/**
+		 * Return first rule in the order of the route node
+		 */
+		Rule const *first() const { return _rules.first(); }
+};
+
+#endif /* _SRC__INIT__ROUTE_TABLE_H_ */
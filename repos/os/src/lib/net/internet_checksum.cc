@@ -0,0 +1,96 @@
+/*
+ * \brief  Computation of the Internet checksum (RFC 1071)
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <util/endian.h>
+#include <net/internet_checksum.h>
+
+using namespace Genode;
+using namespace Net;
+
+
+/*
+ * Packet headers are only guaranteed to be 16-bit aligned, e.g., an IPv4
+ * packet that follows a 14-byte Ethernet header. Tell the compiler not to
+ * assume a stricter alignment for the wide accesses.
+ */
+typedef uint32_t __attribute__((aligned(2), may_alias)) Unaligned_uint32;
+typedef uint16_t __attribute__((may_alias))             Aliased_uint16;
+
+
+/**
+ * Sum up data in native byte order
+ *
+ * Each 32-bit word is added to a 64-bit accumulator, which cannot overflow
+ * for any packet size. Four words are processed per iteration to make use of
+ * the instruction-level parallelism of the CPU.
+ */
+static uint64_t native_sum(void const *data, size_t size)
+{
+	uint64_t sum = 0;
+
+	Unaligned_uint32 const *words = (Unaligned_uint32 const *)data;
+	for (; size >= 16; size -= 16, words += 4)
+		sum += (uint64_t)words[0] + words[1] + words[2] + words[3];
+
+	for (; size >= 4; size -= 4, words++)
+		sum += words[0];
+
+	Aliased_uint16 const *half_words = (Aliased_uint16 const *)words;
+	if (size >= 2) {
+		sum += *half_words++;
+		size -= 2;
+	}
+
+	/* if size is odd, append a zero byte */
+	if (size) {
+		uint8_t const last[] = { *(uint8_t const *)half_words, 0 };
+		sum += *(Aliased_uint16 const *)last;
+	}
+	return sum;
+}
+
+
+static uint16_t fold(uint64_t sum)
+{
+	/* keep the last 16 bits of the sum and add the carries */
+	while (sum >> 16)
+		sum = (sum & 0xffff) + (sum >> 16);
+
+	return (uint16_t)sum;
+}
+
+
+uint16_t Net::internet_checksum(void const *data, size_t size, uint32_t sum)
+{
+	/*
+	 * Swapping the bytes of the folded native sum yields the sum in
+	 * network byte order.
+	 */
+	uint32_t const data_sum = host_to_big_endian(fold(native_sum(data, size)));
+
+	return (uint16_t)~fold((uint64_t)data_sum + sum);
+}
+
+
+uint32_t Net::internet_checksum_pseudo_ip(Ipv4_address const &src,
+                                          Ipv4_address const &dst,
+                                          uint8_t      const  protocol,
+                                          size_t       const  length)
+{
+	uint32_t sum = 0;
+	for (unsigned i = 0; i < Ipv4_packet::ADDR_LEN; i += 2) {
+		sum += src.addr[i] << 8 | src.addr[i + 1];
+		sum += dst.addr[i] << 8 | dst.addr[i + 1];
+	}
+	return sum + protocol + (uint32_t)length;
+}
@@ -17,6 +17,7 @@
 #include <net/udp.h>
 #include <net/tcp.h>
 #include <net/ipv4.h>
+#include <net/internet_checksum.h>
 
 using namespace Genode;
 using namespace Net;
@@ -133,17 +134,10 @@ Ipv4_address Ipv4_packet::ip_from_string(const char *ip)
 
 Genode::uint16_t Ipv4_packet::calculate_checksum(Ipv4_packet const &packet)
 {
-	Genode::uint16_t const *data = (Genode::uint16_t *)&packet;
-	Genode::uint32_t const sum = host_to_big_endian(data[0])
-	                           + host_to_big_endian(data[1])
-	                           + host_to_big_endian(data[2])
-	                           + host_to_big_endian(data[3])
-	                           + host_to_big_endian(data[4])
-	                           + host_to_big_endian(data[6])
-	                           + host_to_big_endian(data[7])
-	                           + host_to_big_endian(data[8])
-	                           + host_to_big_endian(data[9]);
-	return ~((0xFFFF & sum) + (sum >> 16));
+	/* sum up the header except for the checksum field */
+	Genode::uint8_t const *data = (Genode::uint8_t const *)&packet;
+	Genode::uint16_t const tail_sum = ~internet_checksum(data + 12, 8);
+	return internet_checksum(data, 10, tail_sum);
 }
 
 
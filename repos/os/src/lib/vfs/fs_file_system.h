@@ -55,17 +55,57 @@ class Vfs::Fs_file_system : public File_system
 
 		Handle_space _handle_space;
 
+		/*
+		 * Parameters of the read pipeline
+		 *
+		 * Data read ahead stays in the bulk buffer until consumed. Limiting
+		 * the amount of such data ensures that writes and reads on other
+		 * handles always find room in the buffer.
+		 */
+		struct Read_ahead
+		{
+			unsigned  depth; /* reads in flight per handle */
+			file_size avail; /* bulk-buffer space left for reading ahead */
+		};
+
 		struct Handle_state
 		{
 			enum class Read_ready_state { IDLE, PENDING, READY };
 			Read_ready_state read_ready_state = Read_ready_state::IDLE;
 
 			enum class Queued_state { IDLE, QUEUED, ACK };
-			Queued_state queued_read_state = Queued_state::IDLE;
 			Queued_state queued_sync_state = Queued_state::IDLE;
 
-			::File_system::Packet_descriptor queued_read_packet;
 			::File_system::Packet_descriptor queued_sync_packet;
+
+			/*
+			 * Read requests in flight
+			 *
+			 * Sequential reads are pipelined by requesting the subsequent
+			 * chunks ahead of time, one slot per request. A 'DISCARDED'
+			 * slot belongs to a request that is no longer of interest but
+			 * still awaits its acknowledgement.
+			 */
+			enum { MAX_READ_SLOTS = 8 };
+
+			struct Read_slot
+			{
+				enum class State { IDLE, QUEUED, ACK, DISCARDED };
+
+				State state = State::IDLE;
+
+				/* request was issued ahead of time and charged to the budget */
+				bool ahead = false;
+
+				::File_system::Packet_descriptor packet { };
+
+				bool pending() const {
+					return state == State::QUEUED || state == State::ACK; }
+
+				file_size position() const { return packet.position(); }
+			};
+
+			Read_slot read_slots[MAX_READ_SLOTS];
 		};
 
 		struct Fs_vfs_handle : Vfs_handle, ::File_system::Node,
@@ -73,23 +113,66 @@ class Vfs::Fs_file_system : public File_system
 		{
 			::File_system::Connection &_fs;
 			Io_response_handler       &_io_handler;
+			Read_ahead                &_read_ahead;
+
+			typedef Handle_state::Read_slot Read_slot;
+			typedef Read_slot::State        Slot_state;
 
-			bool _queue_read(file_size count, file_size const seek_offset)
+			Read_slot *_pending_read_at(file_size position)
 			{
-				if (queued_read_state != Handle_state::Queued_state::IDLE)
-					return false;
+				for (Read_slot &slot : read_slots)
+					if (slot.pending() && slot.position() == position)
+						return &slot;
+
+				return nullptr;
+			}
+
+			Read_slot *_free_read_slot()
+			{
+				for (Read_slot &slot : read_slots)
+					if (slot.state == Slot_state::IDLE)
+						return &slot;
+
+				return nullptr;
+			}
+
+			unsigned _num_pending_reads() const
+			{
+				unsigned n = 0;
+				for (Read_slot const &slot : read_slots)
+					if (slot.pending())
+						n++;
+
+				return n;
+			}
+
+			void _release_read_slot(Read_slot &slot, bool release)
+			{
+				if (release)
+					_fs.tx()->release_packet(slot.packet);
 
+				if (slot.ahead)
+					_read_ahead.avail += slot.packet.size();
+
+				slot = Read_slot();
+			}
+
+			bool _submit_read(file_size count, file_size const seek_offset,
+			                  bool ahead)
+			{
 				::File_system::Session::Tx::Source &source = *_fs.tx();
 
+				Read_slot * const slot = _free_read_slot();
+
 				/* if not ready to submit suggest retry */
-				if (!source.ready_to_submit()) return false;
+				if (!slot || !source.ready_to_submit()) return false;
 
-				file_size const max_packet_size = source.bulk_buffer_size() / 2;
-				file_size const clipped_count = min(max_packet_size, count);
+				if (ahead && _read_ahead.avail < count)
+					return false;
 
 				::File_system::Packet_descriptor p;
 				try {
-					p = source.alloc_packet(clipped_count);
+					p = source.alloc_packet(count);
 				} catch (::File_system::Session::Tx::Source::Packet_alloc_failed) {
 					return false;
 				}
@@ -97,10 +180,14 @@ class Vfs::Fs_file_system : public File_system
 				::File_system::Packet_descriptor const
 					packet(p, file_handle(),
 					       ::File_system::Packet_descriptor::READ,
-					       clipped_count, seek_offset);
+					       count, seek_offset);
+
+				slot->state  = Slot_state::QUEUED;
+				slot->ahead  = ahead;
+				slot->packet = packet;
 
-				read_ready_state  = Handle_state::Read_ready_state::IDLE;
-				queued_read_state = Handle_state::Queued_state::QUEUED;
+				if (ahead)
+					_read_ahead.avail -= count;
 
 				/* pass packet to server side */
 				source.submit_packet(packet);
@@ -108,15 +195,117 @@ class Vfs::Fs_file_system : public File_system
 				return true;
 			}
 
+			/**
+			 * Drop all outstanding reads, e.g., after a seek or a write
+			 */
+			void discard_reads()
+			{
+				for (Read_slot &slot : read_slots) {
+
+					if (slot.state == Slot_state::ACK)
+						_release_read_slot(slot, true);
+
+					if (slot.state != Slot_state::QUEUED)
+						continue;
+
+					/* return budget now, release the packet once acked */
+					if (slot.ahead)
+						_read_ahead.avail += slot.packet.size();
+
+					slot.ahead = false;
+					slot.state = Slot_state::DISCARDED;
+				}
+			}
+
+			/**
+			 * Called on the acknowledgement of a read packet
+			 *
+			 * \return true if the packet is still of interest
+			 */
+			bool read_acked(::File_system::Packet_descriptor const &packet)
+			{
+				for (Read_slot &slot : read_slots) {
+
+					if (slot.state != Slot_state::QUEUED
+					 && slot.state != Slot_state::DISCARDED)
+						continue;
+
+					/* the offset within the bulk buffer tags the request */
+					if (slot.packet.offset() != packet.offset())
+						continue;
+
+					if (slot.state == Slot_state::DISCARDED) {
+						slot = Read_slot();
+						return false;
+					}
+
+					slot.packet = packet;
+					slot.state  = Slot_state::ACK;
+					return true;
+				}
+				return false;
+			}
+
+			/**
+			 * Queue read at 'seek_offset' and the subsequent chunks
+			 *
+			 * \param depth  maximum number of reads in flight, including
+			 *               the requested one
+			 */
+			bool _queue_read(file_size count, file_size const seek_offset,
+			                 unsigned depth = 1)
+			{
+				::File_system::Session::Tx::Source &source = *_fs.tx();
+
+				file_size const max_packet_size = source.bulk_buffer_size() / 2;
+				file_size const clipped_count = min(max_packet_size, count);
+
+				if (!_pending_read_at(seek_offset)) {
+
+					/* the pipelined reads do not match the access pattern */
+					discard_reads();
+
+					if (!_submit_read(clipped_count, seek_offset, false))
+						return false;
+				}
+
+				read_ready_state = Handle_state::Read_ready_state::IDLE;
+
+				if (depth < 2 || !clipped_count)
+					return true;
+
+				/* keep the pipeline filled, stop at the end of the file */
+				file_size position = seek_offset;
+				while (Read_slot const *slot = _pending_read_at(position)) {
+
+					if (slot->state == Slot_state::ACK
+					 && slot->packet.length() < slot->packet.size())
+						return true;
+
+					position += slot->packet.size();
+				}
+
+				while (_num_pending_reads() < depth
+				    && _submit_read(clipped_count, position, true))
+					position += clipped_count;
+
+				return true;
+			}
+
 			Read_result _complete_read(void *dst, file_size count,
+			                           file_size const seek_offset,
 			                           file_size &out_count)
 			{
-				if (queued_read_state != Handle_state::Queued_state::ACK)
+				Read_slot * const slot = _pending_read_at(seek_offset);
+
+				if (!slot)
+					return READ_ERR_INVALID;
+
+				if (slot->state != Slot_state::ACK)
 					return READ_QUEUED;
 
 				/* obtain result packet descriptor with updated status info */
-				::File_system::Packet_descriptor const
-					packet = queued_read_packet;
+				::File_system::Packet_descriptor const packet = slot->packet;
 
 				file_size const read_num_bytes = min(packet.length(), count);
 
@@ -124,12 +313,9 @@ class Vfs::Fs_file_system : public File_system
 
 				memcpy(dst, source.packet_content(packet), read_num_bytes);
 
-				queued_read_state  = Handle_state::Queued_state::IDLE;
-				queued_read_packet = ::File_system::Packet_descriptor();
+				out_count = read_num_bytes;
 
-				out_count  = read_num_bytes;
-
-				source.release_packet(packet);
+				_release_read_slot(*slot, true);
 
 				/*
 				 * Notify anyone who might have failed on
@@ -144,13 +330,17 @@ class Vfs::Fs_file_system : public File_system
 			              int status_flags, Handle_space &space,
 			              ::File_system::Node_handle node_handle,
 			              ::File_system::Connection &fs_connection,
-			              Io_response_handler &io_handler)
+			              Io_response_handler &io_handler,
+			              Read_ahead &read_ahead)
 			:
 				Vfs_handle(fs, fs, alloc, status_flags),
 				Handle_space::Element(*this, space, node_handle),
-				_fs(fs_connection), _io_handler(io_handler)
+				_fs(fs_connection), _io_handler(io_handler),
+				_read_ahead(read_ahead)
 			{ }
 
+			~Fs_vfs_handle() { discard_reads(); }
+
 			::File_system::File_handle file_handle() const
 			{ return ::File_system::File_handle { id().value }; }
 
@@ -228,13 +418,13 @@ class Vfs::Fs_file_system : public File_system
 
 			bool queue_read(file_size count) override
 			{
-				return _queue_read(count, seek());
+				return _queue_read(count, seek(), _read_ahead.depth);
 			}
 
 			Read_result complete_read(char *dst, file_size count,
 			                          file_size &out_count) override
 			{
-				return _complete_read(dst, count, out_count);
+				return _complete_read(dst, count, seek(), out_count);
 			}
 		};
 
@@ -244,13 +434,15 @@ class Vfs::Fs_file_system : public File_system
 
 			using Fs_vfs_handle::Fs_vfs_handle;
 
+			file_size _entry_offset() const {
+				return seek() / sizeof(Dirent) * DIRENT_SIZE; }
+
 			bool queue_read(file_size count) override
 			{
 				if (count < sizeof(Dirent))
 					return true;
 
-				return _queue_read(DIRENT_SIZE,
-				                   (seek() / sizeof(Dirent) * DIRENT_SIZE));
+				return _queue_read(DIRENT_SIZE, _entry_offset());
 			}
 
 			Read_result complete_read(char *dst, file_size count,
@@ -265,7 +457,8 @@ class Vfs::Fs_file_system : public File_system
 				file_size       entry_out_count;
 
 				Read_result read_result =
-					_complete_read(&entry, DIRENT_SIZE, entry_out_count);
+					_complete_read(&entry, DIRENT_SIZE, _entry_offset(),
+					               entry_out_count);
 
 				if (read_result != READ_OK)
 					return read_result;
@@ -315,7 +508,7 @@ class Vfs::Fs_file_system : public File_system
 			Read_result complete_read(char *dst, file_size count,
 			                          file_size &out_count) override
 			{
-				return _complete_read(dst, count, out_count);
+				return _complete_read(dst, count, seek(), out_count);
 			}
 		};
 
@@ -331,10 +524,11 @@ class Vfs::Fs_file_system : public File_system
 			                ::File_system::Node_handle fs_handle,
 			                Handle_space &space,
 			                ::File_system::Connection &fs_connection,
-			                Io_response_handler &io_handler)
+			                Io_response_handler &io_handler,
+			                Read_ahead &read_ahead)
 			:
 				Fs_vfs_handle(fs, *(Allocator*)nullptr, 0, space, fs_handle,
-				              fs_connection, io_handler),
+				              fs_connection, io_handler, read_ahead),
 				_fs_session(fs_session)
 			{ }
 
@@ -414,55 +608,6 @@ class Vfs::Fs_file_system : public File_system
 
 		Post_signal_hook _post_signal_hook { _env.ep(), _io_handler };
 
-		file_size _read(Fs_vfs_handle &handle, void *buf,
-		                file_size const count, file_size const seek_offset)
-		{
-			::File_system::Session::Tx::Source &source = *_fs.tx();
-			using ::File_system::Packet_descriptor;
-
-			file_size const max_packet_size = source.bulk_buffer_size() / 2;
-			file_size const clipped_count = min(max_packet_size, count);
-
-			/* XXX check if alloc_packet() and submit_packet() will succeed! */
-
-			Packet_descriptor const packet_in(source.alloc_packet(clipped_count),
-			                                  handle.file_handle(),
-			                                  Packet_descriptor::READ,
-			                                  clipped_count,
-			                                  seek_offset);
-
-			/* wait until packet was acknowledged */
-			handle.queued_read_state = Handle_state::Queued_state::QUEUED;
-
-			/* pass packet to server side */
-			source.submit_packet(packet_in);
-
-			while (handle.queued_read_state != Handle_state::Queued_state::ACK) {
-				_env.ep().wait_and_dispatch_one_io_signal();
-			}
-
-			/* obtain result packet descriptor with updated status info */
-			Packet_descriptor const packet_out = handle.queued_read_packet;
-
-			handle.queued_read_state  = Handle_state::Queued_state::IDLE;
-			handle.queued_read_packet = Packet_descriptor();
-
-			if (!packet_out.succeeded()) {
-				/* could be EOF or a real error */
-				::File_system::Status status = _fs.status(handle.file_handle());
-				if (seek_offset < status.size)
-					Genode::warning("unexpected failure on file-system read");
-			}
-
-			file_size const read_num_bytes = min(packet_out.length(), count);
-
-			memcpy(buf, source.packet_content(packet_out), read_num_bytes);
-
-			source.release_packet(packet_out);
-
-			return read_num_bytes;
-		}
-
 		file_size _write(Fs_vfs_handle &handle,
 		                 const char *buf, file_size count, file_size seek_offset)
 		{
@@ -506,6 +651,9 @@ class Vfs::Fs_file_system : public File_system
 
 				Handle_space::Id const id(packet.handle());
 
+				/* reads may have been discarded or their handle closed */
+				bool read_of_interest = false;
+
 				try {
 					_handle_space.apply<Fs_vfs_handle>(id, [&] (Fs_vfs_handle &handle)
 					{
@@ -516,9 +664,10 @@ class Vfs::Fs_file_system : public File_system
 							break;
 
 						case Packet_descriptor::READ:
-							handle.queued_read_packet = packet;
-							handle.queued_read_state  = Handle_state::Queued_state::ACK;
-							_post_signal_hook.arm(handle.context);
+							if (handle.read_acked(packet)) {
+								read_of_interest = true;
+								_post_signal_hook.arm(handle.context);
+							}
 							break;
 
 						case Packet_descriptor::WRITE:
@@ -542,9 +691,12 @@ class Vfs::Fs_file_system : public File_system
 						}
 					});
 				} catch (Handle_space::Unknown_id) {
-					Genode::warning("ack for unknown VFS handle"); }
+					if (packet.operation() != Packet_descriptor::READ)
+						Genode::warning("ack for unknown VFS handle"); }
 
-				if (packet.operation() == Packet_descriptor::WRITE) {
+				if (packet.operation() == Packet_descriptor::WRITE
+				 || (packet.operation() == Packet_descriptor::READ
+				  && !read_of_interest)) {
 					Lock::Guard guard(_lock);
 					source.release_packet(packet);
 				}
@@ -554,6 +706,8 @@ class Vfs::Fs_file_system : public File_system
 		Genode::Io_signal_handler<Fs_file_system> _ack_handler {
 			_env.ep(), *this, &Fs_file_system::_handle_ack };
 
+		Read_ahead _read_ahead;
+
 	public:
 
 		Fs_file_system(Genode::Env         &env,
@@ -569,8 +723,14 @@ class Vfs::Fs_file_system : public File_system
 			_fs(env, _fs_packet_alloc,
 			    _label.string(), _root.string(),
 			    config.attribute_value("writeable", true),
-			    ::File_system::DEFAULT_TX_BUF_SIZE)
+			    ::File_system::DEFAULT_TX_BUF_SIZE),
+			_read_ahead { min(config.attribute_value("queue_depth", 4U),
+			                  (unsigned)Handle_state::MAX_READ_SLOTS),
+			              _fs.tx()->bulk_buffer_size() / 4 }
 		{
+			if (!_read_ahead.depth)
+				_read_ahead.depth = 1;
+
 			_fs.sigh_ack_avail(_ack_handler);
 		}
 
@@ -593,7 +753,7 @@ class Vfs::Fs_file_system : public File_system
 			try {
 				::File_system::Node_handle node = _fs.node(path);
 				Fs_handle_guard node_guard(*this, _fs, node, _handle_space,
-				                           _fs, _io_handler);
+				                           _fs, _io_handler, _read_ahead);
 				status = _fs.status(node);
 			}
 			catch (::File_system::Lookup_failed) { return STAT_ERR_NO_ENTRY; }
@@ -629,7 +789,7 @@ class Vfs::Fs_file_system : public File_system
 			try {
 				::File_system::Dir_handle dir = _fs.dir(dir_path.base(), false);
 				Fs_handle_guard dir_guard(*this, _fs, dir, _handle_space, _fs,
-				                          _io_handler);
+				                          _io_handler, _read_ahead);
 
 				_fs.unlink(dir, file_name.base() + 1);
 			}
@@ -664,12 +824,13 @@ class Vfs::Fs_file_system : public File_system
 					_fs.dir(from_dir_path.base(), false);
 
 				Fs_handle_guard from_dir_guard(*this, _fs, from_dir,
-				                               _handle_space, _fs, _io_handler);
+				                               _handle_space, _fs, _io_handler,
+				                               _read_ahead);
 
 				::File_system::Dir_handle to_dir = _fs.dir(to_dir_path.base(),
 				                                           false);
 				Fs_handle_guard to_dir_guard(*this, _fs, to_dir, _handle_space,
-				                             _fs, _io_handler);
+				                             _fs, _io_handler, _read_ahead);
 
 				_fs.move(from_dir, from_file_name.base() + 1,
 				         to_dir,   to_file_name.base() + 1);
@@ -688,7 +849,7 @@ class Vfs::Fs_file_system : public File_system
 			::File_system::Node_handle node;
 			try { node = _fs.node(path); } catch (...) { return 0; }
 			Fs_handle_guard node_guard(*this, _fs, node, _handle_space, _fs,
-			                           _io_handler);
+			                           _io_handler, _read_ahead);
 
 			::File_system::Status status = _fs.status(node);
 
@@ -700,7 +861,7 @@ class Vfs::Fs_file_system : public File_system
 			try {
 				::File_system::Node_handle node = _fs.node(path);
 				Fs_handle_guard node_guard(*this, _fs, node, _handle_space,
-				                           _fs, _io_handler);
+				                           _fs, _io_handler, _read_ahead);
 
 				::File_system::Status status = _fs.status(node);
 
@@ -746,7 +907,7 @@ class Vfs::Fs_file_system : public File_system
 			try {
 				::File_system::Dir_handle dir = _fs.dir(dir_path.base(), false);
 				Fs_handle_guard dir_guard(*this, _fs, dir, _handle_space, _fs,
-				                          _io_handler);
+				                          _io_handler, _read_ahead);
 
 				::File_system::File_handle file = _fs.file(dir,
 				                                           file_name.base() + 1,
@@ -754,7 +915,7 @@ class Vfs::Fs_file_system : public File_system
 
 				*out_handle = new (alloc)
 					Fs_vfs_file_handle(*this, alloc, vfs_mode, _handle_space,
-					                   file, _fs, _io_handler);
+					                   file, _fs, _io_handler, _read_ahead);
 			}
 			catch (::File_system::Lookup_failed)       { return OPEN_ERR_UNACCESSIBLE;  }
 			catch (::File_system::Permission_denied)   { return OPEN_ERR_NO_PERM;       }
@@ -781,7 +942,8 @@ class Vfs::Fs_file_system : public File_system
 
 				*out_handle = new (alloc)
 					Fs_vfs_dir_handle(*this, alloc, ::File_system::READ_ONLY,
-					                  _handle_space, dir, _fs, _io_handler);
+					                  _handle_space, dir, _fs, _io_handler,
+					                  _read_ahead);
 			}
 			catch (::File_system::Lookup_failed)       { return OPENDIR_ERR_LOOKUP_FAILED;       }
 			catch (::File_system::Name_too_long)       { return OPENDIR_ERR_NAME_TOO_LONG;       }
@@ -813,7 +975,8 @@ class Vfs::Fs_file_system : public File_system
 				                                               false);
 
 				Fs_handle_guard from_dir_guard(*this, _fs, dir_handle,
-				                               _handle_space, _fs, _io_handler);
+				                               _handle_space, _fs, _io_handler,
+				                               _read_ahead);
 
 				::File_system::Symlink_handle symlink_handle =
 				    _fs.symlink(dir_handle, symlink_name.base() + 1, create);
@@ -822,7 +985,7 @@ class Vfs::Fs_file_system : public File_system
 					Fs_vfs_symlink_handle(*this, alloc,
 					                      ::File_system::READ_ONLY,
 					                      _handle_space, symlink_handle, _fs,
-					                      _io_handler);
+					                      _io_handler, _read_ahead);
 
 				return OPENLINK_OK;
 			}
@@ -868,6 +1031,9 @@ class Vfs::Fs_file_system : public File_system
 
 			Fs_vfs_handle &handle = static_cast<Fs_vfs_handle &>(*vfs_handle);
 
+			/* data read ahead may be outdated by the write */
+			handle.discard_reads();
+
 			out_count = _write(handle, buf, buf_size, handle.seek());
 
 			return WRITE_OK;
@@ -932,7 +1098,12 @@ class Vfs::Fs_file_system : public File_system
 
 		Ftruncate_result ftruncate(Vfs_handle *vfs_handle, file_size len) override
 		{
-			Fs_vfs_handle const *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+			Fs_vfs_handle *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+
+			{
+				Lock::Guard guard(_lock);
+				handle->discard_reads();
+			}
 
 			try {
 				_fs.truncate(handle->file_handle(), len);
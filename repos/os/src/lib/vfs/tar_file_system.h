@@ -15,9 +15,13 @@
 #define _INCLUDE__VFS__TAR_FILE_SYSTEM_H_
 
 #include <rom_session/connection.h>
+#include <rm_session/connection.h>
+#include <region_map/client.h>
 #include <vfs/file_system.h>
 #include <vfs/vfs_handle.h>
 #include <base/attached_rom_dataspace.h>
+#include <util/reconstructible.h>
+#include <util/retry.h>
 
 namespace Vfs { class Tar_file_system; }
 
@@ -30,6 +34,9 @@ class Vfs::Tar_file_system : public File_system
 	typedef Genode::String<64> Rom_name;
 	Rom_name _rom_name;
 
+	/* hand out views of page-aligned records instead of copies */
+	bool const _zero_copy;
+
 	Genode::Attached_rom_dataspace _tar_ds { _env, _rom_name.string() };
 	char                          *_tar_base = _tar_ds.local_addr<char>();
 	file_size               const  _tar_size = _tar_ds.size();
@@ -129,62 +136,94 @@ class Vfs::Tar_file_system : public File_system
 		}
 	};
 
-	struct Tar_vfs_dir_handle : Tar_vfs_handle
+	class Tar_vfs_dir_handle : public Tar_vfs_handle
 	{
-		using Tar_vfs_handle::Tar_vfs_handle;
+		private:
 
-		Read_result read(char *dst, file_size count,
-		                 file_size &out_count) override
-		{
-			if (count < sizeof(Dirent))
-				return READ_ERR_INVALID;
+			/*
+			 * Most recently read directory entry, which allows a
+			 * sequential traversal of the directory without walking the
+			 * list of children from the start for each entry
+			 */
+			Node const  *_cursor       = nullptr;
+			file_offset  _cursor_index = 0;
 
-			Dirent *dirent = (Dirent*)dst;
+			Node const *_child(file_offset index)
+			{
+				Node const  *node = _node->first();
+				file_offset  i    = 0;
 
-			/* initialize */
-			*dirent = Dirent();
+				if (_cursor && index >= _cursor_index) {
+					node = _cursor;
+					i    = _cursor_index;
+				}
 
-			file_offset index = seek() / sizeof(Dirent);
+				for (; node && i < index; i++)
+					node = node->next();
 
-			Node const *node = _node->lookup_child(index);
+				if (node) {
+					_cursor       = node;
+					_cursor_index = index;
+				}
+				return node;
+			}
 
-			if (!node)
-				return READ_OK;
+		public:
 
-			dirent->fileno = (Genode::addr_t)node;
+			using Tar_vfs_handle::Tar_vfs_handle;
 
-			Record const *record = node->record;
+			Read_result read(char *dst, file_size count,
+			                 file_size &out_count) override
+			{
+				if (count < sizeof(Dirent))
+					return READ_ERR_INVALID;
 
-			while (record && (record->type() == Record::TYPE_HARDLINK)) {
-				Tar_file_system &tar_fs = static_cast<Tar_file_system&>(fs());
-				Node const *target = tar_fs.dereference(record->linked_name());
-				record = target ? target->record : 0;
-			}
+				Dirent *dirent = (Dirent*)dst;
+
+				/* initialize */
+				*dirent = Dirent();
+
+				file_offset index = seek() / sizeof(Dirent);
+
+				Node const *node = _child(index);
+
+				if (!node)
+					return READ_OK;
+
+				dirent->fileno = (Genode::addr_t)node;
 
-			if (record) {
-				switch (record->type()) {
-				case Record::TYPE_FILE:
-					dirent->type = DIRENT_TYPE_FILE;      break;
-				case Record::TYPE_SYMLINK:
-					dirent->type = DIRENT_TYPE_SYMLINK;   break;
-				case Record::TYPE_DIR:
-					dirent->type = DIRENT_TYPE_DIRECTORY; break;
-
-				default:
-					Genode::error("unhandled record type ", record->type(), " "
-					              "for ", node->name);
+				Record const *record = node->record;
+
+				while (record && (record->type() == Record::TYPE_HARDLINK)) {
+					Tar_file_system &tar_fs = static_cast<Tar_file_system&>(fs());
+					Node const *target = tar_fs.dereference(record->linked_name());
+					record = target ? target->record : 0;
 				}
-			} else {
-				/* If no record exists, assume it is a directory */
-				dirent->type = DIRENT_TYPE_DIRECTORY;
-			}
 
-			strncpy(dirent->name, node->name, sizeof(dirent->name));
+				if (record) {
+					switch (record->type()) {
+					case Record::TYPE_FILE:
+						dirent->type = DIRENT_TYPE_FILE;      break;
+					case Record::TYPE_SYMLINK:
+						dirent->type = DIRENT_TYPE_SYMLINK;   break;
+					case Record::TYPE_DIR:
+						dirent->type = DIRENT_TYPE_DIRECTORY; break;
+
+					default:
+						Genode::error("unhandled record type ", record->type(), " "
+						              "for ", node->name);
+					}
+				} else {
+					/* If no record exists, assume it is a directory */
+					dirent->type = DIRENT_TYPE_DIRECTORY;
+				}
 
-			out_count = sizeof(Dirent);
+				strncpy(dirent->name, node->name, sizeof(dirent->name));
 
-			return READ_OK;
-		}
+				out_count = sizeof(Dirent);
+
+				return READ_OK;
+			}
 	};
 
 	struct Tar_vfs_symlink_handle : Tar_vfs_handle
@@ -222,65 +261,129 @@ class Vfs::Tar_file_system : public File_system
 	{
 		char const *name;
 		Record const *record;
+		Node const *parent;
 
-		Node(char const *name, Record const *record) : name(name), record(record) { }
+		unsigned num_children = 0;
 
-		Node *lookup(char const *name)
-		{
-			Absolute_path lookup_path(name);
+		/* chaining within the node table */
+		Node *next_in_bucket = nullptr;
 
-			Node *parent_node = this;
-			Node *child_node;
+		/* read-only view of the file data, created on demand */
+		Genode::Capability<Genode::Region_map> view { };
+		Dataspace_capability                   view_ds { };
+		bool                                   view_tried = false;
 
-			Path_element_token t(lookup_path.base());
+		Node(char const *name, Record const *record, Node const *parent = nullptr)
+		: name(name), record(record), parent(parent) { }
+	} _root_node;
 
-			while (t) {
 
-				if (t.type() != Path_element_token::IDENT) {
-						t = t.next();
-						continue;
-				}
+	/**
+	 * Hash table of all nodes, keyed by their parent node and name
+	 *
+	 * Resolving a path element used to compare the element against the
+	 * names of all children of a directory, which is slow for archives
+	 * with thousands of entries.
+	 */
+	class Node_table
+	{
+		private:
 
-				char path_element[MAX_PATH_LEN];
+			Genode::Allocator &_alloc;
+
+			Node     **_buckets     = nullptr;
+			unsigned   _num_buckets = 0;
+			unsigned   _count       = 0;
+
+			static unsigned _hash(Node const *parent, char const *name)
+			{
+				/* FNV-1a */
+				unsigned h = 2166136261U ^ (unsigned)((Genode::addr_t)parent >> 4);
+				for (; *name; name++)
+					h = (h ^ (unsigned char)*name)*16777619U;
+				return h;
+			}
 
-				t.string(path_element, sizeof(path_element));
+			Node *&_bucket(Node const *parent, char const *name) const {
+				return _buckets[_hash(parent, name) & (_num_buckets - 1)]; }
 
-				for (child_node = parent_node->first(); child_node; child_node = child_node->next()) {
-					if (strcmp(child_node->name, path_element) == 0) {
-						parent_node = child_node;
-						break;
+			void _grow()
+			{
+				Node   **old_buckets     = _buckets;
+				unsigned old_num_buckets = _num_buckets;
+
+				_num_buckets = old_num_buckets ? 2*old_num_buckets : 64;
+				_buckets     = (Node **)_alloc.alloc(_num_buckets*sizeof(Node *));
+
+				for (unsigned i = 0; i < _num_buckets; i++)
+					_buckets[i] = nullptr;
+
+				for (unsigned i = 0; i < old_num_buckets; i++) {
+					while (Node *node = old_buckets[i]) {
+						old_buckets[i] = node->next_in_bucket;
+
+						Node *&bucket = _bucket(node->parent, node->name);
+						node->next_in_bucket = bucket;
+						bucket = node;
 					}
 				}
 
-				if (!child_node)
-					return 0;
-
-				t = t.next();
+				if (old_buckets)
+					_alloc.free(old_buckets, old_num_buckets*sizeof(Node *));
 			}
 
-			return parent_node;
-		}
+		public:
 
+			Node_table(Genode::Allocator &alloc) : _alloc(alloc) { _grow(); }
 
-		Node const *lookup_child(int index) const
-		{
-			for (Node const *child_node = first(); child_node; child_node = child_node->next(), index--) {
-				if (index == 0)
-					return child_node;
+			~Node_table() { _alloc.free(_buckets, _num_buckets*sizeof(Node *)); }
+
+			Node *lookup(Node const *parent, char const *name) const
+			{
+				for (Node *node = _bucket(parent, name); node; node = node->next_in_bucket)
+					if (node->parent == parent && strcmp(node->name, name) == 0)
+						return node;
+
+				return nullptr;
 			}
 
-			return 0;
-		}
+			void insert(Node &node)
+			{
+				if (_count >= _num_buckets)
+					_grow();
 
+				Node *&bucket = _bucket(node.parent, node.name);
+				node.next_in_bucket = bucket;
+				bucket = &node;
+				_count++;
+			}
+	} _node_table;
 
-		file_size num_dirent()
-		{
-			file_size count = 0;
-			for (Node *child_node = first(); child_node; child_node = child_node->next(), count++) ;
-			return count;
+
+	Node *_lookup(char const *path)
+	{
+		Absolute_path lookup_path(path);
+
+		Node *node = &_root_node;
+
+		Path_element_token t(lookup_path.base());
+
+		for (; t; t = t.next()) {
+
+			if (t.type() != Path_element_token::IDENT)
+				continue;
+
+			char path_element[MAX_PATH_LEN];
+
+			t.string(path_element, sizeof(path_element));
+
+			node = _node_table.lookup(node, path_element);
+			if (!node)
+				return 0;
 		}
 
-	} _root_node;
+		return node;
+	}
 
 
 	/*
@@ -294,11 +397,14 @@ class Vfs::Tar_file_system : public File_system
 
 			Node &_root_node;
 
+			Node_table &_node_table;
+
 		public:
 
 			Add_node_action(Genode::Allocator &alloc,
-			                Node              &root_node)
-			: _alloc(alloc), _root_node(root_node) { }
+			                Node              &root_node,
+			                Node_table        &node_table)
+			: _alloc(alloc), _root_node(root_node), _node_table(node_table) { }
 
 			void operator()(Record const *record)
 			{
@@ -322,10 +428,7 @@ class Vfs::Tar_file_system : public File_system
 
 					t.string(path_element, sizeof(path_element));
 
-					for (child_node = parent_node->first(); child_node; child_node = child_node->next()) {
-						if (strcmp(child_node->name, path_element) == 0)
-							break;
-					}
+					child_node = _node_table.lookup(parent_node, path_element);
 
 					if (child_node) {
 
@@ -346,16 +449,18 @@ class Vfs::Tar_file_system : public File_system
 							Genode::size_t name_size = strlen(path_element) + 1;
 							char *name = (char*)_alloc.alloc(name_size);
 							strncpy(name, path_element, name_size);
-							child_node = new (_alloc) Node(name, record);
+							child_node = new (_alloc) Node(name, record, parent_node);
 						} else {
 
 							/* create a directory node without record */
 							Genode::size_t name_size = strlen(path_element) + 1;
 							char *name = (char*)_alloc.alloc(name_size);
 							strncpy(name, path_element, name_size);
-							child_node = new (_alloc) Node(name, 0);
+							child_node = new (_alloc) Node(name, 0, parent_node);
 						}
 						parent_node->insert(child_node);
+						parent_node->num_children++;
+						_node_table.insert(*child_node);
 					}
 
 					parent_node = child_node;
@@ -398,42 +503,80 @@ class Vfs::Tar_file_system : public File_system
 	}
 
 
-	struct Num_dirent_cache
+	Genode::Constructible<Genode::Rm_connection> _rm { };
+	bool                                         _rm_failed = false;
+
+	/**
+	 * Create read-only view of the data of a file record within the archive
+	 *
+	 * A view is possible only if enabled via the 'zero_copy' attribute, the
+	 * data starts at a page boundary, and the remainder of its last page
+	 * contains zeros only. Thereby, the view looks exactly like a
+	 * zero-padded copy of the data. Views must not be enabled on base-linux,
+	 * where other components cannot attach the managed dataspaces of an RM
+	 * session.
+	 */
+	Genode::Capability<Genode::Region_map> _create_view(Record const &record)
 	{
-		Lock             lock;
-		Node            &root_node;
-		bool             valid;              /* true after first lookup */
-		char             key[256];           /* key used for lookup */
-		file_size        cached_num_dirent;  /* cached value */
+		using namespace Genode;
 
-		Num_dirent_cache(Node &root_node)
-		: root_node(root_node), valid(false), cached_num_dirent(0) { }
+		enum { PAGE_SIZE_LOG2 = 12 };
 
-		file_size num_dirent(char const *path)
-		{
-			Lock::Guard guard(lock);
+		if (!_zero_copy)
+			return Capability<Region_map>();
 
-			/* check for cache miss */
-			if (!valid || strcmp(path, key) != 0) {
-				Node *node = root_node.lookup(path);
-				if (!node)
-					return 0;
-				strncpy(key, path, sizeof(key));
-				cached_num_dirent = node->num_dirent();
-				valid = true;
+		addr_t    const offset    = (char *)record.data() - _tar_base;
+		file_size const size      = record.size();
+		file_size const view_size = align_addr(size, PAGE_SIZE_LOG2);
+
+		if (size == 0 || (offset & ((1UL << PAGE_SIZE_LOG2) - 1))
+		 || offset + view_size > _tar_size || _rm_failed)
+			return Capability<Region_map>();
+
+		for (file_size i = size; i < view_size; i++)
+			if (_tar_base[offset + i])
+				return Capability<Region_map>();
+
+		if (!_rm.constructed()) {
+			try { _rm.construct(_env); }
+			catch (...) {
+				warning("RM session unavailable, handing out copies of TAR records");
+				_rm_failed = true;
+				return Capability<Region_map>();
 			}
-			return cached_num_dirent;
 		}
-	} _cached_num_dirent;
+
+		Capability<Region_map> view;
+		try {
+			retry<Out_of_ram>(
+				[&] () {
+					view = _rm->create(view_size);
+					Region_map_client(view).attach_at(_tar_ds.cap(), 0,
+					                                  view_size, offset);
+				},
+				[&] () {
+					if (view.valid())
+						_rm->destroy(view);
+					view = Capability<Region_map>();
+					_rm->upgrade_ram(Rm_connection::RAM_QUOTA);
+				});
+		}
+		catch (...) {
+			if (view.valid())
+				_rm->destroy(view);
+			return Capability<Region_map>();
+		}
+		return view;
+	}
 
 	/**
 	 * Walk hardlinks until we reach a file
 	 *
 	 * XXX: check for hardlink loops
 	 */
-	Node const *dereference(char const *path)
+	Node *dereference(char const *path)
 	{
-		Node const *node = _root_node.lookup(path);
+		Node *node = _lookup(path);
 		if (!node) return 0;
 
 		Record const *record = node->record;
@@ -452,13 +595,14 @@ class Vfs::Tar_file_system : public File_system
 		:
 			_env(env), _alloc(alloc),
 			_rom_name(config.attribute_value("name", Rom_name())),
+			_zero_copy(config.attribute_value("zero_copy", false)),
 			_root_node("", 0),
-			_cached_num_dirent(_root_node)
+			_node_table(_alloc)
 		{
 			Genode::log("tar archive '", _rom_name, "' "
 			            "local at ", (void *)_tar_base, ", size is ", _tar_size);
 
-			_for_each_tar_record_do(Add_node_action(_alloc, _root_node));
+			_for_each_tar_record_do(Add_node_action(_alloc, _root_node, _node_table));
 		}
 
 		/*********************************
@@ -467,7 +611,7 @@ class Vfs::Tar_file_system : public File_system
 
 		Dataspace_capability dataspace(char const *path) override
 		{
-			Node const *node = dereference(path);
+			Node *node = dereference(path);
 			if (!node || !node->record)
 				return Dataspace_capability();
 
@@ -478,6 +622,17 @@ class Vfs::Tar_file_system : public File_system
 				return Dataspace_capability();
 			}
 
+			/* hand out the view shared by all users of the record if possible */
+			if (!node->view_tried) {
+				node->view_tried = true;
+				node->view       = _create_view(*record);
+				if (node->view.valid())
+					node->view_ds = Genode::Region_map_client(node->view).dataspace();
+			}
+
+			if (node->view_ds.valid())
+				return node->view_ds;
+
 			try {
 				Ram_dataspace_capability ds_cap =
 					_env.ram().alloc(record->size());
@@ -493,8 +648,12 @@ class Vfs::Tar_file_system : public File_system
 			return Dataspace_capability();
 		}
 
-		void release(char const *, Dataspace_capability ds_cap) override
+		void release(char const *path, Dataspace_capability ds_cap) override
 		{
+			Node const *node = dereference(path);
+			if (node && node->view_ds.valid() && node->view_ds == ds_cap)
+				return;
+
 			_env.ram().free(static_cap_cast<Genode::Ram_dataspace>(ds_cap));
 		}
 
@@ -544,14 +703,15 @@ class Vfs::Tar_file_system : public File_system
 
 		Rename_result rename(char const *from, char const *to) override
 		{
-			if (_root_node.lookup(from) || _root_node.lookup(to))
+			if (_lookup(from) || _lookup(to))
 				return RENAME_ERR_NO_PERM;
 			return RENAME_ERR_NO_ENTRY;
 		}
 
 		file_size num_dirent(char const *path) override
 		{
-			return _cached_num_dirent.num_dirent(path);
+			Node const *node = _lookup(path);
+			return node ? node->num_children : 0;
 		}
 
 		bool directory(char const *path) override
@@ -573,7 +733,7 @@ class Vfs::Tar_file_system : public File_system
 			 * case, return the whole path, which is relative to the root
 			 * of this file system.
 			 */
-			Node *node = _root_node.lookup(path);
+			Node *node = _lookup(path);
 			return node ? path : 0;
 		}
 
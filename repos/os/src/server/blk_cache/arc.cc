@@ -0,0 +1,135 @@
+/*
+ * \brief  Adaptive replacement cache (ARC) strategy
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The implementation follows Megiddo and Modha, "ARC: A Self-Tuning, Low
+ * Overhead Replacement Cache". The cache capacity is not fixed but given
+ * by the RAM available to the component, so the histories are bounded by
+ * the number of chunks that fit into the RAM quota at initialization time.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include "arc.h"
+#include "driver.h"
+#include "ghost_list.h"
+
+typedef Driver<Arc_policy>::Chunk_level_4 Chunk;
+
+static Cache::Chunk_list recent;      /* T1, chunks accessed once     */
+static Cache::Chunk_list frequent;    /* T2, chunks accessed again    */
+static Cache::Ghost_list recent_history;
+static Cache::Ghost_list frequent_history;
+
+static unsigned long capacity = 0;    /* maximum number of chunks     */
+static unsigned long target   = 0;    /* desired size of 'recent'     */
+
+
+static Cache::offset_t offset(Arc_policy::Element const &e) {
+	return static_cast<Chunk const &>(e).base_offset(); }
+
+
+static void arc_insert(Arc_policy::Element &e)
+{
+	using Genode::max;
+	using Genode::min;
+
+	unsigned long const recent_ghosts   = recent_history.count();
+	unsigned long const frequent_ghosts = frequent_history.count();
+
+	if (recent_history.remove(offset(e))) {
+
+		/* the recency list was too short to retain the chunk */
+		target = min(capacity,
+		             target + max(frequent_ghosts/recent_ghosts, 1UL));
+		frequent.insert_head(&e);
+		return;
+	}
+
+	if (frequent_history.remove(offset(e))) {
+
+		/* the frequency list was too short to retain the chunk */
+		target -= min(target, max(recent_ghosts/frequent_ghosts, 1UL));
+		frequent.insert_head(&e);
+		return;
+	}
+
+	recent.insert_head(&e);
+}
+
+
+static void arc_access(Arc_policy::Element const *ce, bool fill)
+{
+	Arc_policy::Element &e = const_cast<Arc_policy::Element &>(*ce);
+
+	if (!e.list()) {
+		arc_insert(e);
+		e.fresh = fill;
+		return;
+	}
+
+	if (e.fresh) {
+		e.fresh = false;
+		return;
+	}
+
+	frequent.insert_head(&e);
+}
+
+
+void Arc_policy::init(Genode::Allocator &alloc, Cache::size_t max_chunks)
+{
+	if (capacity)
+		return;
+
+	capacity = max_chunks;
+	recent_history.init(alloc, max_chunks);
+	frequent_history.init(alloc, max_chunks);
+}
+
+
+void Arc_policy::read(const Arc_policy::Element  *e) {
+	arc_access(e, false); }
+
+
+void Arc_policy::write(const Arc_policy::Element *e) {
+	arc_access(e, false); }
+
+
+void Arc_policy::fill(const Arc_policy::Element  *e) {
+	arc_access(e, true); }
+
+
+void Arc_policy::flush(Cache::size_t size)
+{
+	Cache::size_t s = 0;
+	while ((recent.count() || frequent.count()) && ((size == 0) || (s < size))) {
+
+		bool const from_recent = recent.count()
+		                      && (recent.count() > target || !frequent.count());
+
+		Chunk *cb = static_cast<Chunk*>(static_cast<Arc_policy::Element*>(
+			from_recent ? recent.tail() : frequent.tail()));
+
+		Cache::offset_t const off = cb->base_offset();
+		try {
+			/* freeing the chunk removes it from its list */
+			cb->free(Driver<Arc_policy>::CACHE_BLK_SIZE, off);
+			s += sizeof(Chunk);
+
+			if (from_recent) recent_history.insert(off);
+			else             frequent_history.insert(off);
+
+		} catch(Chunk::Dirty_chunk &e) {
+			cb->sync(e.size, e.off);
+		}
+	}
+
+	if (s < size) throw Block::Driver::Request_congestion();
+}
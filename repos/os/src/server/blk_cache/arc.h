@@ -0,0 +1,47 @@
+/*
+ * \brief  Adaptive replacement cache (ARC) strategy
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/allocator.h>
+
+#include "chunk.h"
+#include "chunk_list.h"
+
+/**
+ * Replacement strategy that balances recency and frequency
+ *
+ * Chunks accessed once reside in a recency list, chunks accessed again in
+ * a frequency list. The history of chunks evicted from either list steers
+ * the share of the cache dedicated to the recency list. A sequential scan
+ * thereby only displaces chunks of the recency list.
+ */
+struct Arc_policy
+{
+	class Element : public Cache::Chunk_list::Element
+	{
+		public:
+
+			/*
+			 * Set when the chunk got filled from the backend, so that the
+			 * access by the client request that triggered the fill is not
+			 * counted as a repeated access
+			 */
+			bool fresh = false;
+	};
+
+	static void init(Genode::Allocator &alloc, Cache::size_t max_chunks);
+
+	static void read(const Element  *e);
+	static void write(const Element *e);
+	static void fill(const Element  *e);
+	static void flush(Cache::size_t size = 0);
+};
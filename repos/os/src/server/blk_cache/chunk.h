@@ -155,7 +155,37 @@ namespace Cache {
 
 				_num_entries = Genode::max(_num_entries, local_offset + len);
 
-				_writes++;
+				bool const was_clean = _writes <= 1;
+
+				/* a chunk written by the client is dirty even if never filled */
+				_writes = (_writes ? _writes : 1) + 1;
+
+				if (was_clean)
+					POLICY::dirty(this);
+			}
+
+			/**
+			 * Populate chunk with data read from the backend device
+			 *
+			 * Data already present is newer than the data read from the
+			 * backend and is retained.
+			 */
+			void fill(char const *src, size_t len, offset_t seek_offset)
+			{
+				assert_valid_range(seek_offset, len, SIZE);
+
+				if (_writes)
+					return;
+
+				POLICY::fill(this);
+
+				offset_t const local_offset = seek_offset - base_offset();
+
+				Genode::memcpy(&_data[local_offset], src, len);
+
+				_num_entries = Genode::max(_num_entries, local_offset + len);
+
+				_writes = 1;
 			}
 
 			void read(char *dst, size_t len, offset_t seek_offset) const
@@ -183,6 +213,21 @@ namespace Cache {
 				}
 			}
 
+			/**
+			 * Drop the modifications of a chunk trimmed by the client
+			 *
+			 * Only a chunk that is covered by the range as a whole is
+			 * affected. Its data need not be written back anymore.
+			 */
+			void discard(size_t len, offset_t seek_offset)
+			{
+				if (len < SIZE || _writes <= 1)
+					return;
+
+				_writes = 1;
+				POLICY::clean(this);
+			}
+
 			void alloc(size_t len, offset_t seek_offset) { }
 
 			void truncate(size_t size)
@@ -393,6 +438,21 @@ namespace Cache {
 				}
 			};
 
+			struct Fill_func
+			{
+				typedef ENTRY_TYPE Entry;
+
+				/* the chunk may have been evicted while being read */
+				static Entry &lookup(Chunk_index &chunk, unsigned i) {
+					return chunk._alloc_entry(i); }
+
+				void operator () (Entry &entry, char const *src, size_t len,
+				                  offset_t seek_offset) const
+				{
+					entry.fill(src, len, seek_offset);
+				}
+			};
+
 			struct Read_func
 			{
 				typedef ENTRY_TYPE const Entry;
@@ -431,6 +491,20 @@ namespace Cache {
 				}
 			};
 
+			struct Discard_func
+			{
+				typedef ENTRY_TYPE Entry;
+
+				static Entry &lookup(Chunk_index const &chunk, unsigned i) {
+					return chunk._entry_for_syncing(i); }
+
+				void operator () (Entry &entry, char*, size_t len,
+				                  offset_t seek_offset) const
+				{
+					entry.discard(len, seek_offset);
+				}
+			};
+
 			void _init_entries()
 			{
 				for (unsigned i = 0; i < NUM_ENTRIES; i++)
@@ -499,6 +573,12 @@ namespace Cache {
 			void write(char const *src, size_t len, offset_t seek_offset) {
 				_range_op(*this, src, len, seek_offset, Write_func()); }
 
+			/**
+			 * Populate chunks with data read from the backend device
+			 */
+			void fill(char const *src, size_t len, offset_t seek_offset) {
+				_range_op(*this, src, len, seek_offset, Fill_func()); }
+
 			/**
 			 * Allocate needed chunks
 			 */
@@ -524,6 +604,13 @@ namespace Cache {
 				if (zero()) return;
 				_range_op(*this, (char*)0, len, seek_offset, Sync_func()); }
 
+			/**
+			 * Drop modifications of chunks covered by the range
+			 */
+			void discard(size_t len, offset_t seek_offset) const {
+				if (zero()) return;
+				_range_op(*this, (char*)0, len, seek_offset, Discard_func()); }
+
 			/**
 			 * Free chunks
 			 */
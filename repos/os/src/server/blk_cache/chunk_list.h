@@ -0,0 +1,112 @@
+/*
+ * \brief  Doubly-linked list of cached chunks
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _CHUNK_LIST_H_
+#define _CHUNK_LIST_H_
+
+/* Genode includes */
+#include <util/noncopyable.h>
+
+namespace Cache { class Chunk_list; }
+
+
+/**
+ * List used by the replacement policies to order the cached chunks
+ *
+ * In contrast to 'Genode::List', an element can be removed and re-inserted
+ * in constant time, which is needed on each cache hit.
+ */
+class Cache::Chunk_list : Genode::Noncopyable
+{
+	public:
+
+		class Element : Genode::Noncopyable
+		{
+			private:
+
+				friend class Chunk_list;
+
+				Element    *_prev = nullptr;
+				Element    *_next = nullptr;
+				Chunk_list *_list = nullptr;
+
+			public:
+
+				Element() { }
+
+				/*
+				 * A chunk leaves its list when freed
+				 */
+				~Element() { if (_list) _list->remove(this); }
+
+				/**
+				 * Return list the element is currently a member of
+				 */
+				Chunk_list const *list() const { return _list; }
+		};
+
+	private:
+
+		Element       *_head  = nullptr;   /* most recently inserted */
+		Element       *_tail  = nullptr;   /* least recently inserted */
+		unsigned long  _count = 0;
+
+	public:
+
+		void remove(Element *e)
+		{
+			if (e->_list != this)
+				return;
+
+			if (e->_prev) e->_prev->_next = e->_next;
+			else          _head           = e->_next;
+
+			if (e->_next) e->_next->_prev = e->_prev;
+			else          _tail           = e->_prev;
+
+			e->_prev = e->_next = nullptr;
+			e->_list = nullptr;
+			_count--;
+		}
+
+		/**
+		 * Insert element at the head of the list
+		 *
+		 * If the element is a member of a list, it is removed from the
+		 * list beforehand.
+		 */
+		void insert_head(Element *e)
+		{
+			if (e == _head)
+				return;
+
+			if (e->_list)
+				e->_list->remove(e);
+
+			e->_prev = nullptr;
+			e->_next = _head;
+			e->_list = this;
+
+			if (_head) _head->_prev = e;
+			else       _tail        = e;
+
+			_head = e;
+			_count++;
+		}
+
+		Element *tail() const { return _tail; }
+
+		unsigned long count() const { return _count; }
+};
+
+#endif /* _CHUNK_LIST_H_ */
@@ -18,6 +18,19 @@
 
 #include "chunk.h"
 
+
+/**
+ * Tunables of the cache driver
+ */
+struct Driver_config
+{
+	bool     verbose;      /* report statistics at session close           */
+	unsigned read_ahead;   /* chunks prefetched for sequential reads       */
+	unsigned dirty_ratio;  /* percentage of dirty chunks that triggers the
+	                          write-back in the background                 */
+};
+
+
 /**
  * Cache driver used by the generic block driver framework
  *
@@ -36,7 +49,7 @@ class Driver : public Block::Driver
 		{
 			Block::Packet_descriptor srv;
 			Block::Packet_descriptor cli;
-			char * const             buffer;
+			char * const             buffer;   /* nullptr for read-ahead */
 
 			Request(Block::Packet_descriptor &s,
 			        Block::Packet_descriptor &c,
@@ -51,7 +64,8 @@ class Driver : public Block::Driver
 			{
 				return reply.operation()    == srv.operation()  &&
 				       reply.block_number() == srv.block_number() &&
-				       reply.block_count()  == srv.block_count();
+				       reply.block_count()  == srv.block_count() &&
+				       reply.offset()       == srv.offset();
 			}
 
 			/*
@@ -93,13 +107,18 @@ class Driver : public Block::Driver
 		 * used by the cache chunk structure
 		 */
 		struct Policy : POLICY {
-			static void sync(const typename POLICY::Element *e, char *src); };
+			static void sync(const typename POLICY::Element *e, char *src);
+			static void dirty(const typename POLICY::Element *e);
+			static void clean(const typename POLICY::Element *e); };
 
 	public:
 
 		enum {
 			SLAB_SZ = Block::Session::TX_QUEUE_SIZE*sizeof(Request),
-			CACHE_BLK_SIZE = 4096
+			CACHE_BLK_SIZE = 4096,
+
+			/* maximum number of chunks written back by one packet */
+			MAX_RUN_CHUNKS = 16
 		};
 
 		/**
@@ -117,6 +136,7 @@ class Driver : public Block::Driver
 		Genode::Env                      &_env;
 		Genode::Tslab<Request, SLAB_SZ>   _r_slab;    /* slab for requests  */
 		Genode::List<Request>             _r_list;    /* list of requests   */
+		Genode::List<Request>             _r_retry;   /* stalled replays    */
 		Genode::Packet_allocator          _alloc;     /* packet allocator   */
 		Block::Connection                 _blk;       /* backend device     */
 		Block::Session::Operations        _ops;       /* allowed operations */
@@ -126,6 +146,46 @@ class Driver : public Block::Driver
 		Genode::Io_signal_handler<Driver> _source_ack;
 		Genode::Io_signal_handler<Driver> _source_submit;
 		Genode::Io_signal_handler<Driver> _yield;
+		Driver_config const               _config;
+
+		/*
+		 * Statistics of client read requests, reported at session close
+		 */
+		unsigned long _reads  = 0;
+		unsigned long _misses = 0;
+
+		/* set while a request is re-executed after a cache miss */
+		bool _replay = false;
+
+		/*
+		 * Backend packet that gathers the data of contiguous dirty chunks
+		 * during write-back
+		 */
+		struct Run
+		{
+			Block::Packet_descriptor packet   { };
+			Cache::offset_t          start    = 0;
+			Genode::size_t           len      = 0;
+			Genode::size_t           capacity = 0;
+
+			bool active() const { return capacity != 0; }
+		};
+
+		Run  _run { };
+		bool _gathering = false;   /* write-back pass in progress */
+
+		/* client SYNC request waiting for the write-back pass */
+		Block::Packet_descriptor _sync_packet { };
+		bool                     _sync_pending = false;
+
+		unsigned long   _dirty       = 0;   /* number of dirty chunks     */
+		unsigned long   _dirty_limit = 0;   /* threshold for write-back   */
+		bool            _write_back_pending = false;
+		Cache::offset_t _write_back_cursor  = 0;
+
+		/* detection of sequential reads */
+		Block::sector_t _seq_next = 0;
+		unsigned        _seq_len  = 0;
 
 		Driver(Driver const&);            /* singleton pattern */
 		Driver& operator=(Driver const&); /* singleton pattern */
@@ -152,11 +212,15 @@ class Driver : public Block::Driver
 		/*
 		 * Handle response to a single request
 		 *
-		 * \param srv  packet received from the backend device
-		 * \param r    outstanding request
+		 * \param r  outstanding request
+		 * \return   false if the backend device is congested and the
+		 *           request must be replayed later
 		 */
-		inline void _handle_reply(Block::Packet_descriptor &srv, Request *r)
+		inline bool _handle_reply(Request *r)
 		{
+			bool handled = true;
+
+			_replay = true;
 			try {
 			if (r->cli.operation() == Block::Packet_descriptor::READ)
 				read(r->cli.block_number(), r->cli.block_count(),
@@ -164,11 +228,27 @@ class Driver : public Block::Driver
 			else
 				write(r->cli.block_number(), r->cli.block_count(),
 				      r->buffer, r->cli);
-			} catch(Block::Driver::Request_congestion) {
-				Genode::warning("cli (", r->cli.block_number(), " ",
-				                         r->cli.block_count(), ") "
-				                "srv (", r->srv.block_number(), " ",
-				                         r->srv.block_count(), ")");
+			} catch(Block::Driver::Request_congestion) { handled = false; }
+			_replay = false;
+
+			return handled;
+		}
+
+		/*
+		 * Replay requests that stalled on the congested backend device
+		 *
+		 * The client packets of these requests must not be dropped.
+		 * Otherwise, they would never be acknowledged.
+		 */
+		void _retry_replays()
+		{
+			for (Request *r = _r_retry.first(), *r_to_handle = r; r;
+			     r_to_handle = r) {
+				r = r->next();
+				if (_handle_reply(r_to_handle)) {
+					_r_retry.remove(r_to_handle);
+					Genode::destroy(&_r_slab, r_to_handle);
+				}
 			}
 		}
 
@@ -182,29 +262,173 @@ class Driver : public Block::Driver
 
 				/* when reading, write result into cache */
 				if (p.operation() == Block::Packet_descriptor::READ)
-					_cache.write(_blk.tx()->packet_content(p),
-					             p.block_count() * _blk_sz,
-					             p.block_number() * _blk_sz);
+					_cache.fill(_blk.tx()->packet_content(p),
+					            p.block_count() * _blk_sz,
+					            p.block_number() * _blk_sz);
 
 				/* loop through the list of requests, and ack all related */
 				for (Request *r = _r_list.first(), *r_to_handle = r; r;
 				     r_to_handle = r) {
 					r = r->next();
 					if (r_to_handle->match(p)) {
-						_handle_reply(p, r_to_handle);
 						_r_list.remove(r_to_handle);
+						if (!p.payload())
+							ack_packet(r_to_handle->cli, p.succeeded());
+						else if (r_to_handle->buffer
+						      && !_handle_reply(r_to_handle)) {
+							_r_retry.insert(r_to_handle);
+							continue;
+						}
 						Genode::destroy(&_r_slab, r_to_handle);
 					}
 				}
 
 				_blk.tx()->release_packet(p);
 			}
+
+			/* continue write-back that stalled on the congested backend */
+			_write_back();
+			_retry_replays();
 		}
 
 		/*
 		 * Handle that the backend device is ready to receive again
 		 */
-		void _ready_to_submit() { }
+		void _ready_to_submit()
+		{
+			_write_back();
+			_retry_replays();
+		}
+
+		/*
+		 * Pass gathered write-back data to the backend device
+		 */
+		void _submit_run()
+		{
+			if (!_run.active())
+				return;
+
+			Block::Packet_descriptor const
+				p(_run.packet, Block::Packet_descriptor::WRITE,
+				  _run.start / _blk_sz, _run.len / _blk_sz);
+
+			/* the submit slot was checked when allocating the packet */
+			_blk.tx()->submit_packet(p);
+			_run = Run();
+		}
+
+		/*
+		 * Write back dirty chunks without blocking
+		 *
+		 * A pass continues at the position where the previous one stopped
+		 * because the backend device was congested.
+		 */
+		void _write_back()
+		{
+			if (_gathering)
+				return;
+
+			if (_write_back_pending) {
+
+				Cache::size_t const size = _blk_sz * _blk_cnt;
+
+				_gathering = true;
+				try {
+					_cache.sync(size - _write_back_cursor, _write_back_cursor);
+					_write_back_cursor  = 0;
+					_write_back_pending = false;
+				} catch(Write_failed &e) {
+					_write_back_cursor = e.off;
+				}
+				_submit_run();
+				_gathering = false;
+			}
+
+			_submit_sync();
+		}
+
+		/*
+		 * Pass pending SYNC request of the client to the backend device
+		 * once all dirty chunks are written back
+		 */
+		void _submit_sync()
+		{
+			if (!_sync_pending || _write_back_pending)
+				return;
+
+			if (!_ops.supported(Block::Packet_descriptor::SYNC)) {
+				_sync_pending = false;
+				_blk.sync();
+				ack_packet(_sync_packet);
+				return;
+			}
+
+			/* the backend acknowledges the request after the written data */
+			try {
+				_forward(Block::Packet_descriptor::SYNC, 0, 0, _sync_packet);
+				_sync_pending = false;
+			} catch(Request_congestion) { }
+		}
+
+		/*
+		 * Prefetch the chunks following a sequential read
+		 *
+		 * \param nr  first block after the read
+		 */
+		void _read_ahead(Block::sector_t nr)
+		{
+			using namespace Genode;
+
+			if (!_config.read_ahead || !_blk.tx()->ready_to_submit())
+				return;
+
+			Block::sector_t const start = _cache_blk_round_up(nr);
+			Block::sector_t const end   =
+				min(start + (Block::sector_t)_config.read_ahead*_cache_blk_mod(),
+				    _blk_cnt);
+
+			if (start >= end)
+				return;
+
+			/* find the first chunk of the window not present in the cache */
+			Cache::offset_t off = end * _blk_sz;
+			try {
+				_cache.stat((end - start) * _blk_sz, start * _blk_sz);
+			} catch(Cache::Chunk_base::Range_incomplete &e) {
+				off = max(e.off, (Cache::offset_t)start * _blk_sz); }
+
+			/*
+			 * Issue the read-ahead once half of the window is consumed to
+			 * read several chunks with one packet
+			 */
+			Block::sector_t const missing = off / _blk_sz;
+			if ((missing - start) * 2 < end - start)
+				return;
+
+			/* the chunk may already be requested */
+			for (Request *r = _r_list.first(); r; r = r->next())
+				if (r->match(false, missing, _cache_blk_mod()))
+					return;
+
+			Block::sector_t const cnt =
+				min((Block::sector_t)_config.read_ahead*_cache_blk_mod(),
+				    _blk_cnt - missing);
+
+			/* read-ahead is best effort, give up if resources are short */
+			Block::Packet_descriptor p, no_client;
+			try {
+				_cache.alloc(cnt * _blk_sz, missing * _blk_sz);
+				p = Block::Packet_descriptor(_blk.dma_alloc_packet(_blk_sz*cnt),
+				                             Block::Packet_descriptor::READ,
+				                             missing, cnt);
+				_r_list.insert(new (&_r_slab) Request(p, no_client, nullptr));
+			} catch (...) {
+				if (p.size())
+					_blk.tx()->release_packet(p);
+				return;
+			}
+			_blk.tx()->submit_packet(p);
+		}
 
 		/*
 		 * Setup a request to the backend device
@@ -257,7 +481,41 @@ class Driver : public Block::Driver
 				/* clean up */
 				_blk.tx()->release_packet(p_to_dev);
 				throw Request_congestion();
+			} catch(Write_failed) {
+				/* evicting a dirty chunk stalled on the backend device */
+				throw Request_congestion();
+			}
+		}
+
+		/*
+		 * Pass a request without payload to the backend device
+		 *
+		 * The client packet is acknowledged along with the reply.
+		 */
+		void _forward(Block::Packet_descriptor::Opcode op,
+		              Block::sector_t           block_number,
+		              Genode::size_t            block_count,
+		              Block::Packet_descriptor &packet)
+		{
+			if (!_blk.tx()->ready_to_submit())
+				throw Request_congestion();
+
+			/*
+			 * The packet occupies one block of the buffer to make its
+			 * reply distinguishable from replies to other such requests
+			 */
+			Block::Packet_descriptor p;
+			try {
+				p = Block::Packet_descriptor(_blk.dma_alloc_packet(_blk_sz), op,
+				                             block_number, block_count);
+				_r_list.insert(new (&_r_slab) Request(p, packet, nullptr));
+			} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
+				throw Request_congestion();
+			} catch(Genode::Allocator::Out_of_memory) {
+				_blk.tx()->release_packet(p);
+				throw Request_congestion();
 			}
+			_blk.tx()->submit_packet(p);
 		}
 
 		/*
@@ -268,11 +526,14 @@ class Driver : public Block::Driver
 			Cache::offset_t off = 0;
 			Cache::size_t len   = _blk_sz * _blk_cnt;
 
+			_gathering = true;
 			while (len > 0) {
 				try {
 					_cache.sync(len, off);
 					len = 0;
 				} catch(Write_failed &e) {
+					_submit_run();
+
 					/**
 					 * Write to backend failed when backend device isn't ready
 					 * to proceed, so handle signals, until it's ready again
@@ -282,6 +543,14 @@ class Driver : public Block::Driver
 					_env.ep().wait_and_dispatch_one_io_signal();
 				}
 			}
+			_submit_run();
+			_gathering = false;
+
+			/* a complete pass supersedes the background write-back */
+			_write_back_pending = false;
+			_write_back_cursor  = 0;
+
+			_submit_sync();
 		}
 
 		/*
@@ -330,9 +599,11 @@ class Driver : public Block::Driver
 		/*
 		 * Constructor
 		 *
-		 * \param ep  server entrypoint
+		 * \param env      component environment
+		 * \param heap     allocator used for the cached chunks
+		 * \param config   tunables of the cache
 		 */
-		Driver(Genode::Env &env, Genode::Heap &heap)
+		Driver(Genode::Env &env, Genode::Heap &heap, Driver_config config)
 		: Block::Driver(env.ram()),
 		  _env(env),
 		  _r_slab(&heap),
@@ -343,7 +614,8 @@ class Driver : public Block::Driver
 		  _cache(heap, 0),
 		  _source_ack(env.ep(), *this, &Driver::_ack_avail),
 		  _source_submit(env.ep(), *this, &Driver::_ready_to_submit),
-		  _yield(env.ep(), *this, &Driver::_parent_yield)
+		  _yield(env.ep(), *this, &Driver::_parent_yield),
+		  _config(config)
 		{
 			using namespace Genode;
 
@@ -360,10 +632,23 @@ class Driver : public Block::Driver
 
 			/* truncate chunk structure to real size of the device */
 			_cache.truncate(_blk_sz*_blk_cnt);
+
+			/* the cache may grow up to the available RAM */
+			unsigned long const max_chunks =
+				_env.ram().avail_ram().value / CACHE_BLK_SIZE;
+
+			POLICY::init(heap, max_chunks);
+
+			_dirty_limit = max_chunks * min(_config.dirty_ratio, 100U) / 100;
 		}
 
 		~Driver()
 		{
+			if (_config.verbose)
+				Genode::log("read requests: ", _reads, ", hits: ",
+				            _reads - _misses, " (",
+				            _reads ? (_reads - _misses)*100/_reads : 0, "%)");
+
 			/* when session gets closed, synchronize and flush the cache */
 			_sync();
 			POLICY::flush();
@@ -372,6 +657,73 @@ class Driver : public Block::Driver
 		Block::Session_client* blk()    { return &_blk;   }
 		Genode::size_t         blk_sz() { return _blk_sz; }
 
+		/**
+		 * Account a chunk that became dirty
+		 */
+		void chunk_dirty()
+		{
+			_dirty++;
+
+			if (_dirty <= _dirty_limit)
+				return;
+
+			_write_back_pending = true;
+			_write_back();
+		}
+
+		/**
+		 * Account a dirty chunk that no longer needs to be written back
+		 */
+		void chunk_clean() { if (_dirty) _dirty--; }
+
+		/**
+		 * Write back the data of a dirty chunk
+		 *
+		 * During a write-back pass, the data of contiguous chunks is
+		 * gathered in one packet. Otherwise, e.g., when a dirty chunk is
+		 * evicted, the data is submitted right away.
+		 *
+		 * \throw Write_failed  backend device is not ready to take the data
+		 */
+		void write_back(Cache::offset_t off, char const *data)
+		{
+			using namespace Genode;
+
+			if (_run.active()
+			 && (off != _run.start + _run.len || _run.len == _run.capacity))
+				_submit_run();
+
+			if (!_run.active()) {
+
+				if (!_blk.tx()->ready_to_submit())
+					throw Write_failed(off);
+
+				/* prefer a packet that takes several chunks */
+				size_t const max_run = _gathering ? MAX_RUN_CHUNKS : 1;
+				for (size_t n = max_run; n && !_run.active(); n /= 4) {
+					try {
+						_run.packet   = _blk.dma_alloc_packet(n*CACHE_BLK_SIZE);
+						_run.capacity = n*CACHE_BLK_SIZE;
+					} catch (Block::Session::Tx::Source::Packet_alloc_failed) { }
+				}
+
+				if (!_run.active())
+					throw Write_failed(off);
+
+				_run.start = off;
+			}
+
+			memcpy(_blk.tx()->packet_content(_run.packet) + _run.len, data,
+			       CACHE_BLK_SIZE);
+			_run.len += CACHE_BLK_SIZE;
+
+			if (_dirty)
+				_dirty--;
+
+			if (!_gathering)
+				_submit_run();
+		}
+
 
 		/****************************
 		 ** Block-driver interface **
@@ -389,7 +741,20 @@ class Driver : public Block::Driver
 			if (!_ops.supported(Block::Packet_descriptor::READ))
 				throw Io_error();
 
-			if (!_stat(block_number, block_count, buffer, packet))
+			bool const hit = _stat(block_number, block_count, buffer, packet);
+
+			if (!_replay) {
+				_reads++;
+				if (!hit) _misses++;
+
+				/* prefetch once a sequential stream is detected */
+				_seq_len  = (block_number == _seq_next) ? _seq_len + 1 : 0;
+				_seq_next = block_number + block_count;
+				if (_seq_len)
+					_read_ahead(_seq_next);
+			}
+
+			if (!hit)
 				return;
 
 			_cache.read(buffer, block_count*_blk_sz, block_number*_blk_sz);
@@ -404,7 +769,12 @@ class Driver : public Block::Driver
 			if (!_ops.supported(Block::Packet_descriptor::WRITE))
 				throw Io_error();
 
-			_cache.alloc(block_count * _blk_sz, block_number * _blk_sz);
+			try {
+				_cache.alloc(block_count * _blk_sz, block_number * _blk_sz);
+			} catch(Write_failed) {
+				/* evicting a dirty chunk stalled on the backend device */
+				throw Request_congestion();
+			}
 
 			if ((block_number % _cache_blk_mod()) &&
 			    !_stat(block_number, 1, const_cast<char* const>(buffer), packet))
@@ -417,8 +787,55 @@ class Driver : public Block::Driver
 
 			_cache.write(buffer, block_count * _blk_sz,
 			             block_number * _blk_sz);
+
+			/* write through to stable storage */
+			if (packet.fua()) {
+				sync(packet);
+				return;
+			}
+
 			ack_packet(packet);
 		}
 
+		void trim(Block::sector_t           block_number,
+		          Genode::size_t            block_count,
+		          Block::Packet_descriptor &packet)
+		{
+			if (!_ops.supported(Block::Packet_descriptor::TRIM))
+				throw Io_error();
+
+			/* dirty chunks trimmed as a whole need not be written back */
+			Block::sector_t const first = _cache_blk_round_up(block_number);
+			Block::sector_t const last  =
+				_cache_blk_round_off(block_number + block_count);
+
+			if (first < last)
+				_cache.discard((last - first) * _blk_sz, first * _blk_sz);
+
+			_forward(Block::Packet_descriptor::TRIM, block_number, block_count,
+			         packet);
+		}
+
 		void sync() { _sync(); }
+
+		bool fua_supported() { return true; }
+
+		/*
+		 * The request is completed asynchronously. Blocking for the backend
+		 * device is not an option because the request may be issued while
+		 * handling a reply of the backend, e.g., for a FUA write.
+		 */
+		void sync(Block::Packet_descriptor &packet)
+		{
+			if (_sync_pending)
+				throw Request_congestion();
+
+			_sync_packet  = packet;
+			_sync_pending = true;
+
+			/* a complete pass covers all chunks dirty by now */
+			_write_back_pending = true;
+			_write_back_cursor  = 0;
+			_write_back();
+		}
 };
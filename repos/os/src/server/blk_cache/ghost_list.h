@@ -0,0 +1,145 @@
+/*
+ * \brief  History of recently evicted chunks
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _GHOST_LIST_H_
+#define _GHOST_LIST_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <util/noncopyable.h>
+
+/* local includes */
+#include "chunk.h"
+
+namespace Cache { class Ghost_list; }
+
+
+/**
+ * Bounded FIFO of the offsets of evicted chunks
+ *
+ * Adaptive replacement policies use the history of evicted chunks to
+ * recognize chunks that are accessed again shortly after their eviction.
+ * The history retains the offsets only. Once the capacity is reached,
+ * each insertion drops the oldest entry. Lookup and removal by offset
+ * are performed via a hash table.
+ */
+class Cache::Ghost_list : Genode::Noncopyable
+{
+	private:
+
+		enum : unsigned { NONE = ~0U };
+
+		struct Slot
+		{
+			offset_t off;
+			unsigned next;   /* next slot of the same hash bucket */
+			bool     valid;
+		};
+
+		Slot     *_slots       = nullptr;
+		unsigned *_buckets     = nullptr;
+		unsigned  _capacity    = 0;
+		unsigned  _num_buckets = 0;
+		unsigned  _head        = 0;   /* slot used by the next insertion */
+		unsigned  _count       = 0;
+
+		unsigned _bucket(offset_t off) const
+		{
+			/* offsets are multiples of the chunk size */
+			Genode::uint64_t const key = off >> 12;
+			return (unsigned)(key ^ (key >> 20)) & (_num_buckets - 1);
+		}
+
+		void _unlink(unsigned slot)
+		{
+			for (unsigned *i = &_buckets[_bucket(_slots[slot].off)];
+			     *i != NONE; i = &_slots[*i].next) {
+
+				if (*i != slot)
+					continue;
+
+				*i = _slots[slot].next;
+				_slots[slot].valid = false;
+				_count--;
+				return;
+			}
+		}
+
+	public:
+
+		/**
+		 * Allocate the history for up to 'capacity' entries
+		 *
+		 * Repeated calls have no effect.
+		 */
+		void init(Genode::Allocator &alloc, unsigned capacity)
+		{
+			if (_capacity || !capacity)
+				return;
+
+			_num_buckets = 1;
+			while (_num_buckets < capacity)
+				_num_buckets <<= 1;
+
+			_slots   = (Slot *)alloc.alloc(capacity*sizeof(Slot));
+			_buckets = (unsigned *)alloc.alloc(_num_buckets*sizeof(unsigned));
+
+			for (unsigned i = 0; i < capacity; i++)
+				_slots[i] = Slot { 0, NONE, false };
+
+			for (unsigned i = 0; i < _num_buckets; i++)
+				_buckets[i] = NONE;
+
+			_capacity = capacity;
+		}
+
+		unsigned count() const { return _count; }
+
+		void insert(offset_t off)
+		{
+			if (!_capacity)
+				return;
+
+			if (_slots[_head].valid)
+				_unlink(_head);
+
+			unsigned &bucket = _buckets[_bucket(off)];
+
+			_slots[_head] = Slot { off, bucket, true };
+			bucket = _head;
+			_count++;
+
+			_head = (_head + 1) % _capacity;
+		}
+
+		/**
+		 * Remove entry for offset
+		 *
+		 * \return true if the history contained the offset
+		 */
+		bool remove(offset_t off)
+		{
+			if (!_capacity)
+				return false;
+
+			for (unsigned i = _buckets[_bucket(off)]; i != NONE; i = _slots[i].next) {
+				if (_slots[i].off == off) {
+					_unlink(i);
+					return true;
+				}
+			}
+			return false;
+		}
+};
+
+#endif /* _GHOST_LIST_H_ */
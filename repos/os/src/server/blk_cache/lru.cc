@@ -16,19 +16,12 @@
 
 typedef Driver<Lru_policy>::Chunk_level_4 Chunk;
 
-static const Lru_policy::Element        *lru = 0;
-static Genode::List<Lru_policy::Element> lru_list;
+/* the head of the list is the most recently used chunk */
+static Cache::Chunk_list lru_list;
 
 
-static void lru_access(const Lru_policy::Element *e)
-{
-	if (e == lru) return;
-
-	if (e->next()) lru_list.remove(e);
-
-	lru_list.insert(e, lru);
-	lru = e;
-}
+static void lru_access(const Lru_policy::Element *e) {
+	lru_list.insert_head(const_cast<Lru_policy::Element *>(e)); }
 
 
 void Lru_policy::read(const Lru_policy::Element  *e) {
@@ -39,24 +32,25 @@ void Lru_policy::write(const Lru_policy::Element *e) {
 	lru_access(e); }
 
 
+void Lru_policy::fill(const Lru_policy::Element  *e) {
+	lru_access(e); }
+
+
 void Lru_policy::flush(Cache::size_t size)
 {
 	Cache::size_t s = 0;
-	for (Lru_policy::Element *e = lru_list.first();
-		 e && ((size == 0) || (s < size));
-		 e = lru_list.first(), s += sizeof(Chunk)) {
-		Chunk *cb = static_cast<Chunk*>(e);
-		e = e->next();
+	while (lru_list.tail() && ((size == 0) || (s < size))) {
+		Chunk *cb = static_cast<Chunk*>(
+			static_cast<Lru_policy::Element*>(lru_list.tail()));
 		try {
+			/* freeing the chunk removes it from the list */
 			cb->free(Driver<Lru_policy>::CACHE_BLK_SIZE,
 			         cb->base_offset());
-			lru_list.remove(cb);
+			s += sizeof(Chunk);
 		} catch(Chunk::Dirty_chunk &e) {
 			cb->sync(e.size, e.off);
 		}
 	}
 
-	if (!lru_list.first()) lru = 0;
-
 	if (s < size) throw Block::Driver::Request_congestion();
 }
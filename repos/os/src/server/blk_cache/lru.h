@@ -11,15 +11,19 @@
  * under the terms of the GNU Affero General Public License version 3.
  */
 
-#include <util/list.h>
+#include <base/allocator.h>
 
 #include "chunk.h"
+#include "chunk_list.h"
 
 struct Lru_policy
 {
-	class Element : public Genode::List<Element>::Element {};
+	class Element : public Cache::Chunk_list::Element {};
+
+	static void init(Genode::Allocator &, Cache::size_t max_chunks) { }
 
 	static void read(const Element  *e);
 	static void write(const Element *e);
+	static void fill(const Element  *e);
 	static void flush(Cache::size_t size = 0);
 };
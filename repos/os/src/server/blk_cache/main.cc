@@ -11,37 +11,62 @@
  * under the terms of the GNU Affero General Public License version 3.
  */
 
+#include <base/attached_rom_dataspace.h>
 #include <base/component.h>
 
 #include "lru.h"
+#include "arc.h"
+#include "two_queue.h"
 #include "driver.h"
 
-using Policy = Lru_policy;
-static Driver<Policy> * driver = nullptr;
+
+/**
+ * Return driver instance using the given replacement policy
+ */
+template <typename POLICY>
+static Driver<POLICY> *&driver()
+{
+	static Driver<POLICY> *instance = nullptr;
+	return instance;
+}
 
 
 /**
  * Synchronize a chunk with the backend device
  */
 template <typename POLICY>
-void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *dst)
+void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *src)
 {
 	Cache::offset_t off =
 		static_cast<const Driver<POLICY>::Chunk_level_4*>(e)->base_offset();
 
+	Driver<POLICY> * const driver = ::driver<POLICY>();
+
 	if (!driver) throw Write_failed(off);
 
-	if (!driver->blk()->tx()->ready_to_submit())
-		throw Write_failed(off);
-	try {
-		Block::Packet_descriptor
-			p(driver->blk()->dma_alloc_packet(Driver::CACHE_BLK_SIZE),
-		      Block::Packet_descriptor::WRITE, off / driver->blk_sz(),
-		      Driver::CACHE_BLK_SIZE / driver->blk_sz());
-		driver->blk()->tx()->submit_packet(p);
-	} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
-		throw Write_failed(off);
-	}
+	driver->write_back(off, src);
+}
+
+
+/**
+ * Account a chunk that became dirty
+ */
+template <typename POLICY>
+void Driver<POLICY>::Policy::dirty(const typename POLICY::Element *)
+{
+	if (Driver<POLICY> * const driver = ::driver<POLICY>())
+		driver->chunk_dirty();
+}
+
+
+/**
+ * Account a dirty chunk that was discarded
+ */
+template <typename POLICY>
+void Driver<POLICY>::Policy::clean(const typename POLICY::Element *)
+{
+	if (Driver<POLICY> * const driver = ::driver<POLICY>())
+		driver->chunk_clean();
 }
 
 
@@ -50,27 +75,67 @@ struct Main
 	template <typename T>
 	struct Factory : Block::Driver_factory
 	{
-		Genode::Env  &env;
-		Genode::Heap &heap;
+		Genode::Env         &env;
+		Genode::Heap        &heap;
+		Driver_config const  config;
 
-		Factory(Genode::Env &env, Genode::Heap &heap) : env(env), heap(heap) {}
+		Factory(Genode::Env &env, Genode::Heap &heap, Driver_config config)
+		: env(env), heap(heap), config(config) {}
 
 		Block::Driver *create()
 		{
-			driver = new (&heap) ::Driver<T>(env, heap);
-			return driver;
+			driver<T>() = new (&heap) ::Driver<T>(env, heap, config);
+			return driver<T>();
 		}
 
-		void destroy(Block::Driver *driver) {
-			Genode::destroy(&heap, static_cast<::Driver<T>*>(driver)); }
+		void destroy(Block::Driver *driver)
+		{
+			Genode::destroy(&heap, static_cast<::Driver<T>*>(driver));
+			::driver<T>() = nullptr;
+		}
 	};
 
 	void resource_handler() { }
 
+	typedef Genode::String<16> Policy_name;
+
+	struct Config
+	{
+		Policy_name   policy { "lru" };
+		Driver_config driver { false, 8, 25 };
+
+		Config(Genode::Env &env)
+		{
+			try {
+				Genode::Attached_rom_dataspace rom(env, "config");
+				Genode::Xml_node const config = rom.xml();
+
+				policy             = config.attribute_value("policy",      policy);
+				driver.verbose     = config.attribute_value("verbose",     driver.verbose);
+				driver.read_ahead  = config.attribute_value("read_ahead",  driver.read_ahead);
+				driver.dirty_ratio = config.attribute_value("dirty_ratio", driver.dirty_ratio);
+			} catch (...) { }
+		}
+	};
+
 	Genode::Env                 &env;
+	Config const                 config  { env };
 	Genode::Heap                 heap    { env.ram(), env.rm()     };
-	Factory<Lru_policy>          factory { env, heap               };
-	Block::Root                  root    { env.ep(), heap, env.rm(), factory, true };
+	Factory<Lru_policy>          lru_factory       { env, heap, config.driver };
+	Factory<Arc_policy>          arc_factory       { env, heap, config.driver };
+	Factory<Two_queue_policy>    two_queue_factory { env, heap, config.driver };
+
+	Block::Driver_factory &_factory()
+	{
+		if (config.policy == "arc") return arc_factory;
+		if (config.policy == "2q")  return two_queue_factory;
+		if (config.policy != "lru")
+			Genode::warning("unknown policy '", config.policy, "', using LRU");
+
+		return lru_factory;
+	}
+
+	Block::Root                  root    { env.ep(), heap, env.rm(), _factory(), true };
 	Genode::Signal_handler<Main> resource_dispatcher {
 		env.ep(), *this, &Main::resource_handler };
 
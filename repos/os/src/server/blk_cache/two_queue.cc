@@ -0,0 +1,103 @@
+/*
+ * \brief  2Q cache replacement strategy
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The implementation follows Johnson and Shasha, "2Q: A Low Overhead High
+ * Performance Buffer Management Replacement Algorithm" using the suggested
+ * sizes of a quarter of the cache for the FIFO queue and half of the cache
+ * for the history of chunks evicted from the queue.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include "two_queue.h"
+#include "driver.h"
+#include "ghost_list.h"
+
+typedef Driver<Two_queue_policy>::Chunk_level_4 Chunk;
+
+static Cache::Chunk_list probation;   /* A1in, FIFO of new chunks */
+static Cache::Chunk_list main_lru;    /* Am, LRU of hot chunks    */
+static Cache::Ghost_list history;     /* A1out                    */
+
+static unsigned long probation_max = 0;
+
+
+static void two_queue_access(const Two_queue_policy::Element *ce)
+{
+	Two_queue_policy::Element &e = const_cast<Two_queue_policy::Element &>(*ce);
+
+	/* accesses during probation are considered as correlated */
+	if (e.list() == &probation)
+		return;
+
+	if (e.list() == &main_lru) {
+		main_lru.insert_head(&e);
+		return;
+	}
+
+	Cache::offset_t const off = static_cast<Chunk &>(e).base_offset();
+
+	if (history.remove(off))
+		main_lru.insert_head(&e);
+	else
+		probation.insert_head(&e);
+}
+
+
+void Two_queue_policy::init(Genode::Allocator &alloc, Cache::size_t max_chunks)
+{
+	if (probation_max)
+		return;
+
+	probation_max = Genode::max(max_chunks/4, (Cache::size_t)1);
+	history.init(alloc, max_chunks/2);
+}
+
+
+void Two_queue_policy::read(const Two_queue_policy::Element  *e) {
+	two_queue_access(e); }
+
+
+void Two_queue_policy::write(const Two_queue_policy::Element *e) {
+	two_queue_access(e); }
+
+
+void Two_queue_policy::fill(const Two_queue_policy::Element  *e) {
+	two_queue_access(e); }
+
+
+void Two_queue_policy::flush(Cache::size_t size)
+{
+	Cache::size_t s = 0;
+	while ((probation.count() || main_lru.count()) && ((size == 0) || (s < size))) {
+
+		bool const from_probation = probation.count()
+		                         && (probation.count() > probation_max
+		                          || !main_lru.count());
+
+		Chunk *cb = static_cast<Chunk*>(static_cast<Two_queue_policy::Element*>(
+			from_probation ? probation.tail() : main_lru.tail()));
+
+		Cache::offset_t const off = cb->base_offset();
+		try {
+			/* freeing the chunk removes it from its list */
+			cb->free(Driver<Two_queue_policy>::CACHE_BLK_SIZE, off);
+			s += sizeof(Chunk);
+
+			if (from_probation)
+				history.insert(off);
+
+		} catch(Chunk::Dirty_chunk &e) {
+			cb->sync(e.size, e.off);
+		}
+	}
+
+	if (s < size) throw Block::Driver::Request_congestion();
+}
@@ -0,0 +1,38 @@
+/*
+ * \brief  2Q cache replacement strategy
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/allocator.h>
+
+#include "chunk.h"
+#include "chunk_list.h"
+
+/**
+ * Replacement strategy that admits chunks to the main LRU list only when
+ * accessed again after a probation period
+ *
+ * Newly cached chunks enter a FIFO queue. Chunks evicted from this queue
+ * are remembered for a while, and if accessed again, they are admitted to
+ * the main list. Chunks touched only once, e.g., by a scan, never displace
+ * chunks of the main list.
+ */
+struct Two_queue_policy
+{
+	class Element : public Cache::Chunk_list::Element {};
+
+	static void init(Genode::Allocator &alloc, Cache::size_t max_chunks);
+
+	static void read(const Element  *e);
+	static void write(const Element *e);
+	static void fill(const Element  *e);
+	static void flush(Cache::size_t size = 0);
+};
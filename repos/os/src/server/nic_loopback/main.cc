@@ -52,7 +52,11 @@ class Nic_loopback::Session_component : public Nic::Session_component
 		:
 			Nic::Session_component(tx_buf_size, rx_buf_size, rx_block_md_alloc,
 			                       env)
-		{ }
+		{
+			/* the packet streams are handled by the entrypoint only */
+			_tx.sink()->single_threaded();
+			_rx.source()->single_threaded();
+		}
 
 		Nic::Mac_address mac_address() override
 		{
@@ -75,66 +79,76 @@ void Nic_loopback::Session_component::_handle_packet_stream()
 {
 	size_t const alloc_size = Nic::Packet_allocator::DEFAULT_PACKET_SIZE;
 
+	/*
+	 * Packets are processed in batches to notify the client only once per
+	 * batch instead of once per packet.
+	 */
+	enum { BURST = 32 };
+
+	Packet_descriptor packets[BURST];
+	Packet_descriptor echoes[BURST];
+
 	/* loop while we can make progress */
 	for (;;) {
 
 		/* flush acknowledgements for the echoes packets */
-		while (_rx.source()->ack_avail())
-			_rx.source()->release_packet(_rx.source()->get_acked_packet());
+		for (unsigned n; (n = _rx.source()->get_acked_packets(packets, BURST)); )
+			for (unsigned i = 0; i < n; i++)
+				_rx.source()->release_packet(packets[i]);
 
 		/*
-		 * If the client cannot accept new acknowledgements for a sent packets,
-		 * we won't consume the sent packet.
+		 * We won't consume more sent packets than the client can accept as
+		 * acknowledgements and echoes, so that we never block.
 		 */
-		if (!_tx.sink()->ready_to_ack())
-			return;
+		unsigned const limit = min((unsigned)BURST,
+		                           min(_tx.sink()->ack_slots_free(),
+		                               _rx.source()->submit_slots_free()));
 
 		/*
-		 * Nothing to be done if the client has not sent any packets.
+		 * Allocate the echoes before obtaining the sent packets. If the
+		 * client fails to pick up the packets from the rx channel, we have
+		 * to wait for its acknowledgements.
 		 */
-		if (!_tx.sink()->packet_avail())
-			return;
+		unsigned num_allocated = 0;
+		try {
+			for (; num_allocated < limit; num_allocated++)
+				echoes[num_allocated] = _rx.source()->alloc_packet(alloc_size);
+		}
+		catch (Session::Rx::Source::Packet_alloc_failed) { }
 
-		/*
-		 * Here we know that the client has submitted a packet to us and is also
-		 * able it receive the corresponding acknowledgement.
-		 */
+		/* obtain packets */
+		unsigned const num_packets = _tx.sink()->get_packets(packets, num_allocated);
+
+		for (unsigned i = num_packets; i < num_allocated; i++)
+			_rx.source()->release_packet(echoes[i]);
 
 		/*
-		 * The client fails to pick up the packets from the rx channel. So we
-		 * won't try to submit new packets.
+		 * Nothing to be done if the client has not sent any packets.
 		 */
-		if (!_rx.source()->ready_to_submit())
+		if (!num_packets)
 			return;
 
-		/*
-		 * We are safe to process one packet without blocking.
-		 */
+		unsigned num_echoes = 0;
+		for (unsigned i = 0; i < num_packets; i++) {
 
+			Packet_descriptor const &packet_from_client = packets[i];
 
-		Packet_descriptor packet_to_client;
-		try {
-			packet_to_client = _rx.source()->alloc_packet(alloc_size); }
-		catch (Session::Rx::Source::Packet_alloc_failed) {
-			continue; }
-
-		/* obtain packet */
-		Packet_descriptor const packet_from_client = _tx.sink()->get_packet();
-		if (!packet_from_client.size()) {
-			warning("received zero-size packet");
-			_rx.source()->release_packet(packet_to_client);
-			continue;
-		}
+			if (!packet_from_client.size()) {
+				warning("received zero-size packet");
+				_rx.source()->release_packet(echoes[i]);
+				continue;
+			}
 
-		memcpy(_rx.source()->packet_content(packet_to_client),
-		       _tx.sink()->packet_content(packet_from_client),
-		       packet_from_client.size());
+			memcpy(_rx.source()->packet_content(echoes[i]),
+			       _tx.sink()->packet_content(packet_from_client),
+			       packet_from_client.size());
 
-		packet_to_client = Packet_descriptor(packet_to_client.offset(),
-		                                     packet_from_client.size());
-		_rx.source()->submit_packet(packet_to_client);
+			echoes[num_echoes++] = Packet_descriptor(echoes[i].offset(),
+			                                         packet_from_client.size());
+		}
 
-		_tx.sink()->acknowledge_packet(packet_from_client);
+		_rx.source()->submit_packets(echoes, num_echoes);
+		_tx.sink()->acknowledge_packets(packets, num_packets);
 	}
 }
 
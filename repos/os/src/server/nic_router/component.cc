@@ -38,38 +38,109 @@ Communication_buffer::Communication_buffer(Ram_session          &ram,
  ****************************/
 
 Session_component_base::
-Session_component_base(Allocator    &guarded_alloc_backing,
-                       size_t const  guarded_alloc_amount,
-                       Ram_session  &buf_ram,
-                       size_t const  tx_buf_size,
-                       size_t const  rx_buf_size)
+Session_component_base(Allocator                     &guarded_alloc_backing,
+                       size_t                  const  guarded_alloc_amount,
+                       Cap_quota               const  cap_quota,
+                       Ram_session                   &buf_ram,
+                       size_t                  const  tx_buf_size,
+                       size_t                  const  rx_buf_size,
+                       Pointer<Zero_copy_pool> const  zero_copy_pool)
 :
 	_guarded_alloc(&guarded_alloc_backing, guarded_alloc_amount),
-	_range_alloc(&_guarded_alloc), _tx_buf(buf_ram, tx_buf_size),
-	_rx_buf(buf_ram, rx_buf_size)
-{ }
+	_range_alloc(&_guarded_alloc), _zero_copy_pool(zero_copy_pool),
+	_zero_copy_ram_guard(Ram_quota { guarded_alloc_amount - rx_buf_size }),
+	_zero_copy_cap_guard(_zero_copy_caps(cap_quota)),
+	_zero_copy_ram(buf_ram, _zero_copy_ram_guard, _zero_copy_cap_guard),
+	_tx_slot(_alloc_tx_slot(tx_buf_size)), _rx_buf(buf_ram, rx_buf_size)
+{
+	if (!_tx_slot) {
+		_tx_buf.construct(buf_ram, tx_buf_size); }
+
+	try { _init_zero_copy_rx(rx_buf_size); }
+	catch (Pointer<Zero_copy_pool>::Invalid) { }
+	catch (Out_of_ram)  { warning("failed to map zero-copy pool, out of RAM"); }
+	catch (Out_of_caps) { warning("failed to map zero-copy pool, out of caps"); }
+
+	/* the quota consumed for zero-copy forwarding is not left for links */
+	_guarded_alloc.withdraw(_zero_copy_ram_guard.used().value);
+}
+
+
+Cap_quota Session_component_base::_zero_copy_caps(Cap_quota const cap_quota)
+{
+	/* the session itself consumes the quota of a regular NIC session */
+	size_t const session_caps = Nic::Session::CAP_QUOTA;
+	return Cap_quota { cap_quota.value > session_caps ?
+	                   cap_quota.value - session_caps : 0 };
+}
+
+
+void Session_component_base::_init_zero_copy_rx(size_t const rx_buf_size)
+{
+	Zero_copy_pool &pool = _zero_copy_pool.deref();
+
+	Ram_quota_guard::Reservation ram (_zero_copy_ram_guard,
+	                                  Ram_quota { Zero_copy_rx::RAM_QUOTA });
+	Cap_quota_guard::Reservation caps(_zero_copy_cap_guard,
+	                                  Cap_quota { Zero_copy_rx::CAP_QUOTA });
+
+	size_t const rx_local_size = align_addr(rx_buf_size, 12);
+	_zero_copy_rx.construct(pool, _rx_buf, rx_local_size);
+	_range_alloc.limit(rx_local_size);
+
+	ram. acknowledge();
+	caps.acknowledge();
+}
+
+
+Zero_copy_slot *Session_component_base::_alloc_tx_slot(size_t const size)
+{
+	try { return _zero_copy_pool.deref().alloc_slot(size, _zero_copy_ram); }
+	catch (Pointer<Zero_copy_pool>::Invalid) { return nullptr; }
+	catch (Out_of_ram)  { warning("no zero-copy slot, out of RAM");  }
+	catch (Out_of_caps) { warning("no zero-copy slot, out of caps"); }
+	return nullptr;
+}
+
+
+Dataspace_capability Session_component_base::_tx_ds()
+{
+	return _tx_slot ? _tx_slot->dataspace() : *_tx_buf;
+}
+
+
+Dataspace_capability Session_component_base::_rx_ds()
+{
+	return _zero_copy_rx.constructed() ? _zero_copy_rx->dataspace() : _rx_buf;
+}
 
 
 /***********************
  ** Session_component **
  ***********************/
 
-Net::Session_component::Session_component(Allocator         &alloc,
-                                          Timer::Connection &timer,
-                                          size_t      const  amount,
-                                          Ram_session       &buf_ram,
-                                          size_t      const  tx_buf_size,
-                                          size_t      const  rx_buf_size,
-                                          Region_map        &region_map,
-                                          Mac_address const  mac,
-                                          Entrypoint        &ep,
-                                          Mac_address const &router_mac,
-                                          Domain            &domain)
+Net::Session_component::Session_component(Allocator                     &alloc,
+                                          Timer::Connection             &timer,
+                                          size_t                  const  amount,
+                                          Cap_quota               const  cap_quota,
+                                          Ram_session                   &buf_ram,
+                                          size_t                  const  tx_buf_size,
+                                          size_t                  const  rx_buf_size,
+                                          Region_map                    &region_map,
+                                          Mac_address             const  mac,
+                                          Entrypoint                    &ep,
+                                          Mac_address             const &router_mac,
+                                          Domain                        &domain,
+                                          Pointer<Zero_copy_pool> const  zero_copy_pool)
 :
-	Session_component_base(alloc, amount, buf_ram, tx_buf_size, rx_buf_size),
-	Session_rpc_object(region_map, _tx_buf, _rx_buf, &_range_alloc, ep.rpc_ep()),
+	Session_component_base(alloc, amount, cap_quota, buf_ram, tx_buf_size,
+	                       rx_buf_size, zero_copy_pool),
+	Session_rpc_object(region_map, _tx_ds(), _rx_ds(), &_range_alloc, ep.rpc_ep()),
 	Interface(ep, timer, router_mac, _guarded_alloc, mac, domain)
 {
+	if (_tx_slot) {
+		_tx_slot->owner(this); }
+
 	_tx.sigh_ready_to_ack(_sink_ack);
 	_tx.sigh_packet_avail(_sink_submit);
 	_rx.sigh_ack_avail(_source_ack);
@@ -78,21 +149,33 @@ Net::Session_component::Session_component(Allocator         &alloc,
 }
 
 
+Net::Session_component::~Session_component()
+{
+	/* return packets of other sessions and stop receiving acknowledgements */
+	if (_zero_copy_rx.constructed()) {
+		_zero_copy_rx->flush(); }
+
+	if (_tx_slot) {
+		_zero_copy_pool.deref().free_slot(*_tx_slot); }
+}
+
+
 /**********
  ** Root **
  **********/
 
-Net::Root::Root(Entrypoint        &ep,
-                Timer::Connection &timer,
-                Allocator         &alloc,
-                Mac_address const &router_mac,
-                Configuration     &config,
-                Ram_session       &buf_ram,
-                Region_map        &region_map)
+Net::Root::Root(Entrypoint                    &ep,
+                Timer::Connection             &timer,
+                Allocator                     &alloc,
+                Mac_address             const &router_mac,
+                Configuration                 &config,
+                Ram_session                   &buf_ram,
+                Region_map                    &region_map,
+                Pointer<Zero_copy_pool> const  zero_copy_pool)
 :
 	Root_component<Session_component>(&ep.rpc_ep(), &alloc), _timer(timer),
 	_ep(ep), _router_mac(router_mac), _config(config), _buf_ram(buf_ram),
-	_region_map(region_map)
+	_region_map(region_map), _zero_copy_pool(zero_copy_pool)
 { }
 
 
@@ -129,9 +212,10 @@ Session_component *Net::Root::_create_session(char const *args)
 		}
 		return new (md_alloc())
 			Session_component(*md_alloc(), _timer, ram_quota - session_size,
+			                  cap_quota_from_args(args),
 			                  _buf_ram, tx_buf_size, rx_buf_size, _region_map,
 			                  _mac_alloc.alloc(), _ep, _router_mac,
-			                  domain);
+			                  domain, _zero_copy_pool);
 	}
 	catch (Session_policy::No_policy_defined) {
 		error("no matching policy");
@@ -150,3 +234,9 @@ Session_component *Net::Root::_create_session(char const *args)
 	}
 	throw Service_denied();
 }
+
+
+void Net::Root::_upgrade_session(Session_component *session, char const *args)
+{
+	session->upgrade_ram(Arg_string::find_arg(args, "ram_quota").ulong_value(0));
+}
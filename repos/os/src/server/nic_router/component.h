@@ -16,6 +16,7 @@
 
 /* Genode includes */
 #include <base/allocator_guard.h>
+#include <base/ram_allocator.h>
 #include <root/component.h>
 #include <nic/packet_allocator.h>
 #include <nic_session/rpc_object.h>
@@ -23,11 +24,13 @@
 
 /* local includes */
 #include <interface.h>
+#include <zero_copy.h>
 
 namespace Net {
 
 	class Domain;
 	class Communication_buffer;
+	class Rx_packet_allocator;
 	class Session_component_base;
 	class Session_component;
 	class Root;
@@ -49,22 +52,85 @@ class Net::Communication_buffer : public Genode::Ram_dataspace_capability
 };
 
 
+/**
+ * Allocator for packets in the session-local part of an RX buffer
+ *
+ * If the RX buffer maps the zero-copy pool behind the session-local memory,
+ * the packet-stream source must not allocate packets within the pool.
+ */
+class Net::Rx_packet_allocator : public Nic::Packet_allocator
+{
+	private:
+
+		Genode::addr_t _limit = ~(Genode::addr_t)0;
+
+	public:
+
+		Rx_packet_allocator(Genode::Allocator *md_alloc)
+		: Nic::Packet_allocator(md_alloc) { }
+
+		void limit(Genode::addr_t const limit) { _limit = limit; }
+
+
+		/*********************
+		 ** Range_allocator **
+		 *********************/
+
+		int add_range(Genode::addr_t base, Genode::size_t size) override
+		{
+			return Nic::Packet_allocator::add_range(base,
+				Genode::min(size, (Genode::size_t)(_limit - base)));
+		}
+};
+
+
 class Net::Session_component_base
 {
 	protected:
 
-		Genode::Allocator_guard _guarded_alloc;
-		Nic::Packet_allocator   _range_alloc;
-		Communication_buffer    _tx_buf;
-		Communication_buffer    _rx_buf;
+		Genode::Allocator_guard                     _guarded_alloc;
+		Rx_packet_allocator                         _range_alloc;
+		Pointer<Zero_copy_pool>              const  _zero_copy_pool;
+		Genode::Ram_quota_guard                     _zero_copy_ram_guard;
+		Genode::Cap_quota_guard                     _zero_copy_cap_guard;
+		Genode::Constrained_ram_allocator           _zero_copy_ram;
+		Zero_copy_slot                      *const  _tx_slot;
+		Genode::Constructible<Communication_buffer> _tx_buf;
+		Communication_buffer                        _rx_buf;
+		Genode::Constructible<Zero_copy_rx>         _zero_copy_rx;
+
+		static Genode::Cap_quota _zero_copy_caps(Genode::Cap_quota const cap_quota);
+
+		Zero_copy_slot *_alloc_tx_slot(Genode::size_t const size);
+
+		void _init_zero_copy_rx(Genode::size_t const rx_buf_size);
+
+		Genode::Dataspace_capability _tx_ds();
+		Genode::Dataspace_capability _rx_ds();
 
 	public:
 
-		Session_component_base(Genode::Allocator    &guarded_alloc_backing,
-		                       Genode::size_t const  guarded_alloc_amount,
-		                       Genode::Ram_session  &buf_ram,
-		                       Genode::size_t const  tx_buf_size,
-		                       Genode::size_t const  rx_buf_size);
+		/**
+		 * Constructor
+		 *
+		 * \param cap_quota  capabilities donated by the client, the part
+		 *                   beyond the needs of the session is used to
+		 *                   account the resources for zero-copy forwarding
+		 */
+		Session_component_base(Genode::Allocator             &guarded_alloc_backing,
+		                       Genode::size_t          const  guarded_alloc_amount,
+		                       Genode::Cap_quota       const  cap_quota,
+		                       Genode::Ram_session           &buf_ram,
+		                       Genode::size_t          const  tx_buf_size,
+		                       Genode::size_t          const  rx_buf_size,
+		                       Pointer<Zero_copy_pool> const  zero_copy_pool);
+
+		/**
+		 * Account additional RAM donated by the client, e.g., for the
+		 * state of a large number of links
+		 */
+		void upgrade_ram(Genode::size_t const amount) {
+			_guarded_alloc.upgrade(amount); }
 };
 
 
@@ -81,19 +147,28 @@ class Net::Session_component : public Session_component_base,
 		Packet_stream_sink   &_sink()   { return *_tx.sink(); }
 		Packet_stream_source &_source() { return *_rx.source(); }
 
+		Zero_copy_slot *_zero_copy_tx_slot() override { return _tx_slot; }
+
+		Zero_copy_rx *_zero_copy_rx_state() override {
+			return _zero_copy_rx.constructed() ? &*_zero_copy_rx : nullptr; }
+
 	public:
 
-		Session_component(Genode::Allocator    &alloc,
-		                  Timer::Connection    &timer,
-		                  Genode::size_t const  amount,
-		                  Genode::Ram_session  &buf_ram,
-		                  Genode::size_t const  tx_buf_size,
-		                  Genode::size_t const  rx_buf_size,
-		                  Genode::Region_map   &region_map,
-		                  Mac_address    const  mac,
-		                  Genode::Entrypoint   &ep,
-		                  Mac_address    const &router_mac,
-		                  Domain               &domain);
+		Session_component(Genode::Allocator             &alloc,
+		                  Timer::Connection             &timer,
+		                  Genode::size_t          const  amount,
+		                  Genode::Cap_quota       const  cap_quota,
+		                  Genode::Ram_session           &buf_ram,
+		                  Genode::size_t          const  tx_buf_size,
+		                  Genode::size_t          const  rx_buf_size,
+		                  Genode::Region_map            &region_map,
+		                  Mac_address             const  mac,
+		                  Genode::Entrypoint            &ep,
+		                  Mac_address             const &router_mac,
+		                  Domain                        &domain,
+		                  Pointer<Zero_copy_pool> const  zero_copy_pool);
+
+		~Session_component();
 
 
 		/******************
@@ -110,13 +185,14 @@ class Net::Root : public Genode::Root_component<Session_component>
 {
 	private:
 
-		Timer::Connection   &_timer;
-		Mac_allocator        _mac_alloc;
-		Genode::Entrypoint  &_ep;
-		Mac_address const    _router_mac;
-		Configuration       &_config;
-		Genode::Ram_session &_buf_ram;
-		Genode::Region_map  &_region_map;
+		Timer::Connection             &_timer;
+		Mac_allocator                  _mac_alloc;
+		Genode::Entrypoint            &_ep;
+		Mac_address             const  _router_mac;
+		Configuration                 &_config;
+		Genode::Ram_session           &_buf_ram;
+		Genode::Region_map            &_region_map;
+		Pointer<Zero_copy_pool> const  _zero_copy_pool;
 
 
 		/********************
@@ -125,15 +201,18 @@ class Net::Root : public Genode::Root_component<Session_component>
 
 		Session_component *_create_session(char const *args);
 
+		void _upgrade_session(Session_component *session, char const *args);
+
 	public:
 
-		Root(Genode::Entrypoint  &ep,
-		     Timer::Connection   &timer,
-		     Genode::Allocator   &alloc,
-		     Mac_address const   &router_mac,
-		     Configuration       &config,
-		     Genode::Ram_session &buf_ram,
-		     Genode::Region_map  &region_map);
+		Root(Genode::Entrypoint            &ep,
+		     Timer::Connection             &timer,
+		     Genode::Allocator             &alloc,
+		     Mac_address             const &router_mac,
+		     Configuration                 &config,
+		     Genode::Ram_session           &buf_ram,
+		     Genode::Region_map            &region_map,
+		     Pointer<Zero_copy_pool> const  zero_copy_pool);
 };
 
 #endif /* _COMPONENT_H_ */
@@ -42,9 +42,9 @@ static void _destroy_closed_links(Link_list   &closed_links,
 
 
 template <typename LINK_TYPE>
-static void _destroy_links(Link_side_tree &links,
-                           Link_list      &closed_links,
-                           Deallocator    &dealloc)
+static void _destroy_links(Link_side_table &links,
+                           Link_list       &closed_links,
+                           Deallocator     &dealloc)
 {
 	_destroy_closed_links<LINK_TYPE>(closed_links, dealloc);
 	while (Link_side *link_side = links.first()) {
@@ -76,23 +76,6 @@ static void _link_packet(L3_protocol  const  prot,
 }
 
 
-static void _update_checksum(L3_protocol   const prot,
-                             void         *const prot_base,
-                             size_t        const prot_size,
-                             Ipv4_address  const src,
-                             Ipv4_address  const dst)
-{
-	switch (prot) {
-	case L3_protocol::TCP:
-		((Tcp_packet *)prot_base)->update_checksum(src, dst, prot_size);
-		return;
-	case L3_protocol::UDP:
-		((Udp_packet *)prot_base)->update_checksum(src, dst);
-		return;
-	default: throw Interface::Bad_transport_protocol(); }
-}
-
-
 static Port _dst_port(L3_protocol const prot, void *const prot_base)
 {
 	switch (prot) {
@@ -144,6 +127,30 @@ static void *_prot_base(L3_protocol const  prot,
 }
 
 
+/**
+ * Adapt transport checksum to the rewritten addresses and ports
+ *
+ * As the router modifies only a few header fields, it is sufficient to update
+ * the checksum incrementally instead of summing up the whole packet again.
+ */
+static void _update_checksum(L3_protocol   const  prot,
+                             void         *const  prot_base,
+                             Link_side_id  const &old_id,
+                             Ipv4_packet   const &ip)
+{
+	Internet_checksum_diff diff;
+	diff.add_up_diff(old_id.src_ip, ip.src());
+	diff.add_up_diff(old_id.dst_ip, ip.dst());
+	diff.add_up_diff(old_id.src_port.value, _src_port(prot, prot_base).value);
+	diff.add_up_diff(old_id.dst_port.value, _dst_port(prot, prot_base).value);
+
+	switch (prot) {
+	case L3_protocol::TCP: ((Tcp_packet *)prot_base)->update_checksum(diff); return;
+	case L3_protocol::UDP: ((Udp_packet *)prot_base)->update_checksum(diff); return;
+	default: throw Interface::Bad_transport_protocol(); }
+}
+
+
 /***************
  ** Interface **
  ***************/
@@ -153,18 +160,44 @@ void Interface::_pass_prot(Ethernet_frame       &eth,
                            Ipv4_packet          &ip,
                            L3_protocol    const  prot,
                            void          *const  prot_base,
-                           size_t         const  prot_size)
+                           Link_side_id   const &old_id,
+                           Interface            &src)
 {
-	_update_checksum(prot, prot_base, prot_size, ip.src(), ip.dst());
-	_pass_ip(eth, eth_size, ip);
+	_update_checksum(prot, prot_base, old_id, ip);
+	_pass_ip(eth, eth_size, ip, src);
 }
 
 
 void Interface::_pass_ip(Ethernet_frame &eth,
                          size_t   const  eth_size,
-                         Ipv4_packet    &ip)
+                         Ipv4_packet    &ip,
+                         Interface      &src)
 {
 	ip.checksum(Ipv4_packet::calculate_checksum(ip));
+	_forward(eth, eth_size, src);
+}
+
+
+void Interface::_forward(Ethernet_frame &eth,
+                         size_t   const  eth_size,
+                         Interface      &src)
+{
+	/*
+	 * If both sessions share the zero-copy pool, the modified packet can be
+	 * passed on by its descriptor. The source acknowledges it not until the
+	 * destination does so.
+	 */
+	Zero_copy_rx   *const rx   = _zero_copy_rx_state();
+	Zero_copy_slot *const slot = src._zero_copy_tx_slot();
+	if (rx && slot && src._handled_pkt &&
+	    rx->forward(_source(), *slot, *src._handled_pkt))
+	{
+		src._handled_pkt_forwarded = true;
+		if (_config().verbose()) {
+			log("\033[33m(", _domain, " <- router)\033[0m ", eth, " (zero copy)"); }
+
+		return;
+	}
 	send(eth, eth_size);
 }
 
@@ -201,9 +234,17 @@ Interface::_new_link(L3_protocol                   const  protocol,
 		{
 			Tcp_link &link = *new (_alloc)
 				Tcp_link(*this, local, remote_port_alloc, remote_interface,
-				         remote, _timer, _config(), protocol);
-			_tcp_links.insert(&link.client());
-			remote_interface._tcp_links.insert(&link.server());
+				         remote, _link_expiry, _config(), protocol);
+			try {
+				_tcp_links.insert(&link.client());
+				remote_interface._tcp_links.insert(&link.server());
+			}
+			catch (...) {
+				/* remove the sides, free the port, and leave the expiry */
+				link.dissolve();
+				destroy(_alloc, &link);
+				throw;
+			}
 			if (_config().verbose()) {
 				log("New TCP client link: ", link.client(), " at ", *this);
 				log("New TCP server link: ", link.server(),
@@ -215,9 +256,17 @@ Interface::_new_link(L3_protocol                   const  protocol,
 		{
 			Udp_link &link = *new (_alloc)
 				Udp_link(*this, local, remote_port_alloc, remote_interface,
-				         remote, _timer, _config(), protocol);
-			_udp_links.insert(&link.client());
-			remote_interface._udp_links.insert(&link.server());
+				         remote, _link_expiry, _config(), protocol);
+			try {
+				_udp_links.insert(&link.client());
+				remote_interface._udp_links.insert(&link.server());
+			}
+			catch (...) {
+				/* remove the sides, free the port, and leave the expiry */
+				link.dissolve();
+				destroy(_alloc, &link);
+				throw;
+			}
 			if (_config().verbose()) {
 				log("New UDP client link: ", link.client(), " at ", *this);
 				log("New UDP server link: ", link.server(),
@@ -229,7 +278,7 @@ Interface::_new_link(L3_protocol                   const  protocol,
 }
 
 
-Link_side_tree &Interface::_links(L3_protocol const protocol)
+Link_side_table &Interface::_links(L3_protocol const protocol)
 {
 	switch (protocol) {
 	case L3_protocol::TCP: return _tcp_links;
@@ -288,7 +337,6 @@ void Interface::_nat_link_and_pass(Ethernet_frame        &eth,
                                    Ipv4_packet           &ip,
                                    L3_protocol     const  prot,
                                    void           *const  prot_base,
-                                   size_t          const  prot_size,
                                    Link_side_id    const &local,
                                    Interface             &interface)
 {
@@ -306,7 +354,7 @@ void Interface::_nat_link_and_pass(Ethernet_frame        &eth,
 	Link_side_id const remote = { ip.dst(), _dst_port(prot, prot_base),
 	                              ip.src(), _src_port(prot, prot_base) };
 	_new_link(prot, local, remote_port_alloc, interface, remote);
-	interface._pass_prot(eth, eth_size, ip, prot, prot_base, prot_size);
+	interface._pass_prot(eth, eth_size, ip, prot, prot_base, local, *this);
 }
 
 
@@ -587,11 +635,11 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 			_src_port(prot, prot_base, remote_side.dst_port());
 			_dst_port(prot, prot_base, remote_side.src_port());
 
-			interface._pass_prot(eth, eth_size, ip, prot, prot_base, prot_size);
+			interface._pass_prot(eth, eth_size, ip, prot, prot_base, local, *this);
 			_link_packet(prot, prot_base, link, client);
 			return;
 		}
-		catch (Link_side_tree::No_match) { }
+		catch (Link_side_table::No_match) { }
 
 		/* try to route via forward rules */
 		if (local.dst_ip == _router_ip()) {
@@ -605,8 +653,8 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 
 				_adapt_eth(eth, eth_size, rule.to(), pkt, interface);
 				ip.dst(rule.to());
-				_nat_link_and_pass(eth, eth_size, ip, prot, prot_base, prot_size,
-				                   local, interface);
+				_nat_link_and_pass(eth, eth_size, ip, prot, prot_base, local,
+				                   interface);
 				return;
 			}
 			catch (Forward_rule_tree::No_match) { }
@@ -625,8 +673,8 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 				    " ", permit_rule); }
 
 			_adapt_eth(eth, eth_size, local.dst_ip, pkt, interface);
-			_nat_link_and_pass(eth, eth_size, ip, prot, prot_base, prot_size,
-			                   local, interface);
+			_nat_link_and_pass(eth, eth_size, ip, prot, prot_base, local,
+			                   interface);
 			return;
 		}
 		catch (Transport_rule_list::No_match) { }
@@ -644,7 +692,7 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 			log("Using IP rule: ", rule); }
 
 		_adapt_eth(eth, eth_size, ip.dst(), pkt, interface);
-		interface._pass_ip(eth, eth_size, ip);
+		interface._pass_ip(eth, eth_size, ip, *this);
 		return;
 	}
 	catch (Ip_rule_list::No_match) { }
@@ -758,6 +806,23 @@ void Interface::_handle_arp(Ethernet_frame &eth, size_t const eth_size)
 }
 
 
+void Interface::_handle_sink_packet(Packet_descriptor const &pkt)
+{
+	_handled_pkt           = &pkt;
+	_handled_pkt_forwarded = false;
+	try { _handle_eth(_sink().packet_content(pkt), pkt.size(), pkt); }
+	catch (Packet_postponed) {
+		_handled_pkt = nullptr;
+		throw;
+	}
+	_handled_pkt = nullptr;
+
+	/* a packet forwarded without copying is acknowledged by its receiver */
+	if (!_handled_pkt_forwarded) {
+		_ack_packet(pkt); }
+}
+
+
 void Interface::_ready_to_submit()
 {
 	while (_sink().packet_avail()) {
@@ -766,25 +831,32 @@ void Interface::_ready_to_submit()
 		if (!pkt.size()) {
 			continue; }
 
-		try { _handle_eth(_sink().packet_content(pkt), pkt.size(), pkt); }
-		catch (Packet_postponed) { continue; }
-		_ack_packet(pkt);
+		try { _handle_sink_packet(pkt); }
+		catch (Packet_postponed) { }
 	}
 }
 
 
 void Interface::_continue_handle_eth(Packet_descriptor const &pkt)
 {
-	try { _handle_eth(_sink().packet_content(pkt), pkt.size(), pkt); }
-	catch (Packet_postponed) { error("failed twice to handle packet"); }
-	_ack_packet(pkt);
+	try { _handle_sink_packet(pkt); }
+	catch (Packet_postponed) {
+		error("failed twice to handle packet");
+		_ack_packet(pkt);
+	}
 }
 
 
 void Interface::_ready_to_ack()
 {
+	Zero_copy_rx *const rx = _zero_copy_rx_state();
 	while (_source().ack_avail()) {
-		_source().release_packet(_source().get_acked_packet()); }
+		Packet_descriptor const pkt = _source().get_acked_packet();
+		if (rx && rx->release(pkt)) {
+			continue; }
+
+		_source().release_packet(pkt);
+	}
 }
 
 
@@ -902,7 +974,7 @@ Interface::Interface(Entrypoint        &ep,
 	_source_ack(ep, *this, &Interface::_ready_to_ack),
 	_source_submit(ep, *this, &Interface::_packet_avail),
 	_router_mac(router_mac), _mac(mac), _timer(timer), _alloc(alloc),
-	_domain(domain)
+	_domain(domain), _link_expiry(timer, _config().rtt())
 {
 	if (_config().verbose()) {
 		log("Interface connected ", *this);
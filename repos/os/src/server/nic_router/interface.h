@@ -21,6 +21,7 @@
 #include <l3_protocol.h>
 #include <dhcp_client.h>
 #include <dhcp_server.h>
+#include <zero_copy.h>
 
 /* Genode includes */
 #include <nic_session/nic_session.h>
@@ -63,17 +64,22 @@ class Net::Interface
 		Timer::Connection    &_timer;
 		Genode::Allocator    &_alloc;
 		Domain               &_domain;
+		Link_expiry           _link_expiry;
 		Arp_cache             _arp_cache;
 		Arp_waiter_list       _own_arp_waiters;
 		Arp_waiter_list       _foreign_arp_waiters;
-		Link_side_tree        _tcp_links;
-		Link_side_tree        _udp_links;
+		Link_side_table       _tcp_links { _alloc };
+		Link_side_table       _udp_links { _alloc };
 		Link_list             _closed_tcp_links;
 		Link_list             _closed_udp_links;
 		Dhcp_allocation_tree  _dhcp_allocations;
 		Dhcp_allocation_list  _released_dhcp_allocations;
 		Dhcp_client           _dhcp_client { _alloc, _timer, *this };
 
+		/* sink packet that is currently handled */
+		Packet_descriptor const *_handled_pkt           = nullptr;
+		bool                     _handled_pkt_forwarded = false;
+
 		void _new_link(L3_protocol                   const  protocol,
 		               Link_side_id                  const &local_id,
 		               Pointer<Port_allocator_guard> const  remote_port_alloc,
@@ -123,7 +129,6 @@ class Net::Interface
 		                        Ipv4_packet            &ip,
 		                        L3_protocol      const  prot,
 		                        void            *const  prot_base,
-		                        Genode::size_t   const  prot_size,
 		                        Link_side_id     const &local_id,
 		                        Interface              &interface);
 
@@ -134,17 +139,25 @@ class Net::Interface
 		                Ipv4_packet            &ip,
 		                L3_protocol      const  prot,
 		                void            *const  prot_base,
-		                Genode::size_t   const  prot_size);
+		                Link_side_id     const &old_id,
+		                Interface              &src);
 
 		void _pass_ip(Ethernet_frame       &eth,
 		              Genode::size_t const  eth_size,
-		              Ipv4_packet          &ip);
+		              Ipv4_packet          &ip,
+		              Interface            &src);
+
+		void _forward(Ethernet_frame       &eth,
+		              Genode::size_t const  eth_size,
+		              Interface            &src);
+
+		void _handle_sink_packet(Packet_descriptor const &pkt);
 
 		void _continue_handle_eth(Packet_descriptor const &pkt);
 
 		Link_list &_closed_links(L3_protocol const protocol);
 
-		Link_side_tree &_links(L3_protocol const protocol);
+		Link_side_table &_links(L3_protocol const protocol);
 
 		Configuration &_config() const;
 
@@ -164,6 +177,16 @@ class Net::Interface
 
 		virtual Packet_stream_source &_source() = 0;
 
+		/**
+		 * Return pool slot that serves as TX buffer if any
+		 */
+		virtual Zero_copy_slot *_zero_copy_tx_slot() { return nullptr; }
+
+		/**
+		 * Return state of receiving packets from the pool if any
+		 */
+		virtual Zero_copy_rx *_zero_copy_rx_state() { return nullptr; }
+
 
 		/***********************************
 		 ** Packet-stream signal handlers **
@@ -208,6 +231,13 @@ class Net::Interface
 
 		void send(Ethernet_frame &eth, Genode::size_t const eth_size);
 
+		/**
+		 * Acknowledge packet that was forwarded to another session without
+		 * copying it
+		 */
+		void ack_forwarded_packet(Packet_descriptor const &pkt) {
+			_ack_packet(pkt); }
+
 
 		/*********
 		 ** log **
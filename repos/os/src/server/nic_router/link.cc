@@ -47,6 +47,22 @@ bool Link_side_id::operator > (Link_side_id const &id) const
 }
 
 
+uint32_t Link_side_id::hash() const
+{
+	/* FNV-1a over the packed ID followed by a final avalanche step */
+	uint8_t const *data = (uint8_t const *)data_base();
+	uint32_t hash = 2166136261U;
+	for (size_t i = 0; i < data_size(); i++) {
+		hash ^= data[i];
+		hash *= 16777619U;
+	}
+	hash ^= hash >> 15;
+	hash *= 0x2c1b3c6dU;
+	hash ^= hash >> 12;
+	return hash;
+}
+
+
 /***************
  ** Link_side **
  ***************/
@@ -59,44 +75,238 @@ Link_side::Link_side(Interface          &interface,
 { }
 
 
-Link_side const &Link_side::find_by_id(Link_side_id const &id) const
+void Link_side::print(Output &output) const
 {
-	if (id == _id) {
-		return *this; }
+	Genode::print(output, "src ", src_ip(), ":", src_port(),
+	                     " dst ", dst_ip(), ":", dst_port());
+}
 
-	bool const side = id > _id;
-	Link_side *const link_side = Avl_node<Link_side>::child(side);
-	if (!link_side) {
-		throw Link_side_tree::No_match(); }
 
-	return link_side->find_by_id(id);
+bool Link_side::is_client() const
+{
+	return this == &_link.client();
 }
 
 
-void Link_side::print(Output &output) const
+/*********************
+ ** Link_side_table **
+ *********************/
+
+Link_side_table::~Link_side_table()
 {
-	Genode::print(output, "src ", src_ip(), ":", src_port(),
-	                     " dst ", dst_ip(), ":", dst_port());
+	if (_slots) {
+		_alloc.free(_slots, _capacity * sizeof(Slot)); }
 }
 
 
-bool Link_side::is_client() const
+size_t Link_side_table::_free_slot_distance(uint32_t const hash) const
 {
-	return this == &_link.client();
+	for (size_t probe = 0; probe < _capacity; probe++) {
+		if (!_slots[(hash + probe) & _mask()].side) {
+			return probe; }
+	}
+	return _capacity;
 }
 
 
-/********************
- ** Link_side_tree **
- ********************/
+bool Link_side_table::_resize(size_t const capacity)
+{
+	Slot *slots;
+	if (!_alloc.alloc(capacity * sizeof(Slot), (void **)&slots)) {
+		return false; }
+
+	for (size_t i = 0; i < capacity; i++) {
+		slots[i] = Slot { nullptr, 0, false }; }
+
+	Slot   *const old_slots    = _slots;
+	size_t  const old_capacity = _capacity;
+
+	_slots      = slots;
+	_capacity   = capacity;
+	_removed    = 0;
+	_max_probes = 0;
+	_scan_start = 0;
+
+	for (size_t i = 0; i < old_capacity; i++) {
+		Slot const &old_slot = old_slots[i];
+		if (!old_slot.side) {
+			continue; }
+
+		size_t const probe = _free_slot_distance(old_slot.hash);
+		_slots[(old_slot.hash + probe) & _mask()] = old_slot;
+		_max_probes = max(_max_probes, probe + 1);
+	}
+	if (old_slots) {
+		_alloc.free(old_slots, old_capacity * sizeof(Slot)); }
+
+	return true;
+}
+
+
+void Link_side_table::insert(Link_side *side)
+{
+	uint32_t const hash = side->id().hash();
+
+	/*
+	 * Keep the load, including removed slots, at one half at most. If less
+	 * than three eighths of the slots are in use, rehashing at the same
+	 * capacity suffices to get rid of the removed slots.
+	 */
+	if ((_used + _removed + 1) * 2 > _capacity) {
+		_resize((_used + 1) * 8 > _capacity * 3 ?
+		        max((size_t)INITIAL_CAPACITY, _capacity * 2) : _capacity);
+	}
+	size_t probe = _free_slot_distance(hash);
+	if (probe >= MAX_PROBES && _resize(_capacity * 2)) {
+		probe = _free_slot_distance(hash); }
+
+	if (probe >= _capacity) {
+		throw Allocator::Out_of_memory(); }
+
+	size_t const idx  = (hash + probe) & _mask();
+	Slot        &slot = _slots[idx];
+	if (slot.removed) {
+		_removed--; }
+
+	slot = Slot { side, hash, false };
+	_used++;
+	_max_probes = max(_max_probes, probe + 1);
+	_scan_start = min(_scan_start, idx);
+}
 
-Link_side const &Link_side_tree::find_by_id(Link_side_id const &id) const
+
+void Link_side_table::remove(Link_side *side)
 {
-	Link_side *const link_side = first();
-	if (!link_side) {
-		throw No_match(); }
+	uint32_t const hash = side->id().hash();
+	for (size_t probe = 0; probe < _max_probes; probe++) {
+
+		size_t const idx  = (hash + probe) & _mask();
+		Slot        &slot = _slots[idx];
+		if (slot.side != side) {
+			continue; }
+
+		/*
+		 * The slot may become free again if no probe sequence passes
+		 * through it, which is the case if its successor is free.
+		 */
+		bool const passed = _slots[(idx + 1) & _mask()].side ||
+		                    _slots[(idx + 1) & _mask()].removed;
+
+		slot = Slot { nullptr, 0, passed };
+		_used--;
+		if (passed) {
+			_removed++; }
+
+		return;
+	}
+}
 
-	return link_side->find_by_id(id);
+
+Link_side const &Link_side_table::find_by_id(Link_side_id const &id) const
+{
+	uint32_t const hash = id.hash();
+	for (size_t probe = 0; probe < _max_probes; probe++) {
+
+		Slot const &slot = _slots[(hash + probe) & _mask()];
+		if (!slot.side) {
+			if (!slot.removed) {
+				break; }
+
+			continue;
+		}
+		if (slot.hash == hash && slot.side->id() == id) {
+			return *slot.side; }
+	}
+	throw No_match();
+}
+
+
+Link_side *Link_side_table::first()
+{
+	for (; _scan_start < _capacity; _scan_start++) {
+		if (_slots[_scan_start].side) {
+			return _slots[_scan_start].side; }
+	}
+	return nullptr;
+}
+
+
+/*****************
+ ** Link_expiry **
+ *****************/
+
+Link_expiry::Link_expiry(Timer::Connection  &timer,
+                         Microseconds const  timeout)
+:
+	_tick_timeout(timer, *this, &Link_expiry::_handle_tick),
+	_tick_us(max(timeout.value / TICKS_PER_TIMEOUT, 1UL))
+{ }
+
+
+void Link_expiry::_enlist(Link &link)
+{
+	Link *&head = _slots[link._expiry_tick % NR_OF_SLOTS];
+	link._expiry_next  = head;
+	link._expiry_pprev = &head;
+	if (head) {
+		head->_expiry_pprev = &link._expiry_next; }
+
+	head = &link;
+}
+
+
+void Link_expiry::insert(Link &link)
+{
+	refresh(link);
+	_enlist(link);
+	if (!_nr_of_links++) {
+		_tick_timeout.schedule(_tick_us); }
+}
+
+
+void Link_expiry::remove(Link &link)
+{
+	if (!link._expiry_pprev) {
+		return; }
+
+	*link._expiry_pprev = link._expiry_next;
+	if (link._expiry_next) {
+		link._expiry_next->_expiry_pprev = link._expiry_pprev; }
+
+	link._expiry_next  = nullptr;
+	link._expiry_pprev = nullptr;
+	if (!--_nr_of_links) {
+		_tick_timeout.discard(); }
+}
+
+
+void Link_expiry::refresh(Link &link)
+{
+	link._expiry_tick = _curr_tick + TICKS_PER_TIMEOUT;
+}
+
+
+void Link_expiry::_handle_tick(Duration)
+{
+	_curr_tick++;
+
+	/* detach the due slot and re-enlist or expire each of its links */
+	Link *&head = _slots[_curr_tick % NR_OF_SLOTS];
+	Link *next = head;
+	head = nullptr;
+	while (Link *link = next) {
+		next = link->_expiry_next;
+		if (link->_expiry_tick > _curr_tick) {
+			_enlist(*link);
+			continue;
+		}
+		link->_expiry_next  = nullptr;
+		link->_expiry_pprev = nullptr;
+		_nr_of_links--;
+		link->_handle_close_timeout();
+	}
+	if (_nr_of_links) {
+		_tick_timeout.schedule(_tick_us); }
 }
 
 
@@ -115,7 +325,7 @@ Link::Link(Interface                           &cln_interface,
            Pointer<Port_allocator_guard> const  srv_port_alloc,
            Interface                           &srv_interface,
            Link_side_id                  const &srv_id,
-           Timer::Connection                   &timer,
+           Link_expiry                         &expiry,
            Configuration                       &config,
            L3_protocol                   const  protocol)
 :
@@ -123,15 +333,14 @@ Link::Link(Interface                           &cln_interface,
 	_client(cln_interface, cln_id, *this),
 	_server_port_alloc(srv_port_alloc),
 	_server(srv_interface, srv_id, *this),
-	_close_timeout(timer, *this, &Link::_handle_close_timeout),
-	_close_timeout_us(_config.rtt()),
+	_expiry(expiry),
 	_protocol(protocol)
 {
-	_close_timeout.schedule(_close_timeout_us);
+	_expiry.insert(*this);
 }
 
 
-void Link::_handle_close_timeout(Duration)
+void Link::_handle_close_timeout()
 {
 	dissolve();
 	_client._interface.link_closed(*this, _protocol);
@@ -167,11 +376,11 @@ Tcp_link::Tcp_link(Interface                           &cln_interface,
                    Pointer<Port_allocator_guard> const  srv_port_alloc,
                    Interface                           &srv_interface,
                    Link_side_id                  const &srv_id,
-                   Timer::Connection                   &timer,
+                   Link_expiry                         &expiry,
                    Configuration                       &config,
                    L3_protocol                   const  protocol)
 :
-	Link(cln_interface, cln_id, srv_port_alloc, srv_interface, srv_id, timer,
+	Link(cln_interface, cln_id, srv_port_alloc, srv_interface, srv_id, expiry,
 	     config, protocol)
 { }
 
@@ -179,7 +388,7 @@ Tcp_link::Tcp_link(Interface                           &cln_interface,
 void Tcp_link::_fin_acked()
 {
 	if (_server_fin_acked && _client_fin_acked) {
-		_close_timeout.schedule(_close_timeout_us);
+		_expiry.refresh(*this);
 		_closed = true;
 	}
 }
@@ -228,10 +437,10 @@ Udp_link::Udp_link(Interface                           &cln_interface,
                    Pointer<Port_allocator_guard> const  srv_port_alloc,
                    Interface                           &srv_interface,
                    Link_side_id                  const &srv_id,
-                   Timer::Connection                   &timer,
+                   Link_expiry                         &expiry,
                    Configuration                       &config,
                    L3_protocol                   const  protocol)
 :
-	Link(cln_interface, cln_id, srv_port_alloc, srv_interface, srv_id, timer,
+	Link(cln_interface, cln_id, srv_port_alloc, srv_interface, srv_id, expiry,
 	     config, protocol)
 { }
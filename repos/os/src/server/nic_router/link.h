@@ -16,7 +16,7 @@
 
 /* Genode includes */
 #include <timer_session/connection.h>
-#include <util/avl_tree.h>
+#include <base/allocator.h>
 #include <util/list.h>
 #include <net/ipv4.h>
 #include <net/port.h>
@@ -33,7 +33,8 @@ namespace Net {
 	class  Interface;
 	class  Link_side_id;
 	class  Link_side;
-	class  Link_side_tree;
+	class  Link_side_table;
+	class  Link_expiry;
 	class  Link;
 	struct Link_list : Genode::List<Link> { };
 	class  Tcp_link;
@@ -52,6 +53,8 @@ struct Net::Link_side_id
 
 	void *data_base() const { return (void *)&src_ip; }
 
+	Genode::uint32_t hash() const;
+
 
 	/************************
 	 ** Standard operators **
@@ -64,7 +67,7 @@ struct Net::Link_side_id
 __attribute__((__packed__));
 
 
-class Net::Link_side : public Genode::Avl_node<Link_side>
+class Net::Link_side
 {
 	friend class Link;
 
@@ -80,18 +83,9 @@ class Net::Link_side : public Genode::Avl_node<Link_side>
 		          Link_side_id const &id,
 		          Link               &link);
 
-		Link_side const &find_by_id(Link_side_id const &id) const;
-
 		bool is_client() const;
 
 
-		/**************
-		 ** Avl_node **
-		 **************/
-
-		bool higher(Link_side *side) { return side->_id > _id; }
-
-
 		/*********
 		 ** Log **
 		 *********/
@@ -105,6 +99,7 @@ class Net::Link_side : public Genode::Avl_node<Link_side>
 
 		Interface          &interface() const { return _interface; }
 		Link               &link()      const { return _link; }
+		Link_side_id const &id()        const { return _id; }
 		Ipv4_address const &src_ip()    const { return _id.src_ip; }
 		Ipv4_address const &dst_ip()    const { return _id.dst_ip; }
 		Port                src_port()  const { return _id.src_port; }
@@ -112,29 +107,120 @@ class Net::Link_side : public Genode::Avl_node<Link_side>
 };
 
 
-struct Net::Link_side_tree : Genode::Avl_tree<Link_side>
+/**
+ * Hash table of link sides with open addressing and linear probing
+ *
+ * Lookups compare the cached hash of a slot before touching the link side
+ * itself and give up after the maximum probe length that occurred during
+ * insertion. Insertions grow the table if they would exceed 'MAX_PROBES'.
+ */
+class Net::Link_side_table
+{
+	private:
+
+		enum { INITIAL_CAPACITY = 64, MAX_PROBES = 32 };
+
+		struct Slot
+		{
+			Link_side        *side;
+			Genode::uint32_t  hash;
+			bool              removed;
+		};
+
+		Genode::Allocator &_alloc;
+		Slot              *_slots      = nullptr;
+		Genode::size_t     _capacity   = 0;
+		Genode::size_t     _used       = 0;
+		Genode::size_t     _removed    = 0;
+		Genode::size_t     _max_probes = 0;
+		Genode::size_t     _scan_start = 0;
+
+		Genode::size_t _mask() const { return _capacity - 1; }
+
+		Genode::size_t _free_slot_distance(Genode::uint32_t const hash) const;
+
+		bool _resize(Genode::size_t const capacity);
+
+	public:
+
+		struct No_match : Genode::Exception { };
+
+		Link_side_table(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+		~Link_side_table();
+
+		void insert(Link_side *side);
+
+		void remove(Link_side *side);
+
+		Link_side const &find_by_id(Link_side_id const &id) const;
+
+		/**
+		 * Return any link side of the table or nullptr if it is empty
+		 */
+		Link_side *first();
+};
+
+
+/**
+ * Timer wheel that closes links after a period of inactivity
+ *
+ * The close timeout is divided into 'TICKS_PER_TIMEOUT' ticks. Each link
+ * is enlisted in the slot of the tick at which it expires. As traffic on a
+ * link merely updates its expiry tick, the link gets re-enlisted lazily once
+ * its current slot comes due. The wheel is driven by a single timeout that
+ * is scheduled only as long as there are links enlisted.
+ */
+class Net::Link_expiry
 {
-	struct No_match : Genode::Exception { };
+	private:
+
+		enum { NR_OF_SLOTS = 64, TICKS_PER_TIMEOUT = 16 };
 
-	Link_side const &find_by_id(Link_side_id const &id) const;
+		Timer::One_shot_timeout<Link_expiry>  _tick_timeout;
+		Genode::Microseconds           const  _tick_us;
+		unsigned long                         _curr_tick = 0;
+		unsigned long                         _nr_of_links = 0;
+		Link                                 *_slots[NR_OF_SLOTS] { };
+
+		void _enlist(Link &link);
+
+		void _handle_tick(Genode::Duration);
+
+	public:
+
+		Link_expiry(Timer::Connection          &timer,
+		            Genode::Microseconds const  timeout);
+
+		void insert(Link &link);
+
+		void remove(Link &link);
+
+		void refresh(Link &link);
 };
 
 
 class Net::Link : public Link_list::Element
 {
+	friend class Link_expiry;
+
 	protected:
 
 		Configuration                       &_config;
 		Link_side                            _client;
 		Pointer<Port_allocator_guard> const  _server_port_alloc;
 		Link_side                            _server;
-		Timer::One_shot_timeout<Link>        _close_timeout;
-		Genode::Microseconds          const  _close_timeout_us;
+		Link_expiry                         &_expiry;
 		L3_protocol                   const  _protocol;
 
-		void _handle_close_timeout(Genode::Duration);
+		/* state maintained by '_expiry' */
+		Link          *_expiry_next  = nullptr;
+		Link         **_expiry_pprev = nullptr;
+		unsigned long  _expiry_tick  = 0;
 
-		void _packet() { _close_timeout.schedule(_close_timeout_us); }
+		void _handle_close_timeout();
+
+		void _packet() { _expiry.refresh(*this); }
 
 	public:
 
@@ -145,10 +231,12 @@ class Net::Link : public Link_list::Element
 		     Pointer<Port_allocator_guard> const  srv_port_alloc,
 		     Interface                           &srv_interface,
 		     Link_side_id                  const &srv_id,
-		     Timer::Connection                   &timer,
+		     Link_expiry                         &expiry,
 		     Configuration                       &config,
 		     L3_protocol                   const  protocol);
 
+		~Link() { _expiry.remove(*this); }
+
 		void dissolve();
 
 
@@ -187,7 +275,7 @@ class Net::Tcp_link : public Link
 		         Pointer<Port_allocator_guard> const  srv_port_alloc,
 		         Interface                           &srv_interface,
 		         Link_side_id                  const &srv_id,
-		         Timer::Connection                   &timer,
+		         Link_expiry                         &expiry,
 		         Configuration                       &config,
 		         L3_protocol                   const  protocol);
 
@@ -204,7 +292,7 @@ struct Net::Udp_link : Link
 	         Pointer<Port_allocator_guard> const  srv_port_alloc,
 	         Interface                           &srv_interface,
 	         Link_side_id                  const &srv_id,
-	         Timer::Connection                   &timer,
+	         Link_expiry                         &expiry,
 	         Configuration                       &config,
 	         L3_protocol                   const  protocol);
 
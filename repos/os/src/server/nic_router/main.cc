@@ -15,6 +15,7 @@
 #include <base/component.h>
 #include <base/heap.h>
 #include <base/attached_rom_dataspace.h>
+#include <util/reconstructible.h>
 #include <nic/xml_node.h>
 #include <timer_session/connection.h>
 
@@ -36,20 +37,35 @@ class Main
 		Genode::Attached_rom_dataspace _config_rom;
 		Configuration                  _config;
 		Uplink                         _uplink;
+		Constructible<Zero_copy_pool>  _zero_copy_pool;
 		Net::Root                      _root;
 
+		Pointer<Zero_copy_pool> _init_zero_copy_pool(Env &env);
+
 	public:
 
 		Main(Env &env);
 };
 
 
+Pointer<Zero_copy_pool> Main::_init_zero_copy_pool(Env &env)
+{
+	Pointer<Zero_copy_pool> pool;
+	try {
+		_zero_copy_pool.construct(env, _config_rom.xml().sub_node("zero_copy"));
+		pool.set(*_zero_copy_pool);
+	}
+	catch (Xml_node::Nonexistent_sub_node) { }
+	return pool;
+}
+
+
 Main::Main(Env &env)
 :
 	_timer(env), _heap(&env.ram(), &env.rm()), _config_rom(env, "config"),
 	_config(_config_rom.xml(), _heap), _uplink(env, _timer, _heap, _config),
 	_root(env.ep(), _timer, _heap, _uplink.router_mac(), _config,
-	      env.ram(), env.rm())
+	      env.ram(), env.rm(), _init_zero_copy_pool(env))
 {
 	env.parent().announce(env.ep().manage(_root));
 }
@@ -8,6 +8,6 @@ SRC_CC += nat_rule.cc mac_allocator.cc main.cc ipv4_config.cc
 SRC_CC += uplink.cc interface.cc arp_cache.cc configuration.cc
 SRC_CC += domain.cc l3_protocol.cc direct_rule.cc link.cc
 SRC_CC += transport_rule.cc leaf_rule.cc permit_rule.cc
-SRC_CC += dhcp_client.cc dhcp_server.cc
+SRC_CC += dhcp_client.cc dhcp_server.cc zero_copy.cc
 
 INC_DIR += $(PRG_DIR)
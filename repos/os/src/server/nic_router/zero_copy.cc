@@ -0,0 +1,229 @@
+/*
+ * \brief  Forwarding of packets between sessions without copying
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <util/misc_math.h>
+
+/* local includes */
+#include <zero_copy.h>
+#include <interface.h>
+
+using namespace Net;
+using namespace Genode;
+
+
+/********************
+ ** Zero_copy_slot **
+ ********************/
+
+void Zero_copy_slot::packet_released(Packet_descriptor const &pkt)
+{
+	_in_flight--;
+	if (_owner) {
+		_owner->ack_forwarded_packet(pkt); }
+
+	_pool._release_slot(*this);
+}
+
+
+/********************
+ ** Zero_copy_pool **
+ ********************/
+
+Zero_copy_pool::Zero_copy_pool(Env &env, Xml_node const node)
+:
+	_env(env),
+	_slot_size(align_addr(node.attribute_value("slot_size",
+	                                           Number_of_bytes(1024*1024)), 12)),
+	_nr_of_slots(min(node.attribute_value("slots", 4U), (unsigned)MAX_SLOTS))
+{
+	for (unsigned i = 0; i < _nr_of_slots; i++) {
+		_slots[i].construct(*this, i * _slot_size); }
+}
+
+
+Zero_copy_pool::~Zero_copy_pool()
+{
+	for (unsigned i = 0; i < _nr_of_slots; i++) {
+		Zero_copy_slot &slot = *_slots[i];
+		if (slot._ds.valid()) {
+			slot._ram->free(slot._ds); }
+
+		_slots[i].destruct();
+	}
+}
+
+
+void Zero_copy_pool::_release_slot(Zero_copy_slot &slot)
+{
+	if (slot._used || slot._in_flight || !slot._ds.valid()) {
+		return; }
+
+	for (Zero_copy_rx *rx = _rxs.first(); rx; rx = rx->next()) {
+		rx->_detach(slot); }
+
+	slot._ram->free(slot._ds);
+	slot._ds  = Ram_dataspace_capability();
+	slot._ram = nullptr;
+}
+
+
+Zero_copy_slot *Zero_copy_pool::alloc_slot(size_t const size, Ram_allocator &ram)
+{
+	if (size > _slot_size) {
+		return nullptr; }
+
+	/*
+	 * A slot whose packets are still in flight at other sessions can't be
+	 * reused because its former owner would receive the acknowledgements.
+	 */
+	for (unsigned i = 0; i < _nr_of_slots; i++) {
+		Zero_copy_slot &slot = *_slots[i];
+		if (slot._ds.valid()) {
+			continue; }
+
+		slot._ds   = ram.alloc(_slot_size);
+		slot._ram  = &ram;
+		slot._used = true;
+		for (Zero_copy_rx *rx = _rxs.first(); rx; rx = rx->next()) {
+			rx->_attach(slot); }
+
+		return &slot;
+	}
+	return nullptr;
+}
+
+
+void Zero_copy_pool::free_slot(Zero_copy_slot &slot)
+{
+	slot._used  = false;
+	slot._owner = nullptr;
+
+	/*
+	 * The allocator of the slot is about to vanish together with the
+	 * session. Packets of the slot that are still in flight keep the RAM
+	 * alive, so it becomes the router's until they are acknowledged.
+	 */
+	if (slot._in_flight) {
+		slot._ram = &_env.ram(); }
+
+	_release_slot(slot);
+}
+
+
+Zero_copy_slot &Zero_copy_pool::slot_at(off_t const pool_offset)
+{
+	return *_slots[pool_offset / _slot_size];
+}
+
+
+/******************
+ ** Zero_copy_rx **
+ ******************/
+
+Zero_copy_rx::Zero_copy_rx(Zero_copy_pool       &pool,
+                           Dataspace_capability  ds,
+                           size_t         const  size)
+:
+	_pool(pool), _rm_connection(_pool._env),
+	_rm(_rm_connection.create(size + _pool.size())), _pool_offset(size)
+{
+	Region_map_client(_rm).attach_at(ds, 0, size);
+
+	for (unsigned i = 0; i < _pool._nr_of_slots; i++) {
+		if (_pool._slots[i]->dataspace().valid()) {
+			_attach(*_pool._slots[i]); }
+	}
+	_pool._rxs.insert(this);
+}
+
+
+Zero_copy_rx::~Zero_copy_rx()
+{
+	_pool._rxs.remove(this);
+	flush();
+	_rm_connection.destroy(_rm);
+}
+
+
+void Zero_copy_rx::_attach(Zero_copy_slot &slot)
+{
+	Region_map_client(_rm).attach_at(slot.dataspace(),
+	                                 _pool_offset + slot.pool_offset());
+}
+
+
+void Zero_copy_rx::_detach(Zero_copy_slot &slot)
+{
+	Region_map_client(_rm).detach(_pool_offset + slot.pool_offset());
+}
+
+
+void Zero_copy_rx::_release(Packet_descriptor const &pkt)
+{
+	off_t const pool_offset = pkt.offset() - _pool_offset;
+	Zero_copy_slot &slot = _pool.slot_at(pool_offset);
+	slot.packet_released(Packet_descriptor(pool_offset - slot.pool_offset(),
+	                                       pkt.size()));
+}
+
+
+bool Zero_copy_rx::forward(Packet_stream_source    &source,
+                           Zero_copy_slot          &slot,
+                           Packet_descriptor const &pkt)
+{
+	if (_tail - _head == MAX_PACKETS || !source.ready_to_submit()) {
+		return false; }
+
+	Packet_descriptor const fwd_pkt(_pool_offset + slot.pool_offset() +
+	                                pkt.offset(), pkt.size());
+
+	_packets[_tail++ % MAX_PACKETS] = fwd_pkt;
+	slot.packet_forwarded();
+	source.submit_packet(fwd_pkt);
+	return true;
+}
+
+
+bool Zero_copy_rx::release(Packet_descriptor const &pkt)
+{
+	if (pkt.offset() < _pool_offset) {
+		return false; }
+
+	/* acknowledgements usually arrive in the order of submission */
+	for (unsigned i = _head; i != _tail; i++) {
+		Packet_descriptor &entry = _packets[i % MAX_PACKETS];
+		if (!entry.size() || entry.offset() != pkt.offset()) {
+			continue; }
+
+		/* the size acked by the client must not be trusted */
+		Packet_descriptor const fwd_pkt = entry;
+		entry = Packet_descriptor();
+		_release(fwd_pkt);
+		break;
+	}
+	while (_head != _tail && !_packets[_head % MAX_PACKETS].size()) {
+		_head++; }
+
+	return true;
+}
+
+
+void Zero_copy_rx::flush()
+{
+	for (; _head != _tail; _head++) {
+		Packet_descriptor const &entry = _packets[_head % MAX_PACKETS];
+		if (entry.size()) {
+			_release(entry); }
+	}
+}
@@ -0,0 +1,237 @@
+/*
+ * \brief  Forwarding of packets between sessions without copying
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _ZERO_COPY_H_
+#define _ZERO_COPY_H_
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/ram_allocator.h>
+#include <rm_session/connection.h>
+#include <region_map/client.h>
+#include <util/list.h>
+#include <util/reconstructible.h>
+#include <util/xml_node.h>
+#include <nic_session/nic_session.h>
+
+namespace Net {
+
+	using Packet_descriptor    = ::Nic::Packet_descriptor;
+	using Packet_stream_source = ::Nic::Packet_stream_source< ::Nic::Session::Policy>;
+
+	class Interface;
+	class Zero_copy_slot;
+	class Zero_copy_pool;
+	class Zero_copy_rx;
+}
+
+
+/**
+ * Part of the pool that serves as TX buffer of one session
+ */
+class Net::Zero_copy_slot
+{
+	friend class Zero_copy_pool;
+
+	private:
+
+		Zero_copy_pool                   &_pool;
+		Genode::off_t              const  _pool_offset;
+		Genode::Ram_dataspace_capability  _ds        { };
+		Genode::Ram_allocator            *_ram       = nullptr;
+		bool                              _used      = false;
+		Interface                        *_owner     = nullptr;
+		unsigned                          _in_flight = 0;
+
+	public:
+
+		Zero_copy_slot(Zero_copy_pool &pool, Genode::off_t const pool_offset)
+		: _pool(pool), _pool_offset(pool_offset) { }
+
+		/**
+		 * Set interface that receives the acknowledgements of the slot
+		 */
+		void owner(Interface *owner) { _owner = owner; }
+
+		/**
+		 * Account packet of the owner that was forwarded to another session
+		 */
+		void packet_forwarded() { _in_flight++; }
+
+		/**
+		 * Account packet that the receiving session acknowledged
+		 *
+		 * \param pkt  packet relative to the TX buffer of the owner
+		 */
+		void packet_released(Packet_descriptor const &pkt);
+
+
+		/***************
+		 ** Accessors **
+		 ***************/
+
+		Genode::Dataspace_capability dataspace()         { return _ds; }
+		Genode::off_t                pool_offset() const { return _pool_offset; }
+};
+
+
+/**
+ * Buffer memory that is shared by all sessions
+ *
+ * Each session gets a slot of the pool as TX buffer and sees the whole pool
+ * behind its own RX buffer. Thus, a packet can be passed from the TX buffer
+ * of one session to another session by merely translating its descriptor.
+ * As a consequence, each session can read the TX buffers of all others, so
+ * the pool must be enabled only if all clients of the router trust each
+ * other.
+ *
+ * The RAM of a slot is allocated when a session obtains the slot and is
+ * accounted to the session. If the session is closed while other sessions
+ * still hold packets of its slot, the RAM is kept until these packets are
+ * acknowledged.
+ */
+class Net::Zero_copy_pool
+{
+	friend class Zero_copy_slot;
+	friend class Zero_copy_rx;
+
+	private:
+
+		enum { MAX_SLOTS = 16 };
+
+		using Slot = Genode::Constructible<Zero_copy_slot>;
+
+		Genode::Env                &_env;
+		Genode::size_t       const  _slot_size;
+		unsigned             const  _nr_of_slots;
+		Slot                        _slots[MAX_SLOTS];
+		Genode::List<Zero_copy_rx>  _rxs;
+
+		/**
+		 * Free RAM of slot that is neither used nor referenced by packets
+		 */
+		void _release_slot(Zero_copy_slot &slot);
+
+	public:
+
+		Zero_copy_pool(Genode::Env &env, Genode::Xml_node const node);
+
+		~Zero_copy_pool();
+
+		/**
+		 * Return unused slot or nullptr if there is none for the given size
+		 *
+		 * \param ram  allocator for the RAM of the slot
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Zero_copy_slot *alloc_slot(Genode::size_t   const size,
+		                           Genode::Ram_allocator &ram);
+
+		void free_slot(Zero_copy_slot &slot);
+
+		/**
+		 * Return slot that contains the given pool offset
+		 */
+		Zero_copy_slot &slot_at(Genode::off_t const pool_offset);
+
+		Genode::size_t size() const { return _slot_size * _nr_of_slots; }
+};
+
+
+/**
+ * State of a session that receives packets from the pool
+ */
+class Net::Zero_copy_rx : public Genode::List<Zero_copy_rx>::Element
+{
+	friend class Zero_copy_pool;
+
+	private:
+
+		enum { MAX_PACKETS = ::Nic::Session::QUEUE_SIZE };
+
+		Zero_copy_pool                         &_pool;
+		Genode::Rm_connection                   _rm_connection;
+		Genode::Capability<Genode::Region_map>  _rm;
+		Genode::off_t                    const  _pool_offset;
+
+		/*
+		 * Ring of forwarded packets that are not acknowledged yet,
+		 * acknowledged entries are invalidated by setting their size to zero
+		 */
+		Packet_descriptor _packets[MAX_PACKETS];
+		unsigned          _head = 0;
+		unsigned          _tail = 0;
+
+		void _release(Packet_descriptor const &pkt);
+
+		void _attach(Zero_copy_slot &slot);
+		void _detach(Zero_copy_slot &slot);
+
+	public:
+
+		enum {
+			RAM_QUOTA = Genode::Rm_connection::RAM_QUOTA,
+			CAP_QUOTA = Genode::Rm_session::CAP_QUOTA,
+		};
+
+		/**
+		 * Constructor
+		 *
+		 * The RX buffer is a region map of its own RM session. The caller
+		 * accounts 'RAM_QUOTA' and 'CAP_QUOTA' for it.
+		 *
+		 * \param ds    session-local part of the RX buffer
+		 * \param size  size of 'ds'
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Zero_copy_rx(Zero_copy_pool               &pool,
+		             Genode::Dataspace_capability  ds,
+		             Genode::size_t         const  size);
+
+		~Zero_copy_rx();
+
+		/**
+		 * Submit packet of another session without copying it
+		 *
+		 * \return  false if the packet must be copied instead
+		 */
+		bool forward(Packet_stream_source    &source,
+		             Zero_copy_slot          &slot,
+		             Packet_descriptor const &pkt);
+
+		/**
+		 * Handle acknowledged packet
+		 *
+		 * \return  false if the packet was not forwarded via the pool
+		 */
+		bool release(Packet_descriptor const &pkt);
+
+		/**
+		 * Release all packets that were not acknowledged yet
+		 */
+		void flush();
+
+		Genode::Dataspace_capability dataspace() {
+			return Genode::Region_map_client(_rm).dataspace(); }
+
+		/**
+		 * Return size of the session-local part of the RX buffer
+		 */
+		Genode::size_t local_size() const { return _pool_offset; }
+};
+
+#endif /* _ZERO_COPY_H_ */
@@ -60,6 +60,11 @@ class Canvas : public Canvas_base, public Genode::Surface_base::Flusher
 
 		Genode::Surface<PT> _surface;
 
+		unsigned long _painted = 0;  /* number of painted pixels */
+
+		void _count(Rect rect) {
+			_painted += Rect::intersect(rect, _surface.clip()).area().count(); }
+
 	public:
 
 		Canvas(PT *base, Area size) : _surface(base, size)
@@ -78,8 +83,19 @@ class Canvas : public Canvas_base, public Genode::Surface_base::Flusher
 
 		void clip(Rect rect) { _surface.clip(rect); }
 
+		/**
+		 * Return number of pixels painted since the last call
+		 */
+		unsigned long painted_pixels()
+		{
+			unsigned long const result = _painted;
+			_painted = 0;
+			return result;
+		}
+
 		void draw_box(Rect rect, Color color)
 		{
+			_count(rect);
 			Box_painter::paint(_surface, rect, color);
 		}
 
@@ -88,6 +104,7 @@ class Canvas : public Canvas_base, public Genode::Surface_base::Flusher
 		                  bool allow_alpha)
 		{
 			Texture<PT> const &texture = static_cast<Texture<PT> const &>(texture_base);
+			_count(Rect(pos, texture.size()));
 			Texture_painter::paint(_surface, texture, mix_color, pos, mode,
 			                       allow_alpha);
 		}
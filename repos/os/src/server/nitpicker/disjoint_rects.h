@@ -0,0 +1,73 @@
+/*
+ * \brief  Utilities for processing overlapping rectangles
+ * \author agent
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _DISJOINT_RECTS_H_
+#define _DISJOINT_RECTS_H_
+
+#include "canvas.h"
+
+/**
+ * Call 'fn' for each part of 'rect' not covered by 'rects[0..n-1]'
+ *
+ * The parts passed to 'fn' are disjoint.
+ */
+template <typename FN>
+static inline void for_each_uncovered(Rect const *rects, unsigned n, Rect rect,
+                                      FN const &fn)
+{
+	if (!rect.valid())
+		return;
+
+	/* skip rectangles that do not intersect with 'rect' */
+	Rect covered;
+	for (; n && !(covered = Rect::intersect(rects[n - 1], rect)).valid(); n--);
+
+	if (!n) {
+		fn(rect);
+		return;
+	}
+
+	Rect r[4];
+	rect.cut(covered, &r[0], &r[1], &r[2], &r[3]);
+	for (int i = 0; i < 4; i++)
+		for_each_uncovered(rects, n - 1, r[i], fn);
+}
+
+
+/**
+ * Call 'fn' for disjoint parts of the union of 'rects' within 'area'
+ *
+ * Each pixel covered by overlapping rectangles is passed to 'fn' only once.
+ */
+template <typename FN>
+static inline void for_each_disjoint(Rect const *rects, unsigned num_rects,
+                                     Rect area, FN const &fn)
+{
+	for (unsigned i = 0; i < num_rects; i++)
+		for_each_uncovered(rects, i, Rect::intersect(rects[i], area), fn);
+}
+
+
+/**
+ * Return number of pixels covered by the union of 'rects' within 'area'
+ */
+static inline unsigned long union_area(Rect const *rects, unsigned num_rects,
+                                       Rect area)
+{
+	unsigned long count = 0;
+	for_each_disjoint(rects, num_rects, area, [&] (Rect const &part) {
+		count += part.area().count(); });
+	return count;
+}
+
+#endif /* _DISJOINT_RECTS_H_ */
@@ -39,6 +39,7 @@
 #include "clip_guard.h"
 #include "pointer_origin.h"
 #include "domain_registry.h"
+#include "render_pool.h"
 
 namespace Input       { class Session_component; }
 namespace Framebuffer { class Session_component; }
@@ -1185,6 +1186,17 @@ struct Nitpicker::Main
 
 	Genode::Attached_rom_dataspace config { env, "config" };
 
+	/*
+	 * Threads for drawing the screen in parallel, configured at startup
+	 */
+	static Genode::Xml_node render_config(Genode::Xml_node config)
+	{
+		try { return config.sub_node("render"); }
+		catch (...) { return Genode::Xml_node("<render/>"); }
+	}
+
+	Render_pool<PT> render_pool { env, render_config(config.xml()) };
+
 	Root<PT> np_root = { env, config, session_list, *domain_registry,
 	                     global_keys, user_state, user_state, pointer_origin,
 	                     builtin_background, sliced_heap, framebuffer, focus_reporter };
@@ -1241,7 +1253,14 @@ struct Nitpicker::Main
 	 */
 	void draw_and_flush()
 	{
-		user_state.draw(fb_screen->screen).flush([&] (Rect const &rect) {
+		Framebuffer_screen &fb = *fb_screen;
+
+		Dirty_rect dirty = user_state.draw_dirty(
+			[&] (Rect const *rects, unsigned num_rects) {
+				render_pool.draw(user_state, fb.screen, fb.fb_ds.local_addr<PT>(),
+				                 fb.screen.size(), rects, num_rects); });
+
+		dirty.flush([&] (Rect const &rect) {
 			framebuffer.refresh(rect.x1(), rect.y1(),
 			                    rect.w(),  rect.h()); });
 	}
@@ -1317,9 +1336,7 @@ void Nitpicker::Main::handle_input()
 		user_state.geometry(pointer_origin, Rect(new_pointer_pos, Area()));
 
 	/* perform redraw and flush pixels to the framebuffer */
-	user_state.draw(fb_screen->screen).flush([&] (Rect const &rect) {
-		framebuffer.refresh(rect.x1(), rect.y1(),
-		                    rect.w(),  rect.h()); });
+	draw_and_flush();
 
 	user_state.mark_all_views_as_clean();
 
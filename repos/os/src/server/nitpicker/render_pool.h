@@ -0,0 +1,238 @@
+/*
+ * \brief  Pool of threads for drawing the view stack in parallel
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The dirty areas of the screen are split into square tiles aligned to a
+ * screen-wide grid. The tiles are disjoint. Hence, they can be drawn
+ * concurrently, each by a different thread using a thread-local canvas.
+ * The thread that calls 'draw' takes part in drawing and returns once all
+ * tiles are complete. The view stack is not modified meanwhile because
+ * the entrypoint is blocked during this time.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _RENDER_POOL_H_
+#define _RENDER_POOL_H_
+
+/* Genode includes */
+#include <base/thread.h>
+#include <base/semaphore.h>
+#include <base/log.h>
+#include <util/reconstructible.h>
+#include <util/xml_node.h>
+
+/* local includes */
+#include "view_stack.h"
+#include "disjoint_rects.h"
+
+
+template <typename PT>
+class Render_pool : Genode::Noncopyable
+{
+	private:
+
+		enum { MAX_WORKERS = 16, STACK_SIZE = 16*1024*sizeof(long) };
+
+		struct Job
+		{
+			View_stack const *view_stack;
+			PT               *base;
+			Area              size;
+			Rect const       *rects;
+			unsigned          num_rects;
+			Point             origin;     /* top-left corner of first tile */
+			unsigned          tiles_x;    /* number of tiles per row */
+			unsigned          num_tiles;
+		};
+
+		Job _job { nullptr, nullptr, Area(), nullptr, 0, Point(), 0, 0 };
+
+		Genode::Lock _lock { };
+
+		/* index of next tile to draw, protected by '_lock' */
+		unsigned _next_tile = 0;
+
+		/* counted up by each worker after completing its part of a job */
+		Genode::Semaphore _done { };
+
+		int const _tile_size;
+
+		/*
+		 * Statistics about the number of painted pixels compared to the
+		 * number of dirty pixels, protected by '_lock'
+		 */
+		bool const    _statistics;
+		unsigned      _frames         = 0;
+		unsigned long _painted_pixels = 0;
+		unsigned long _dirty_pixels   = 0;
+
+		enum { STATISTICS_FRAMES = 100 };
+
+		void _update_statistics(Rect const *rects, unsigned num_rects, Area size)
+		{
+			_dirty_pixels += union_area(rects, num_rects, Rect(Point(0, 0), size));
+
+			if (++_frames < STATISTICS_FRAMES)
+				return;
+
+			Genode::log("painted ", _painted_pixels, " of ", _dirty_pixels,
+			            " dirty pixels in ", _frames, " frames, overdraw ",
+			            _dirty_pixels ? _painted_pixels*100/_dirty_pixels : 0, "%");
+
+			_frames = 0;
+			_painted_pixels = _dirty_pixels = 0;
+		}
+
+		bool _next(unsigned &tile)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			if (_next_tile >= _job.num_tiles)
+				return false;
+
+			tile = _next_tile++;
+			return true;
+		}
+
+		void _draw_tiles()
+		{
+			Canvas<PT> canvas(_job.base, _job.size);
+
+			for (unsigned tile = 0; _next(tile); ) {
+
+				Point const p(_job.origin.x() + (tile % _job.tiles_x)*_tile_size,
+				              _job.origin.y() + (tile / _job.tiles_x)*_tile_size);
+
+				_job.view_stack->draw(canvas, _job.rects, _job.num_rects,
+				                      Rect(p, Area(_tile_size, _tile_size)));
+			}
+
+			Genode::Lock::Guard guard(_lock);
+			_painted_pixels += canvas.painted_pixels();
+		}
+
+		class Worker : public Genode::Thread
+		{
+			private:
+
+				Render_pool &_pool;
+
+				Genode::Semaphore _start { };
+
+				void entry() override
+				{
+					for (;;) {
+						_start.down();
+						_pool._draw_tiles();
+						_pool._done.up();
+					}
+				}
+
+			public:
+
+				Worker(Genode::Env &env, Render_pool &pool, Location location)
+				:
+					Genode::Thread(env, "render", STACK_SIZE, location,
+					               Weight(), env.cpu()),
+					_pool(pool)
+				{ }
+
+				void start_job() { _start.up(); }
+		};
+
+		Genode::Constructible<Worker> _workers[MAX_WORKERS];
+
+		unsigned _num_workers = 0;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param config  '<render>' node, each '<worker>' sub node creates
+		 *                a thread at the affinity location specified by the
+		 *                node's 'xpos' and 'ypos' attributes
+		 */
+		Render_pool(Genode::Env &env, Genode::Xml_node config)
+		:
+			_tile_size(Genode::max(16U, config.attribute_value("tile_size", 128U))),
+			_statistics(config.attribute_value("statistics", false))
+		{
+			config.for_each_sub_node("worker", [&] (Genode::Xml_node node) {
+
+				if (_num_workers == MAX_WORKERS) {
+					Genode::warning("number of render workers exceeds maximum of ",
+					                (unsigned)MAX_WORKERS);
+					return;
+				}
+
+				Genode::Affinity::Location const location(
+					node.attribute_value("xpos", 0U),
+					node.attribute_value("ypos", 0U), 1, 1);
+
+				_workers[_num_workers].construct(env, *this, location);
+				_workers[_num_workers]->start();
+				_num_workers++;
+			});
+		}
+
+		/**
+		 * Draw rectangles of view stack
+		 *
+		 * \param canvas  canvas used if no worker threads are configured
+		 * \param base    pixel buffer of the screen
+		 * \param size    size of the screen
+		 */
+		void draw(View_stack const &view_stack, Canvas<PT> &canvas,
+		          PT *base, Area size, Rect const *rects, unsigned num_rects)
+		{
+			if (_num_workers == 0) {
+				view_stack.draw(canvas, rects, num_rects, Rect(Point(0, 0), size));
+				_painted_pixels += canvas.painted_pixels();
+
+				if (_statistics)
+					_update_statistics(rects, num_rects, size);
+				return;
+			}
+
+			/* determine the tiles that cover the bounding box of all rects */
+			Rect bbox;
+			for (unsigned i = 0; i < num_rects; i++)
+				bbox = bbox.valid() ? Rect::compound(bbox, rects[i]) : rects[i];
+
+			bbox = Rect::intersect(bbox, Rect(Point(0, 0), size));
+			if (!bbox.valid())
+				return;
+
+			Point const origin((bbox.x1()/_tile_size)*_tile_size,
+			                   (bbox.y1()/_tile_size)*_tile_size);
+
+			unsigned const tiles_x = (bbox.x2() - origin.x())/_tile_size + 1,
+			               tiles_y = (bbox.y2() - origin.y())/_tile_size + 1;
+
+			_job = Job { &view_stack, base, size, rects, num_rects,
+			             origin, tiles_x, tiles_x*tiles_y };
+
+			_next_tile = 0;
+
+			for (unsigned i = 0; i < _num_workers; i++)
+				_workers[i]->start_job();
+
+			_draw_tiles();
+
+			for (unsigned i = 0; i < _num_workers; i++)
+				_done.down();
+
+			if (_statistics)
+				_update_statistics(rects, num_rects, size);
+		}
+};
+
+#endif /* _RENDER_POOL_H_ */
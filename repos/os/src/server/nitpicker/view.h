@@ -31,7 +31,14 @@ class Buffer;
 extern Framebuffer::Session *tmp_fb;
 
 
-typedef Genode::Dirty_rect<Rect, 3> Dirty_rect;
+/*
+ * Number of rectangles used to track the damage of the screen and of each
+ * view. Distinct small updates are kept apart instead of being merged into
+ * large unions.
+ */
+enum { NUM_DIRTY_RECTS = 8 };
+
+typedef Genode::Dirty_rect<Rect, NUM_DIRTY_RECTS> Dirty_rect;
 
 
 /*
@@ -13,6 +13,7 @@
 
 #include "view_stack.h"
 #include "clip_guard.h"
+#include "disjoint_rects.h"
 
 
 /**************************
@@ -195,13 +196,18 @@ void View_stack::draw_rec(Canvas_base &canvas, View const *view, Rect rect) cons
 	if (next && left.valid()) draw_rec(canvas, next, left);
 
 	/* draw current view */
+	Rect     dirty[NUM_DIRTY_RECTS];
+	unsigned num_dirty = 0;
 	view->dirty_rect().flush([&] (Rect const &dirty_rect) {
+		dirty[num_dirty++] = dirty_rect; });
 
-		Clip_guard clip_guard(canvas, Rect::intersect(clipped, dirty_rect));
+	for_each_disjoint(dirty, num_dirty, clipped, [&] (Rect const &part) {
+
+		Clip_guard clip_guard(canvas, part);
 
 		/* draw background if view is transparent */
 		if (view->uses_alpha())
-			draw_rec(canvas, _next_view(*view), clipped);
+			draw_rec(canvas, next, part);
 
 		view->frame(canvas, _mode);
 		view->draw(canvas, _mode);
@@ -213,6 +219,14 @@ void View_stack::draw_rec(Canvas_base &canvas, View const *view, Rect rect) cons
 }
 
 
+void View_stack::draw(Canvas_base &canvas, Rect const *rects, unsigned num_rects,
+                      Rect area) const
+{
+	for_each_disjoint(rects, num_rects, area, [&] (Rect const &part) {
+		draw_rec(canvas, _first_view_const(), part); });
+}
+
+
 void View_stack::refresh_view(View &view, Rect const rect)
 {
 	/* rectangle constrained to view geometry */
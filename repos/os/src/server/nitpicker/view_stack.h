@@ -110,18 +110,49 @@ class View_stack
 		void draw_rec(Canvas_base &, View const *view, Rect) const;
 
 		/**
-		 * Draw dirty areas
+		 * Draw the union of 'rects' within 'area'
+		 *
+		 * Each pixel is drawn only once, even if rectangles overlap. The
+		 * method may be called concurrently for disjoint areas as long as
+		 * each caller uses a different canvas.
 		 */
-		Dirty_rect draw(Canvas_base &canvas) const
+		void draw(Canvas_base &canvas, Rect const *rects, unsigned num_rects,
+		          Rect area) const;
+
+		/**
+		 * Draw dirty areas via the functor 'fn' and reset them
+		 *
+		 * The functor is called with the array of dirty rectangles and
+		 * the number of array elements. It is expected to draw the
+		 * rectangles via 'draw(Canvas_base &, Rect const *, unsigned, Rect)'.
+		 *
+		 * \return  dirty areas to be flushed to the framebuffer
+		 */
+		template <typename FN>
+		Dirty_rect draw_dirty(FN const &fn) const
 		{
 			Dirty_rect result = _dirty_rect;
 
+			Rect     rects[NUM_DIRTY_RECTS];
+			unsigned num_rects = 0;
+
 			_dirty_rect.flush([&] (Rect const &rect) {
-				draw_rec(canvas, _first_view_const(), rect); });
+				rects[num_rects++] = rect; });
+
+			fn(rects, num_rects);
 
 			return result;
 		}
 
+		/**
+		 * Draw dirty areas
+		 */
+		Dirty_rect draw(Canvas_base &canvas) const
+		{
+			return draw_dirty([&] (Rect const *rects, unsigned num_rects) {
+				draw(canvas, rects, num_rects, Rect(Point(0, 0), _size)); });
+		}
+
 		/**
 		 * Trigger redraw of the whole view stack
 		 */
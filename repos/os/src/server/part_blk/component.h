@@ -67,6 +67,20 @@ class Block::Session_component : public Block::Session_rpc_object,
 		inline bool _range_check(Packet_descriptor &p) {
 			return p.block_number() + p.block_count() <= _partition->sectors; }
 
+		/**
+		 * Check validity of packet request
+		 */
+		inline bool _valid(Packet_descriptor &p)
+		{
+			switch (p.operation()) {
+			case Packet_descriptor::READ:
+			case Packet_descriptor::WRITE: return p.size() && _range_check(p);
+			case Packet_descriptor::TRIM:  return _range_check(p);
+			case Packet_descriptor::SYNC:  return true;
+			default:                       return false;
+			}
+		}
+
 		/**
 		 * Handle a single request
 		 */
@@ -76,23 +90,40 @@ class Block::Session_component : public Block::Session_rpc_object,
 			_p_to_handle.succeeded(false);
 
 			/* ignore invalid packets */
-			if (!packet.size() || !_range_check(_p_to_handle)) {
+			if (!_valid(_p_to_handle)) {
 				_ack_packet(_p_to_handle);
 				return;
 			}
 
-			bool write   = _p_to_handle.operation() == Packet_descriptor::WRITE;
+			Packet_descriptor::Opcode op = _p_to_handle.operation();
+
+			bool write   = op == Packet_descriptor::WRITE
+			            || op == Packet_descriptor::TRIM;
 			sector_t off = _p_to_handle.block_number() + _partition->lba;
 			size_t cnt   = _p_to_handle.block_count();
 			void* addr   = tx_sink()->packet_content(_p_to_handle);
 
-			if (write && !_writeable) {
+			if ((write && !_writeable) || !_driver.ops().supported(op)) {
+
+				/* a device without in-band SYNC is synchronized via RPC */
+				if (op == Packet_descriptor::SYNC) {
+					_driver.session().sync();
+					_p_to_handle.succeeded(true);
+				}
 				_ack_packet(_p_to_handle);
 				return;
 			}
 
+			/*
+			 * The requests of all sessions are passed to the device in
+			 * order. Hence, a SYNC request forwarded to the device covers
+			 * all requests of the session submitted before.
+			 */
+			if (op == Packet_descriptor::SYNC)
+				off = cnt = 0;
+
 			try {
-				_driver.io(write, off, cnt, addr, *this, _p_to_handle);
+				_driver.io(op, off, cnt, addr, *this, _p_to_handle);
 			} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
 				if (!_req_queue_full) {
 					_req_queue_full = true;
@@ -214,6 +245,11 @@ class Block::Session_component : public Block::Session_rpc_object,
 				ops->set_operation(Opcode::READ);
 			if (_writeable && driver_ops.supported(Opcode::WRITE))
 				ops->set_operation(Opcode::WRITE);
+			if (_writeable && driver_ops.supported(Opcode::TRIM))
+				ops->set_operation(Opcode::TRIM);
+
+			/* devices without in-band SYNC are synchronized via RPC */
+			ops->set_operation(Opcode::SYNC);
 		}
 
 		void sync() { _driver.session().sync(); }
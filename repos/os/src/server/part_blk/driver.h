@@ -36,12 +36,17 @@ class Block::Block_dispatcher
 };
 
 
+/*
+ * Requests of different sessions may refer to the same blocks, e.g., two
+ * SYNC requests, hence the packet offset is compared, too
+ */
 bool operator== (const Block::Packet_descriptor& p1,
                  const Block::Packet_descriptor& p2)
 {
 	return p1.operation()    == p2.operation()    &&
 	       p1.block_number() == p2.block_number() &&
-	       p1.block_count()  == p2.block_count();
+	       p1.block_count()  == p2.block_count()  &&
+	       p1.offset()       == p2.offset();
 }
 
 
@@ -134,18 +139,21 @@ class Block::Driver
 
 		static Driver& driver();
 
-		void io(bool write, sector_t nr, Genode::size_t cnt, void* addr,
-		        Block_dispatcher &dispatcher, Packet_descriptor& cli)
+		void io(Packet_descriptor::Opcode op, sector_t nr, Genode::size_t cnt,
+		        void* addr, Block_dispatcher &dispatcher, Packet_descriptor& cli)
 		{
 			if (!_session.tx()->ready_to_submit())
 				throw Block::Session::Tx::Source::Packet_alloc_failed();
 
-			Block::Packet_descriptor::Opcode op = write
-			    ? Block::Packet_descriptor::WRITE
-			    : Block::Packet_descriptor::READ;
-			Genode::size_t size = _blk_size * cnt;
+			/*
+			 * Requests without payload occupy one block of the buffer to
+			 * obtain a distinct packet offset
+			 */
+			bool const write = op == Block::Packet_descriptor::WRITE;
+			Genode::size_t size = cli.payload() ? _blk_size * cnt : _blk_size;
 			Packet_descriptor p(_session.dma_alloc_packet(size),
 			                    op,  nr, cnt);
+			p.fua(write && cli.fua());
 			Request *r = new (&_r_slab) Request(dispatcher, cli, p);
 			_r_list.insert(r);
 
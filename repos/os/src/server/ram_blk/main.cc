@@ -14,7 +14,6 @@
  */
 
 /* Genode includes */
-#include <base/attached_ram_dataspace.h>
 #include <base/attached_rom_dataspace.h>
 #include <base/component.h>
 #include <base/exception.h>
@@ -31,15 +30,69 @@ class Ram_blk : public Block::Driver
 {
 	private:
 
+		/*
+		 * The content of the device is kept in chunks allocated on demand.
+		 * A chunk that was never written or that was trimmed as a whole
+		 * reads as zeros and occupies no memory.
+		 */
+		enum { CHUNK_SIZE = 1024*1024 };
+
 		Env       &_env;
-		Allocator *_alloc { nullptr };
+		Allocator &_alloc;
+
+		size_t  _size;
+		size_t  _block_size;
+		size_t  _block_count;
+		size_t  _num_chunks;
+		char  **_chunks;
+
+		size_t _chunk_size(size_t i) const {
+			return min((size_t)CHUNK_SIZE, _size - i*CHUNK_SIZE); }
+
+		char **_alloc_chunk_array()
+		{
+			char **chunks = (char **)_alloc.alloc(_num_chunks*sizeof(char *));
+			for (size_t i = 0; i < _num_chunks; i++)
+				chunks[i] = nullptr;
+			return chunks;
+		}
 
-		Attached_rom_dataspace *_rom_ds { nullptr };
-		size_t                  _size;
-		size_t                  _block_size;
-		size_t                  _block_count;
-		Attached_ram_dataspace  _ram_ds;
-		addr_t                  _ram_addr;
+		/**
+		 * Return chunk at index 'i', allocate it if needed
+		 *
+		 * \throw Io_error  RAM quota is exhausted
+		 */
+		char *_chunk(size_t i)
+		{
+			if (_chunks[i])
+				return _chunks[i];
+
+			try {
+				_chunks[i] = (char *)_alloc.alloc(_chunk_size(i));
+			}
+			catch (Out_of_ram)  { throw Io_error(); }
+			catch (Out_of_caps) { throw Io_error(); }
+
+			memset(_chunks[i], 0, _chunk_size(i));
+			return _chunks[i];
+		}
+
+		void _free_chunk(size_t i)
+		{
+			if (!_chunks[i])
+				return;
+
+			_alloc.free(_chunks[i], _chunk_size(i));
+			_chunks[i] = nullptr;
+		}
+
+		void _free_chunks()
+		{
+			for (size_t i = 0; i < _num_chunks; i++)
+				_free_chunk(i);
+
+			_alloc.free(_chunks, _num_chunks*sizeof(char *));
+		}
 
 		void _io(Block::sector_t           block_number,
 		         size_t                    block_count,
@@ -51,16 +104,29 @@ class Ram_blk : public Block::Driver
 			if (block_number + block_count > _block_count) {
 				Genode::warning("requested blocks ", block_number, "-",
 				                block_number + block_count," out of range!");
-				return;
+				throw Io_error();
 			}
 
 			size_t offset = (size_t) block_number * _block_size;
 			size_t size   = block_count  * _block_size;
 
-			void *src = read ? (void *)(_ram_addr + offset) : (void *)buffer;
-			void *dst = read ? (void *)buffer : (void *)(_ram_addr + offset);
-			/* copy file content to packet payload */
-			memcpy(dst, src, size);
+			while (size > 0) {
+
+				size_t const i     = offset / CHUNK_SIZE;
+				size_t const local = offset % CHUNK_SIZE;
+				size_t const len   = min(size, _chunk_size(i) - local);
+
+				if (read && !_chunks[i])
+					memset(buffer, 0, len);
+				else if (read)
+					memcpy(buffer, _chunks[i] + local, len);
+				else
+					memcpy(_chunk(i) + local, buffer, len);
+
+				offset += len;
+				size   -= len;
+				buffer += len;
+			}
 
 			ack_packet(packet);
 		}
@@ -68,37 +134,62 @@ class Ram_blk : public Block::Driver
 	public:
 
 		/**
-		 * Construct populated RAM dataspace
+		 * Construct RAM block device populated by ROM module
 		 */
 		Ram_blk(Env &env, Allocator &alloc,
 		        const char *name, size_t block_size)
 		:	Block::Driver(env.ram()),
-			_env(env), _alloc(&alloc),
-			_rom_ds(new (_alloc) Attached_rom_dataspace(_env, name)),
-			_size(_rom_ds->size()),
+			_env(env), _alloc(alloc),
+			_size(0),
 			_block_size(block_size),
-			_block_count(_size/_block_size),
-			_ram_ds(_env.ram(), _env.rm(), _size),
-			_ram_addr((addr_t)_ram_ds.local_addr<addr_t>())
+			_block_count(0),
+			_num_chunks(0),
+			_chunks(nullptr)
 		{
-			/* populate backing store from file */
-			memcpy(_ram_ds.local_addr<void>(), _rom_ds->local_addr<void>(), _size);
+			Attached_rom_dataspace rom(_env, name);
+
+			_size        = rom.size();
+			_block_count = _size/_block_size;
+			_num_chunks  = (_size + CHUNK_SIZE - 1)/CHUNK_SIZE;
+			_chunks      = _alloc_chunk_array();
+
+			/* populate backing store from file, skip chunks of zeros */
+			char const * const src = rom.local_addr<char const>();
+			try {
+				for (size_t i = 0; i < _num_chunks; i++) {
+
+					char const * const chunk_src = src + i*CHUNK_SIZE;
+					size_t       const len       = _chunk_size(i);
+
+					bool zero = true;
+					for (size_t j = 0; zero && j < len; j++)
+						zero = !chunk_src[j];
+
+					if (!zero)
+						memcpy(_chunk(i), chunk_src, len);
+				}
+			}
+			catch (Io_error) {
+				/* the destructor is not called for a failed constructor */
+				_free_chunks();
+				throw;
+			}
 		}
 
 		/**
-		 * Construct empty RAM dataspace
+		 * Construct empty RAM block device
 		 */
-		Ram_blk(Env &env, size_t size, size_t block_size)
+		Ram_blk(Env &env, Allocator &alloc, size_t size, size_t block_size)
 		:	Block::Driver(env.ram()),
-			_env(env),
+			_env(env), _alloc(alloc),
 			_size(size),
 			_block_size(block_size),
 			_block_count(_size/_block_size),
-			_ram_ds(_env.ram(), _env.rm(), _size),
-			_ram_addr((addr_t)_ram_ds.local_addr<addr_t>())
+			_num_chunks((_size + CHUNK_SIZE - 1)/CHUNK_SIZE),
+			_chunks(_alloc_chunk_array())
 		{ }
 
-		~Ram_blk() { destroy(_alloc, _rom_ds); }
+		~Ram_blk() { _free_chunks(); }
 
 
 		/****************************
@@ -113,6 +204,7 @@ class Ram_blk : public Block::Driver
 			Block::Session::Operations o;
 			o.set_operation(Block::Packet_descriptor::READ);
 			o.set_operation(Block::Packet_descriptor::WRITE);
+			o.set_operation(Block::Packet_descriptor::TRIM);
 			return o;
 		}
 
@@ -131,6 +223,35 @@ class Ram_blk : public Block::Driver
 		{
 			_io(block_number, block_count, const_cast<char *>(buffer), packet, false);
 		}
+
+		/*
+		 * Chunks covered by the range as a whole are released, trimmed
+		 * blocks of other chunks are zeroed.
+		 */
+		void trim(Block::sector_t           block_number,
+		          size_t                    block_count,
+		          Block::Packet_descriptor &packet)
+		{
+			size_t offset = (size_t) block_number * _block_size;
+			size_t size   = block_count  * _block_size;
+
+			while (size > 0) {
+
+				size_t const i     = offset / CHUNK_SIZE;
+				size_t const local = offset % CHUNK_SIZE;
+				size_t const len   = min(size, _chunk_size(i) - local);
+
+				if (len == _chunk_size(i))
+					_free_chunk(i);
+				else if (_chunks[i])
+					memset(_chunks[i] + local, 0, len);
+
+				offset += len;
+				size   -= len;
+			}
+
+			ack_packet(packet);
+		}
 };
 
 
@@ -184,7 +305,7 @@ struct Main
 				} else {
 					Genode::log("Creating RAM-based block device with size ",
 					            size, " and block size ", block_size);
-					return new (&alloc) Ram_blk(env, size, block_size);
+					return new (&alloc) Ram_blk(env, alloc, size, block_size);
 				}
 			}
 			catch (...) { throw Service_denied(); }
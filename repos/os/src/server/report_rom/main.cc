@@ -38,8 +38,10 @@ struct Report_rom::Main
 
 	bool verbose = config_rom.xml().attribute_value("verbose", false);
 
+	bool const zero_copy = config_rom.xml().attribute_value("zero_copy", false);
+
 	Report::Root report_root { env, sliced_heap, rom_registry, verbose };
-	Rom   ::Root    rom_root { env, sliced_heap, rom_registry };
+	Rom   ::Root    rom_root { env, sliced_heap, rom_registry, zero_copy };
 
 	Main(Genode::Env &env) : env(env)
 	{
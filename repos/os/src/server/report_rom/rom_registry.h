@@ -15,6 +15,7 @@
 #define _ROM_REGISTRY_H_
 
 /* Genode includes */
+#include <base/heap.h>
 #include <report_rom/rom_registry.h>
 #include <os/session_policy.h>
 
@@ -30,6 +31,9 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 		Genode::Region_map             &_rm;
 		Genode::Attached_rom_dataspace &_config_rom;
 
+		/* meta data of the snapshots of all modules */
+		Genode::Heap _snapshot_heap { _ram, _rm };
+
 		Module_list _modules;
 
 		struct Read_write_policy : Module::Read_policy, Module::Write_policy
@@ -72,7 +76,8 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 			/* XXX if we run out of memory, the server will abort */
 
 			Module * const module = new (&_md_alloc)
-				Module(_ram, _rm, name, _read_write_policy, _read_write_policy);
+				Module(_ram, _rm, _snapshot_heap, name, _read_write_policy,
+				       _read_write_policy);
 
 			_modules.insert(module);
 			return *module;
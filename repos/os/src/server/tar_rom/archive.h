@@ -0,0 +1,361 @@
+/*
+ * \brief  Index of the files contained in a TAR archive
+ * \author agent
+ * \date   2026-10-17
+ *
+ * Looking up a file used to walk the chain of TAR headers for each session
+ * request. The index is built in one pass over the archive at startup and
+ * maps the path of each record to its location via a hash table.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _ARCHIVE_H_
+#define _ARCHIVE_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <base/env.h>
+#include <base/log.h>
+#include <rm_session/connection.h>
+#include <region_map/client.h>
+#include <util/reconstructible.h>
+#include <util/retry.h>
+#include <util/string.h>
+
+namespace Tar_rom {
+
+	using namespace Genode;
+
+	class Archive;
+}
+
+
+class Tar_rom::Archive : Noncopyable
+{
+	public:
+
+		struct File
+		{
+			char const *name;       /* points into the TAR header */
+			size_t      name_len;
+			size_t      offset;     /* offset of the data within the archive */
+			size_t      size;
+
+			/*
+			 * Read-only view of the file data within the archive, created
+			 * on the first request of the file
+			 */
+			Capability<Region_map> view;
+			Dataspace_capability   view_ds;
+			bool                   view_tried;
+		};
+
+	private:
+
+		enum {
+			/* length of one data block in tar */
+			BLOCK_LEN = 512,
+
+			/* length of the name field and offset of the size field in tar */
+			FIELD_NAME_LEN = 100,
+			FIELD_SIZE     = 124,
+
+			PAGE_SIZE_LOG2 = 12,
+
+			INITIAL_CAPACITY = 64,
+		};
+
+		Allocator &_alloc;
+		Env       &_env;
+
+		Dataspace_capability const _tar_ds;
+		char const         * const _tar_addr;
+		size_t               const _tar_size;
+		bool                 const _views;
+
+		File     *_files    = nullptr;
+		unsigned  _capacity = 0;
+		unsigned  _count    = 0;
+
+		/*
+		 * Open-addressed hash table of indices into '_files', an unused
+		 * bucket holds 'NONE'
+		 */
+		enum : unsigned { NONE = ~0U };
+		unsigned *_buckets     = nullptr;
+		unsigned  _num_buckets = 0;
+
+		Constructible<Rm_connection> _rm { };
+		bool                         _rm_failed = false;
+
+		static unsigned _hash(char const *s, size_t len)
+		{
+			/* FNV-1a */
+			unsigned h = 2166136261U;
+			for (size_t i = 0; i < len; i++)
+				h = (h ^ (unsigned char)s[i])*16777619U;
+			return h;
+		}
+
+		template <typename T>
+		T *_alloc_array(unsigned n) { return (T *)_alloc.alloc(n*sizeof(T)); }
+
+		void _grow()
+		{
+			unsigned const capacity = _capacity ? 2*_capacity
+			                                    : (unsigned)INITIAL_CAPACITY;
+
+			File *files = _alloc_array<File>(capacity);
+			for (unsigned i = 0; i < _count; i++) {
+				construct_at<File>(&files[i], _files[i]);
+				_files[i].~File();
+			}
+
+			if (_files)
+				_alloc.free(_files, _capacity*sizeof(File));
+
+			_files    = files;
+			_capacity = capacity;
+		}
+
+		unsigned _bucket(char const *name, size_t len) const
+		{
+			unsigned const mask = _num_buckets - 1;
+			for (unsigned i = _hash(name, len) & mask; ; i = (i + 1) & mask) {
+
+				unsigned const id = _buckets[i];
+				if (id == NONE)
+					return i;
+
+				File const &f = _files[id];
+				if (f.name_len == len && !strcmp(f.name, name, len))
+					return i;
+			}
+		}
+
+		/**
+		 * Scan the chain of TAR headers and record each file
+		 */
+		void _scan()
+		{
+			size_t const block_cnt = _tar_size/BLOCK_LEN;
+
+			for (size_t block_id = 0; block_id < block_cnt; ) {
+
+				char const * const header = _tar_addr + block_id*BLOCK_LEN;
+
+				/* lookout for empty eof-blocks */
+				if (header[0] == 0 && header[1] == 0)
+					break;
+
+				/* the size field is not necessarily null-terminated */
+				char size_field[13] { };
+				memcpy(size_field, header + FIELD_SIZE, 12);
+
+				unsigned long size = 0;
+				ascii_to_unsigned(size_field, size, 8);
+
+				char const *name = header;
+
+				/* skip leading dot of path if present */
+				if (name[0] == '.' && name[1] == '/')
+					name += 2;
+
+				/* the name field is not null-terminated if fully used */
+				size_t const max_name_len = FIELD_NAME_LEN - (name - header);
+				size_t name_len = 0;
+				while (name_len < max_name_len && name[name_len])
+					name_len++;
+
+				if (_count == _capacity)
+					_grow();
+
+				construct_at<File>(&_files[_count++], File {
+					name, name_len, (block_id + 1)*BLOCK_LEN, size,
+					Capability<Region_map>(), Dataspace_capability(), false });
+
+				/* one metablock plus the datablocks rounded up */
+				block_id += 1 + (size + BLOCK_LEN - 1)/BLOCK_LEN;
+			}
+		}
+
+		void _build_hash_table()
+		{
+			/* keep the load factor below one half */
+			_num_buckets = 16;
+			while (_num_buckets < 2*_count)
+				_num_buckets *= 2;
+
+			_buckets = _alloc_array<unsigned>(_num_buckets);
+			for (unsigned i = 0; i < _num_buckets; i++)
+				_buckets[i] = NONE;
+
+			/* the first record of a given name takes precedence */
+			for (unsigned id = 0; id < _count; id++) {
+				unsigned const i = _bucket(_files[id].name, _files[id].name_len);
+				if (_buckets[i] == NONE)
+					_buckets[i] = id;
+			}
+		}
+
+		/**
+		 * Return true if the archive content following the file up to the
+		 * end of its last page consists of zeros only
+		 *
+		 * Because a view covers whole pages, this condition ensures that the
+		 * view looks exactly like a zero-padded copy of the file.
+		 */
+		bool _zero_padded(File const &f, size_t view_size) const
+		{
+			if (f.offset + view_size > _tar_size)
+				return false;
+
+			for (size_t i = f.size; i < view_size; i++)
+				if (_tar_addr[f.offset + i])
+					return false;
+
+			return true;
+		}
+
+		Capability<Region_map> _create_view(File const &f)
+		{
+			if (!_views)
+				return Capability<Region_map>();
+
+			size_t const page_mask = (1UL << PAGE_SIZE_LOG2) - 1;
+			size_t const view_size = align_addr(f.size, PAGE_SIZE_LOG2);
+
+			if (f.size == 0 || (f.offset & page_mask) || !_zero_padded(f, view_size))
+				return Capability<Region_map>();
+
+			if (_rm_failed)
+				return Capability<Region_map>();
+
+			if (!_rm.constructed()) {
+				try { _rm.construct(_env); }
+				catch (...) {
+					warning("RM session unavailable, handing out copies of files");
+					_rm_failed = true;
+					return Capability<Region_map>();
+				}
+			}
+
+			Capability<Region_map> view;
+			try {
+				retry<Out_of_ram>(
+					[&] () {
+						view = _rm->create(view_size);
+						Region_map_client(view).attach_at(_tar_ds, 0, view_size,
+						                                  f.offset);
+					},
+					[&] () {
+						if (view.valid())
+							_rm->destroy(view);
+						view = Capability<Region_map>();
+						_rm->upgrade_ram(Rm_connection::RAM_QUOTA);
+					});
+			}
+			catch (...) {
+				if (view.valid())
+					_rm->destroy(view);
+				return Capability<Region_map>();
+			}
+			return view;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param tar_ds    dataspace of the archive
+		 * \param tar_addr  local address of the archive
+		 * \param tar_size  size of archive in bytes
+		 * \param views     hand out views of page-aligned files instead
+		 *                  of copies
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Archive(Env &env, Allocator &alloc, Dataspace_capability tar_ds,
+		        char const *tar_addr, size_t tar_size, bool views)
+		:
+			_alloc(alloc), _env(env),
+			_tar_ds(tar_ds), _tar_addr(tar_addr), _tar_size(tar_size),
+			_views(views)
+		{
+			_scan();
+			_build_hash_table();
+		}
+
+		~Archive()
+		{
+			if (_buckets)
+				_alloc.free(_buckets, _num_buckets*sizeof(unsigned));
+
+			for (unsigned i = 0; i < _count; i++) {
+				if (_files[i].view.valid())
+					_rm->destroy(_files[i].view);
+				_files[i].~File();
+			}
+
+			if (_files)
+				_alloc.free(_files, _capacity*sizeof(File));
+		}
+
+		/**
+		 * Return number of records of the archive
+		 */
+		unsigned num_files() const { return _count; }
+
+		/**
+		 * Look up file by its path
+		 *
+		 * \return file or nullptr if the archive contains no such file
+		 */
+		File const *lookup(char const *name) const
+		{
+			size_t const len = strlen(name);
+			unsigned const id = _buckets[_bucket(name, len)];
+			return id == NONE ? nullptr : &_files[id];
+		}
+
+		/**
+		 * Return start of the data of 'file' within the archive
+		 */
+		char const *data(File const &file) const {
+			return _tar_addr + file.offset; }
+
+		/**
+		 * Return read-only view of the data of 'file' within the archive
+		 *
+		 * The view is available only if views are enabled, the data is
+		 * page-aligned within the archive, and it is followed by zeros up to
+		 * the end of its last page.
+		 * The returned view is shared by all sessions for the file and
+		 * remains valid during the lifetime of the archive object.
+		 *
+		 * \return dataspace or invalid capability if no view is available
+		 */
+		Dataspace_capability view(File const &file)
+		{
+			File &f = _files[&file - _files];
+
+			if (!f.view_tried) {
+				f.view_tried = true;
+				f.view       = _create_view(f);
+				if (f.view.valid())
+					f.view_ds = Region_map_client(f.view).dataspace();
+			}
+
+			return f.view_ds;
+		}
+};
+
+#endif /* _ARCHIVE_H_ */
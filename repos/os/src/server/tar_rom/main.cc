@@ -20,6 +20,9 @@
 #include <base/session_label.h>
 #include <root/component.h>
 
+/* local includes */
+#include <archive.h>
+
 namespace Tar_rom {
 
 	using namespace Genode;
@@ -38,18 +41,13 @@ class Tar_rom::Rom_session_component : public Rpc_object<Rom_session>
 
 		Ram_session &_ram;
 
-		char const * const _tar_addr;
-		size_t       const _tar_size;
-
-		Ram_dataspace_capability _file_ds;
-
-		enum {
-			/* length of on data block in tar */
-			_BLOCK_LEN = 512,
+		/*
+		 * Read-only view of the file within the archive, shared by all
+		 * sessions for the file
+		 */
+		Dataspace_capability _view { };
 
-			/* length of the header field "file-size" in tar */
-			_FIELD_SIZE_LEN = 124
-		};
+		Ram_dataspace_capability _file_ds { };
 
 		/**
 		 * Copy file content into dataspace
@@ -68,57 +66,12 @@ class Tar_rom::Rom_session_component : public Rpc_object<Rom_session>
 		}
 
 		/**
-		 * Initialize dataspace containing the content of the archived file
+		 * Initialize dataspace containing a copy of the archived file
 		 */
 		Ram_dataspace_capability _init_file_ds(Ram_session &ram, Region_map &rm,
-		                                       Session_label const &name)
+		                                       char const *file_content,
+		                                       size_t file_size)
 		{
-			/* measure size of archive in blocks */
-			unsigned block_id = 0, block_cnt = _tar_size/_BLOCK_LEN;
-
-			char   const *file_content = nullptr;
-			unsigned long file_size    = 0;
-
-			/* scan metablocks of archive */
-			while (block_id < block_cnt) {
-
-				ascii_to_unsigned(_tar_addr + block_id*_BLOCK_LEN +
-				                  _FIELD_SIZE_LEN, file_size, 8);
-
-				/* get name of tar record */
-				char const *record_filename = _tar_addr + block_id*_BLOCK_LEN;
-
-				/* skip leading dot of path if present */
-				if (record_filename[0] == '.' && record_filename[1] == '/')
-					record_filename++;
-
-				/* get infos about current file */
-				if (name == record_filename) {
-					file_content = _tar_addr + (block_id+1) * _BLOCK_LEN;
-					break;
-				}
-
-				/* some datablocks */       /* one metablock */
-				block_id = block_id + (file_size / _BLOCK_LEN) + 1;
-
-				/* round up */
-				if (file_size % _BLOCK_LEN != 0) block_id++;
-
-				/* check for end of tar archive */
-				if (block_id*_BLOCK_LEN >= _tar_size)
-					break;
-
-				/* lookout for empty eof-blocks */
-				if (*(_tar_addr + (block_id*_BLOCK_LEN)) == 0x00)
-					if (*(_tar_addr + (block_id*_BLOCK_LEN + 1)) == 0x00)
-						break;
-			}
-
-			if (!file_content) {
-				error("couldn't find file '", name, "', empty result");
-				return Ram_dataspace_capability();
-			}
-
 			/* try to allocate memory for file */
 			Ram_dataspace_capability file_ds;
 			try {
@@ -137,21 +90,29 @@ class Tar_rom::Rom_session_component : public Rpc_object<Rom_session>
 	public:
 
 		/**
-		 * Constructor scans and seeks to file
+		 * Constructor
 		 *
-		 * \param  tar_addr  local address to tar archive
-		 * \param  tar_size  size of tar archive in bytes
-		 * \param  label     name of the requested ROM module
+		 * \param  archive  index of the tar archive
+		 * \param  label    name of the requested ROM module
 		 *
 		 * \throw Service_denied
 		 */
 		Rom_session_component(Ram_session &ram, Region_map &rm,
-		                      char const *tar_addr, unsigned tar_size,
-		                      Session_label const &label)
+		                      Archive &archive, Session_label const &label)
 		:
-			_ram(ram), _tar_addr(tar_addr), _tar_size(tar_size),
-			_file_ds(_init_file_ds(ram, rm, label))
+			_ram(ram)
 		{
+			Archive::File const *file = archive.lookup(label.string());
+			if (!file) {
+				error("couldn't find file '", label, "', empty result");
+				throw Service_denied();
+			}
+
+			_view = archive.view(*file);
+			if (_view.valid())
+				return;
+
+			_file_ds = _init_file_ds(ram, rm, archive.data(*file), file->size);
 			if (!_file_ds.valid())
 				throw Service_denied();
 		}
@@ -159,7 +120,11 @@ class Tar_rom::Rom_session_component : public Rpc_object<Rom_session>
 		/**
 		 * Destructor
 		 */
-		~Rom_session_component() { _ram.free(_file_ds); }
+		~Rom_session_component()
+		{
+			if (_file_ds.valid())
+				_ram.free(_file_ds);
+		}
 
 		/**
 		 * Return dataspace with content of file
@@ -167,6 +132,9 @@ class Tar_rom::Rom_session_component : public Rpc_object<Rom_session>
 		Rom_dataspace_capability dataspace()
 		{
 			Dataspace_capability ds = _file_ds;
+			if (_view.valid())
+				ds = _view;
+
 			return static_cap_cast<Rom_dataspace>(ds);
 		}
 
@@ -180,19 +148,16 @@ class Tar_rom::Rom_root : public Root_component<Rom_session_component>
 
 		Env &_env;
 
-		char const * const _tar_addr;
-		unsigned     const _tar_size;
+		Archive &_archive;
 
 		Rom_session_component *_create_session(const char *args)
 		{
 			Session_label const label = label_from_args(args);
 			Session_label const module_name = label.last_element();
-			log("connection for module '", module_name, "' requested");
 
 			/* create new session for the requested file */
 			return new (md_alloc()) Rom_session_component(_env.ram(), _env.rm(),
-			                                              _tar_addr, _tar_size,
-			                                              module_name.string());
+			                                              _archive, module_name);
 		}
 
 	public:
@@ -200,14 +165,12 @@ class Tar_rom::Rom_root : public Root_component<Rom_session_component>
 		/**
 		 * Constructor
 		 *
-		 * \param tar_base  local address of tar archive
-		 * \param tar_size  size of tar archive in bytes
+		 * \param archive  index of the tar archive
 		 */
-		Rom_root(Env &env, Allocator &md_alloc,
-		         char const *tar_addr, size_t tar_size)
+		Rom_root(Env &env, Allocator &md_alloc, Archive &archive)
 		:
 			Root_component<Rom_session_component>(env.ep(), md_alloc),
-			_env(env), _tar_addr(tar_addr), _tar_size(tar_size)
+			_env(env), _archive(archive)
 		{ }
 };
 
@@ -235,13 +198,30 @@ struct Tar_rom::Main
 
 	Attached_rom_dataspace _tar_ds { _env, _tar_name().string() };
 
+	/**
+	 * Return true if page-aligned files are handed out as views
+	 */
+	bool _zero_copy()
+	{
+		try {
+			return _config.xml().sub_node("archive").attribute_value("zero_copy", false);
+		} catch (...) { return false; }
+	}
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Archive _archive { _env, _heap, _tar_ds.cap(),
+	                   _tar_ds.local_addr<char>(), _tar_ds.size(),
+	                   _zero_copy() };
+
 	Sliced_heap _sliced_heap { _env.ram(), _env.rm() };
 
-	Rom_root _root { _env, _sliced_heap, _tar_ds.local_addr<char>(), _tar_ds.size() };
+	Rom_root _root { _env, _sliced_heap, _archive };
 
 	Main(Env &env) : _env(env)
 	{
-		log("using tar archive '", _tar_name(), "' with size ", _tar_ds.size());
+		log("using tar archive '", _tar_name(), "' with size ", _tar_ds.size(),
+		    " containing ", _archive.num_files(), " files");
 
 		env.parent().announce(env.ep().manage(_root));
 	}
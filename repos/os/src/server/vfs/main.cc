@@ -65,10 +65,17 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 		bool _writable;
 
 		/*
-		 * XXX Currently, we have only one packet in backlog, which must finish
-		 *     processing before new packets can be processed.
+		 * Packets that could not be processed immediately
+		 *
+		 * The packets of one node are processed in the order of their
+		 * submission. Packets referring to different nodes are processed
+		 * independently and may thereby be acknowledged out of order.
 		 */
-		Packet_descriptor _backlog_packet;
+		enum { MAX_BACKLOG = File_system::Session::TX_QUEUE_SIZE };
+
+		Packet_descriptor _backlog[MAX_BACKLOG];
+		unsigned          _backlog_count = 0;
+		unsigned const    _queue_depth;
 
 		/****************************
 		 ** Handle to node mapping **
@@ -207,59 +214,64 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 			packet.succeeded(!!res_length);
 		}
 
-		bool _try_process_packet_op(Packet_descriptor &packet)
+		/**
+		 * Return true if one of the first 'count' backlog packets refers to
+		 * the node 'handle'
+		 */
+		bool _in_backlog(Node_handle handle, unsigned count) const
 		{
-			try {
-				_process_packet_op(packet);
-				return true;
-			} catch (Not_ready) {
-				_backlog_packet = packet;
-			}
+			for (unsigned i = 0; i < count; i++)
+				if (_backlog[i].handle().value == handle.value)
+					return true;
 
 			return false;
 		}
 
-		bool _process_backlog()
+		void _remove_from_backlog(unsigned index)
 		{
-			/* indicate success if there's no backlog */
-			if (!_backlog_packet.size() &&
-			    (_backlog_packet.operation() != Packet_descriptor::SYNC)) {
-				return true;
-			}
+			for (unsigned i = index + 1; i < _backlog_count; i++)
+				_backlog[i - 1] = _backlog[i];
 
-			/* only start processing if acknowledgement is possible */
-			if (!tx_sink()->ready_to_ack())
-				return false;
+			_backlog[--_backlog_count] = Packet_descriptor();
+		}
 
-			if (!_try_process_packet_op(_backlog_packet))
-				return false;
+		/**
+		 * Process packet and acknowledge it if needed
+		 *
+		 * \return false if the packet must be retried later
+		 */
+		bool _try_process_packet(Packet_descriptor &packet)
+		{
+			try { _process_packet_op(packet); }
+			catch (Not_ready) { return false; }
+			catch (Dont_ack)  { return true; }
 
 			/*
-			 * The 'acknowledge_packet' function cannot block because we
-			 * checked for 'ready_to_ack' in '_process_packets'.
+			 * The 'acknowledge_packet' function cannot block because the
+			 * callers checked for 'ready_to_ack' beforehand.
 			 */
-			tx_sink()->acknowledge_packet(_backlog_packet);
-
-			/* invalidate backlog packet */
-			_backlog_packet = Packet_descriptor();
+			tx_sink()->acknowledge_packet(packet);
 
 			return true;
 		}
 
-		bool _process_packet()
+		void _process_backlog()
 		{
-			Packet_descriptor packet = tx_sink()->get_packet();
+			for (unsigned i = 0; i < _backlog_count; ) {
 
-			if (!_try_process_packet_op(packet))
-				return false;
+				/* only start processing if acknowledgement is possible */
+				if (!tx_sink()->ready_to_ack())
+					return;
 
-			/*
-			 * The 'acknowledge_packet' function cannot block because we
-			 * checked for 'ready_to_ack' in '_process_packets'.
-			 */
-			tx_sink()->acknowledge_packet(packet);
+				/* keep the order of the packets referring to the same node */
+				if (_in_backlog(_backlog[i].handle(), i)
+				 || !_try_process_packet(_backlog[i])) {
+					i++;
+					continue;
+				}
 
-			return true;
+				_remove_from_backlog(i);
+			}
 		}
 
 		/**
@@ -268,37 +280,38 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 		 */
 		void _process_packets()
 		{
-			/*
-			 * XXX Process client backlog before looking at new requests. This
-			 *     limits the number of simultaneously addressed handles (which
-			 *     was also the case before adding the backlog in case of
-			 *     blocking operations).
-			 */
-			if (!_process_backlog())
-				/* backlog not cleared - block for next condition change */
-				return;
+			_process_backlog();
 
 			while (tx_sink()->packet_avail()) {
 
 				/*
-				 * Make sure that the '_process_packet' function does not
+				 * Make sure that the '_try_process_packet' function does not
 				 * block.
 				 *
 				 * If the acknowledgement queue is full, we defer packet
 				 * processing until the client processed pending
 				 * acknowledgements and thereby emitted a ready-to-ack
 				 * signal. Otherwise, the call of 'acknowledge_packet()'
-				 * in '_process_packet' would infinitely block the context
-				 * of the main thread. The main thread is however needed
-				 * for receiving any subsequent 'ready-to-ack' signals.
+				 * in '_try_process_packet' would infinitely block the
+				 * context of the main thread. The main thread is however
+				 * needed for receiving any subsequent 'ready-to-ack' signals.
 				 */
 				if (!tx_sink()->ready_to_ack())
 					return;
 
-				try {
-					if (!_process_packet())
-						return;
-				} catch (Dont_ack) { }
+				/*
+				 * Leave new requests in the submit queue while the backlog
+				 * is exhausted. They are picked up once a node completes one
+				 * of its pending operations.
+				 */
+				if (_backlog_count == _queue_depth)
+					return;
+
+				Packet_descriptor packet = tx_sink()->get_packet();
+
+				if (_in_backlog(packet.handle(), _backlog_count)
+				 || !_try_process_packet(packet))
+					_backlog[_backlog_count++] = packet;
 			}
 		}
 
@@ -340,6 +353,7 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 		 * \param tx_buf_size  shared transmission buffer size
 		 * \param root_path    path root of the session
 		 * \param writable     whether the session can modify files
+		 * \param queue_depth  maximum number of packets in processing
 		 */
 
 		Session_component(Genode::Env         &env,
@@ -348,14 +362,17 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 		                  size_t               tx_buf_size,
 		                  Vfs::Dir_file_system &vfs,
 		                  char           const *root_path,
-		                  bool                  writable)
+		                  bool                  writable,
+		                  unsigned              queue_depth)
 		:
 			Session_rpc_object(env.ram().alloc(tx_buf_size), env.rm(), env.ep().rpc_ep()),
 			_ram(env.ram(), ram_quota),
 			_alloc(_ram, env.rm()),
 			_process_packet_handler(env.ep(), *this, &Session_component::_process_packets),
 			_vfs(vfs),
-			_writable(writable)
+			_writable(writable),
+			_queue_depth(Genode::max(1U, Genode::min(queue_depth,
+			                                         (unsigned)MAX_BACKLOG)))
 		{
 			/*
 			 * Register '_process_packets' dispatch function as signal
@@ -671,6 +688,7 @@ class Vfs_server::Root :
 			Session_label const label = label_from_args(args);
 			Path session_root;
 			bool writeable = false;
+			unsigned queue_depth = File_system::Session::TX_QUEUE_SIZE;
 
 			/*****************
 			 ** Quota check **
@@ -720,6 +738,12 @@ class Vfs_server::Root :
 				if (policy.attribute_value("writeable", false))
 					writeable = Arg_string::find_arg(args, "writeable").bool_value(false);
 
+				/*
+				 * Limit the number of packets processed concurrently, a
+				 * depth of one serializes all operations of the session
+				 */
+				queue_depth = policy.attribute_value("queue_depth", queue_depth);
+
 			} catch (Session_policy::No_policy_defined) {
 				/* missing policy - deny request */
 				throw Service_denied();
@@ -742,7 +766,7 @@ class Vfs_server::Root :
 			Session_component *session = new (md_alloc())
 				Registered_session(_session_registry, _env, label.string(),
 				                   ram_quota, tx_buf_size, _vfs,
-				                   session_root.base(), writeable);
+				                   session_root.base(), writeable, queue_depth);
 
 			Genode::log("session opened for '", label, "' at '", session_root, "'");
 			return session;
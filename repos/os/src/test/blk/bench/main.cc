@@ -25,7 +25,10 @@ enum {
 	TEST_WRITE   = false,
 	TEST_SIZE    = 1024 * 1024 * 1024,
 	REQUEST_SIZE = 8 * 512,
-	TX_BUFFER    = Block::Session::TX_QUEUE_SIZE * REQUEST_SIZE
+	TX_BUFFER    = Block::Session::TX_QUEUE_SIZE * REQUEST_SIZE,
+
+	/* number of packets submitted and acknowledged at once */
+	BURST        = 16,
 };
 
 
@@ -63,36 +66,51 @@ class Throughput
 			if (_read_done && (_write_done || !TEST_WRITE))
 				return;
 
-			try {
-				while (_session.tx()->ready_to_submit()) {
-					Block::Packet_descriptor p(
-						_session.tx()->alloc_packet(REQUEST_SIZE),
-						!_read_done ? Block::Packet_descriptor::READ : Block::Packet_descriptor::WRITE,
-						_current, count);
-
-					_session.tx()->submit_packet(p);
-
-					/* increment for next read */
-					_current += count;
-					if (_current + count >= _blk_count)
-						_current = 0;
-				}
-			} catch (...) { }
+			Block::Packet_descriptor packets[BURST];
+
+			for (;;) {
+				unsigned const limit = min((unsigned)BURST,
+				                           _session.tx()->submit_slots_free());
+				unsigned n = 0;
+				try {
+					for (; n < limit; n++) {
+						packets[n] = Block::Packet_descriptor(
+							_session.tx()->alloc_packet(REQUEST_SIZE),
+							!_read_done ? Block::Packet_descriptor::READ : Block::Packet_descriptor::WRITE,
+							_current, count);
+
+						/* increment for next read */
+						_current += count;
+						if (_current + count >= _blk_count)
+							_current = 0;
+					}
+				} catch (...) { }
+
+				/* the submit queue has room for all allocated packets */
+				_session.tx()->submit_packets(packets, n);
+
+				if (n < BURST)
+					return;
+			}
 		}
 
 		void _ack()
 		{
-			while (_session.tx()->ack_avail()) {
+			Block::Packet_descriptor packets[BURST];
+
+			for (unsigned n; (n = _session.tx()->get_acked_packets(packets, BURST)); ) {
+				for (unsigned i = 0; i < n; i++) {
 
-				Block::Packet_descriptor p = _session.tx()->get_acked_packet();
-				if (!p.succeeded())
-					error("packet error: block: ", p.block_number(), " "
-					      "count: ", p.block_count());
+					Block::Packet_descriptor &p = packets[i];
+					if (!p.succeeded())
+						error("packet error: block: ", p.block_number(), " "
+						      "count: ", p.block_count());
 
-				if (!_read_done || (_read_done &&  p.operation() == Block::Packet_descriptor::WRITE))
-					_bytes += p.size();
+					if (!_read_done || (_read_done &&  p.operation() == Block::Packet_descriptor::WRITE))
+						_bytes += p.size();
 
-				_session.tx()->release_packet(p);
+					_session.tx()->release_packet(p);
+				}
 			}
 
 			if (_bytes >= TEST_SIZE) {
@@ -135,6 +153,9 @@ class Throughput
 		Throughput(Env & env)
 		: _env(env)
 		{
+			/* the packet stream is handled by the entrypoint only */
+			_session.tx()->single_threaded();
+
 			_session.tx_channel()->sigh_ack_avail(_disp_ack);
 			_session.tx_channel()->sigh_ready_to_submit(_disp_submit);
 
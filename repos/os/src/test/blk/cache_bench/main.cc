@@ -0,0 +1,152 @@
+/*
+ * \brief  Benchmark of the block cache using a synthetic access trace
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The trace mixes random accesses to a hot working set, which fits into
+ * the cache, with accesses to the rest of the device and periodic
+ * sequential scans, which do not fit into the cache. The benchmark is
+ * executed for each '<cache>' node of the configuration, using a block
+ * session with the label of the node.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/allocator_avl.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <block_session/connection.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+
+	typedef String<32> Label;
+
+	enum { CHUNK_SIZE = 4096 };
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Xml_node const _config_xml = _config.xml();
+
+	unsigned long const _requests = _config_xml.attribute_value("requests", 20000UL);
+
+	/* size of hot working set and length of scans in chunks */
+	unsigned long const _hot      = _config_xml.attribute_value("hot",  512UL);
+	unsigned long const _scan     = _config_xml.attribute_value("scan", 2048UL);
+
+	/* number of requests between the start of two scans */
+	unsigned long const _period   = _config_xml.attribute_value("period", 4000UL);
+
+	Timer::Connection _timer { _env };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	/**
+	 * Deterministic pseudo-random numbers, equal for each cache
+	 */
+	struct Random
+	{
+		uint64_t _state = 0x2545f4914f6cdd1dULL;
+
+		unsigned long next(unsigned long limit)
+		{
+			_state = _state*6364136223846793005ULL + 1442695040888963407ULL;
+			return (unsigned long)(_state >> 33) % limit;
+		}
+	};
+
+	void _measure(Label const &label)
+	{
+		Allocator_avl     alloc { &_heap };
+		Block::Connection block { _env, &alloc, 8*CHUNK_SIZE, label.string() };
+
+		Block::sector_t            blk_cnt = 0;
+		size_t                     blk_sz  = 0;
+		Block::Session::Operations ops;
+		block.info(&blk_cnt, &blk_sz, &ops);
+
+		unsigned long const chunks = (unsigned long)(blk_cnt*blk_sz/CHUNK_SIZE);
+		size_t        const count  = CHUNK_SIZE/blk_sz;
+
+		if (chunks <= _hot) {
+			error(label, ": device too small for the hot working set");
+			return;
+		}
+
+		Random random;
+
+		unsigned long scan_left = 0, scan_pos = 0, writes = 0;
+
+		unsigned long const start_us = _timer.elapsed_us();
+
+		for (unsigned long i = 0; i < _requests; i++) {
+
+			if (i % _period == 0)
+				scan_left = _scan;
+
+			unsigned long chunk;
+			if (scan_left) {
+				chunk = _hot + scan_pos++ % (chunks - _hot);
+				scan_left--;
+			} else if (random.next(10)) {
+				chunk = random.next(_hot);
+			} else {
+				chunk = _hot + random.next(chunks - _hot);
+			}
+
+			/* every eighth access to the hot set is a write */
+			bool const write = chunk < _hot && random.next(8) == 0;
+			if (write)
+				writes++;
+
+			Block::Packet_descriptor const
+				p(block.tx()->alloc_packet(CHUNK_SIZE),
+				  write ? Block::Packet_descriptor::WRITE
+				        : Block::Packet_descriptor::READ,
+				  chunk*count, count);
+
+			block.tx()->submit_packet(p);
+
+			Block::Packet_descriptor const ack = block.tx()->get_acked_packet();
+			if (!ack.succeeded())
+				error(label, ": request for block ", ack.block_number(), " failed");
+
+			block.tx()->release_packet(ack);
+		}
+
+		unsigned long const us = _timer.elapsed_us() - start_us;
+
+		log(label, ": ", _requests, " requests (", writes, " writes) in ",
+		    us/1000, " ms, ", us/_requests, " us per request");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- block-cache benchmark started ---");
+
+		_config_xml.for_each_sub_node("cache", [&] (Xml_node cache) {
+			_measure(cache.attribute_value("label", Label())); });
+
+		log("--- block-cache benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
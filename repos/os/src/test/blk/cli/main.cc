@@ -374,6 +374,72 @@ struct Violation_test : Test
 };
 
 
+/**
+ * Check that a SYNC request is acknowledged after all preceding requests
+ */
+struct Barrier_test : Test
+{
+	struct Barrier_violated : Exception {
+		void print_error() {
+			Genode::error("SYNC acknowledged before preceding requests!"); } };
+
+	enum { NR_READS = 16 };
+
+	int p_in_fly;
+
+	/*
+	 * Each packet is aligned to 2 KiB by 'dma_alloc_packet', the surplus
+	 * leaves room for the alignment of the first packet.
+	 */
+	Barrier_test(Genode::Env &env, Genode::Heap &heap, unsigned timeo)
+	:
+		Test(env, heap, (NR_READS + 1)*Genode::align_addr(blk_sz, 11) + 4096,
+		     timeo),
+		p_in_fly(0)
+	{ }
+
+	void req(Block::Packet_descriptor::Opcode op, Block::sector_t nr,
+	         Genode::size_t cnt)
+	{
+		Block::Packet_descriptor p(_session.dma_alloc_packet(blk_sz),
+		                           op, nr, cnt);
+		_session.tx()->submit_packet(p);
+		p_in_fly++;
+	}
+
+	void perform()
+	{
+		if (!blk_ops.supported(Block::Packet_descriptor::SYNC))
+			return;
+
+		Genode::log("SYNC after ", (int)NR_READS, " read requests");
+
+		for (unsigned i = 0; i < NR_READS; i++)
+			req(Block::Packet_descriptor::READ, i % test_cnt, 1);
+
+		req(Block::Packet_descriptor::SYNC, 0, 0);
+
+		while (p_in_fly > 0)
+			_handle_signal();
+	}
+
+	void ack_avail()
+	{
+		 _handle = false;
+
+		while (_session.tx()->ack_avail()) {
+			Block::Packet_descriptor p = _session.tx()->get_acked_packet();
+			if (!p.succeeded())
+				throw Block_exception(p.block_number(), p.block_count(), false);
+			if (p.operation() == Block::Packet_descriptor::SYNC && p_in_fly != 1)
+				throw Barrier_violated();
+			_session.tx()->release_packet(p);
+			p_in_fly--;
+		}
+	}
+};
+
+
 template <typename TEST>
 void perform(Genode::Env &env, Genode::Heap &heap, unsigned timeo_ms = 0)
 {
@@ -424,6 +490,7 @@ void Component::construct(Genode::Env &env)
 		perform<Read_test<Block::Session::TX_QUEUE_SIZE, 1> >(env, heap);
 		perform<Write_test<Block::Session::TX_QUEUE_SIZE, 8, 16> >(env, heap);
 		perform<Violation_test>(env, heap, 1000);
+		perform<Barrier_test>(env, heap, 1000);
 
 		log("Tests finished successfully!");
 	}
@@ -0,0 +1,202 @@
+/*
+ * \brief  Throughput benchmark of the file-system session
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The benchmark writes and reads back a file sequentially via each
+ * directory of its VFS configuration. Each directory is expected to host
+ * an 'fs' plugin, typically configured with distinct queue depths.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+#include <vfs/dir_file_system.h>
+#include <vfs/file_system_factory.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+
+	typedef String<64> Name;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Vfs::file_size const _size =
+		_config.xml().attribute_value("size", Number_of_bytes(16*1024*1024));
+
+	size_t const _chunk =
+		_config.xml().attribute_value("chunk", Number_of_bytes(16*1024));
+
+	Timer::Connection _timer { _env };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Attached_ram_dataspace _buf { _env.ram(), _env.rm(), _chunk };
+
+	struct Io_response_handler : Vfs::Io_response_handler
+	{
+		void handle_io_response(Vfs::Vfs_handle::Context *) override { }
+	} _io_response_handler { };
+
+	Vfs::Global_file_system_factory _fs_factory { _heap };
+
+	Vfs::Dir_file_system _vfs { _env, _heap, _config.xml().sub_node("vfs"),
+	                            _io_response_handler, _fs_factory };
+
+	/**
+	 * Return byte expected at file offset 'pos'
+	 */
+	static char _pattern(Vfs::file_size pos) { return (char)(pos*7 + pos/4096); }
+
+	void _wait_for_io() { _env.ep().wait_and_dispatch_one_io_signal(); }
+
+	void _log_result(Name const &name, char const *what, unsigned long ms)
+	{
+		unsigned long const kib = (unsigned long)(_size/1024);
+		log(name, ": ", what, " ", kib, " KiB in ", ms, " ms, ",
+		    ms ? kib*1000/1024/ms : 0, " MiB/s");
+	}
+
+	void _write(Vfs::Vfs_handle &handle)
+	{
+		char * const buf = _buf.local_addr<char>();
+
+		for (Vfs::file_size pos = 0; pos < _size; ) {
+
+			Vfs::file_size const count = min(_size - pos, (Vfs::file_size)_chunk);
+			for (Vfs::file_size i = 0; i < count; i++)
+				buf[i] = _pattern(pos + i);
+
+			for (Vfs::file_size done = 0; done < count; ) {
+
+				Vfs::file_size n = 0;
+				handle.seek(pos + done);
+				try {
+					if (handle.fs().write(&handle, buf + done, count - done, n)
+					    != Vfs::File_io_service::WRITE_OK) {
+						error("write failed at offset ", pos + done);
+						return;
+					}
+				} catch (Vfs::File_io_service::Insufficient_buffer) {
+					_wait_for_io();
+					continue;
+				}
+				done += n;
+			}
+			pos += count;
+		}
+
+		/* the sync is acknowledged after all preceding writes */
+		while (!handle.fs().queue_sync(&handle))
+			_wait_for_io();
+
+		while (handle.fs().complete_sync(&handle)
+		       == Vfs::File_io_service::SYNC_QUEUED)
+			_wait_for_io();
+	}
+
+	void _read(Vfs::Vfs_handle &handle)
+	{
+		char * const buf = _buf.local_addr<char>();
+
+		unsigned errors = 0;
+
+		for (Vfs::file_size pos = 0; pos < _size; ) {
+
+			Vfs::file_size const count = min(_size - pos, (Vfs::file_size)_chunk);
+
+			handle.seek(pos);
+			while (!handle.fs().queue_read(&handle, count))
+				_wait_for_io();
+
+			Vfs::file_size n = 0;
+			for (;;) {
+				Vfs::File_io_service::Read_result const result =
+					handle.fs().complete_read(&handle, buf, count, n);
+
+				if (result == Vfs::File_io_service::READ_OK)
+					break;
+
+				if (result != Vfs::File_io_service::READ_QUEUED) {
+					error("read failed at offset ", pos);
+					return;
+				}
+				_wait_for_io();
+			}
+
+			if (n == 0) {
+				error("unexpected end of file at offset ", pos);
+				return;
+			}
+
+			for (Vfs::file_size i = 0; i < n; i++)
+				if (buf[i] != _pattern(pos + i))
+					errors++;
+
+			pos += n;
+		}
+
+		if (errors)
+			error("read ", errors, " unexpected bytes");
+	}
+
+	void _measure(Name const &name)
+	{
+		Vfs::Absolute_path const path(Name("/", name, "/", name, ".dat").string());
+
+		using Vfs::Directory_service;
+
+		Vfs::Vfs_handle *handle = nullptr;
+		if (_vfs.open(path.base(), Directory_service::OPEN_MODE_RDWR
+		                         | Directory_service::OPEN_MODE_CREATE,
+		              &handle, _heap) != Directory_service::OPEN_OK) {
+			error(name, ": could not create ", path);
+			return;
+		}
+
+		unsigned long const write_ms = _timer.elapsed_ms();
+		_write(*handle);
+		_log_result(name, "write", _timer.elapsed_ms() - write_ms);
+
+		unsigned long const read_ms = _timer.elapsed_ms();
+		_read(*handle);
+		_log_result(name, "read", _timer.elapsed_ms() - read_ms);
+
+		handle->ds().close(handle);
+		_vfs.unlink(path.base());
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- file-system throughput benchmark started (chunk size ",
+		    _chunk, " bytes) ---");
+
+		_config.xml().sub_node("vfs").for_each_sub_node("dir", [&] (Xml_node dir) {
+			_measure(dir.attribute_value("name", Name())); });
+
+		log("--- file-system throughput benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
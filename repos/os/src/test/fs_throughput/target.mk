@@ -0,0 +1,3 @@
+TARGET = test-fs_throughput
+SRC_CC = main.cc
+LIBS   = base vfs
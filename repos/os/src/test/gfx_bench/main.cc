@@ -0,0 +1,198 @@
+/*
+ * \brief  Benchmark of the box and texture painters
+ * \author agent
+ * \date   2026-10-17
+ *
+ * For each pixel format, the benchmark paints a screen-sized box or texture
+ * repeatedly for about one second per drawing mode and reports the
+ * throughput in megapixels per second. Beforehand, it checks that the
+ * row operations of the pixel formats produce the same results as the
+ * generic per-pixel implementation.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+#include <os/bench.h>
+#include <nitpicker_gfx/box_painter.h>
+#include <nitpicker_gfx/texture_painter.h>
+#include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	typedef Surface_base::Area  Area;
+	typedef Surface_base::Point Point;
+	typedef Surface_base::Rect  Rect;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Area const _area { _config.xml().attribute_value("width",  640U),
+	                   _config.xml().attribute_value("height", 480U) };
+
+	unsigned long const _duration_ms =
+		_config.xml().attribute_value("duration_ms", 1000UL);
+
+	Timer::Connection _timer { _env };
+
+	unsigned _errors = 0;
+
+	Lcg_random _random { };
+
+	/**
+	 * Paint screens until the configured duration is over, log the throughput
+	 */
+	template <typename FN>
+	void _measure(char const *format, char const *mode, FN const &paint_screen)
+	{
+		Bench_result const r = bench_for(_timer, _duration_ms, paint_screen);
+
+		unsigned long long const pixels = (unsigned long long)r.rounds
+		                                * _area.count();
+
+		log(format, " ", mode, ": ", pixels/(r.ms*1000), " Mpixel/s");
+	}
+
+	/**
+	 * Compare row operations of 'PT' with the per-pixel implementation
+	 */
+	template <typename PT>
+	void _check(char const *format)
+	{
+		enum { W = 67 };
+
+		typedef Pixel_row<PT>        Row;
+		typedef Pixel_row_scalar<PT> Scalar;
+
+		for (unsigned i = 0; i < 1000; i++) {
+
+			PT dst[W], ref[W], src[W];
+			unsigned char alpha[W];
+
+			for (unsigned j = 0; j < W; j++) {
+				dst[j].pixel = ref[j].pixel = _random.next() >> 8;
+				src[j].pixel = (_random.next() % 4) ? _random.next() >> 8 : 0;
+				alpha[j]     = (_random.next() % 4) ? _random.next() >> 8 : 0;
+			}
+
+			PT       const pixel(_random.next() >> 24, _random.next() >> 24, _random.next() >> 24);
+			int      const a = _random.next() >> 24;
+			unsigned const n = _random.next() % W;
+
+			switch (i % 5) {
+			case 0: Row::fill(dst, pixel, n);   Scalar::fill(ref, pixel, n);   break;
+			case 1: Row::mix(dst, pixel, a, n); Scalar::mix(ref, pixel, a, n); break;
+			case 2: Row::mix(dst, src, alpha, n); Scalar::mix(ref, src, alpha, n); break;
+			case 3: Row::masked(dst, src, n);   Scalar::masked(ref, src, n);   break;
+			case 4: Row::avr(dst, pixel, src, n); Scalar::avr(ref, pixel, src, n); break;
+			}
+
+			for (unsigned j = 0; j < W; j++) {
+				if (dst[j].pixel == ref[j].pixel)
+					continue;
+
+				error(format, ": operation ", i % 5, " yields ",
+				      Hex(dst[j].pixel), " instead of ", Hex(ref[j].pixel));
+				_errors++;
+				return;
+			}
+		}
+	}
+
+	template <typename PT>
+	void _bench(char const *format)
+	{
+		_check<PT>(format);
+
+		size_t const num_pixels = _area.count();
+
+		Attached_ram_dataspace surface_ds (_env.ram(), _env.rm(), num_pixels*sizeof(PT));
+		Attached_ram_dataspace texture_ds (_env.ram(), _env.rm(), num_pixels*sizeof(PT));
+		Attached_ram_dataspace alpha_ds   (_env.ram(), _env.rm(), num_pixels);
+
+		PT            *pixels = texture_ds.local_addr<PT>();
+		unsigned char *alpha  = alpha_ds.local_addr<unsigned char>();
+
+		/* texture with a mix of transparent, translucent, and opaque areas */
+		for (unsigned y = 0; y < _area.h(); y++) {
+			for (unsigned x = 0; x < _area.w(); x++) {
+				unsigned const i = y*_area.w() + x;
+				pixels[i] = PT(x & 0xff, y & 0xff, (x + y) & 0xff);
+				alpha[i]  = (x/64) % 3 == 0 ? 0 : (x/64) % 3 == 1 ? 255 : x*y;
+				if (x % 16 == 0)
+					pixels[i] = PT(0, 0, 0);
+			}
+		}
+
+		Surface<PT>       surface(surface_ds.local_addr<PT>(), _area);
+		Texture<PT> const texture(pixels, alpha, _area);
+		Texture<PT> const opaque (pixels, nullptr, _area);
+
+		Rect  const rect(Point(0, 0), _area);
+		Color const mix_color(100, 150, 200);
+
+		_measure(format, "box solid", [&] () {
+			Box_painter::paint(surface, rect, Color(10, 20, 30)); });
+
+		_measure(format, "box alpha", [&] () {
+			Box_painter::paint(surface, rect, Color(10, 20, 30, 100)); });
+
+		_measure(format, "texture solid", [&] () {
+			Texture_painter::paint(surface, opaque, mix_color, Point(0, 0),
+			                       Texture_painter::SOLID, true); });
+
+		_measure(format, "texture alpha", [&] () {
+			Texture_painter::paint(surface, texture, mix_color, Point(0, 0),
+			                       Texture_painter::SOLID, true); });
+
+		_measure(format, "texture mixed", [&] () {
+			Texture_painter::paint(surface, texture, mix_color, Point(0, 0),
+			                       Texture_painter::MIXED, true); });
+
+		_measure(format, "texture masked", [&] () {
+			Texture_painter::paint(surface, texture, mix_color, Point(0, 0),
+			                       Texture_painter::MASKED, true); });
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- gfx benchmark started (", _area, ") ---");
+
+#ifdef GENODE_PIXEL_ROW_SIMD
+		log("using vectorized row operations");
+#endif
+
+		_bench<Pixel_rgb565>("RGB565");
+		_bench<Pixel_rgb888>("RGB888");
+
+		if (_errors) {
+			error(_errors, " errors");
+			return;
+		}
+
+		log("--- gfx benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-gfx_bench
+SRC_CC = main.cc
+LIBS   = base blit
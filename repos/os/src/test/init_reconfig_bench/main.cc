@@ -0,0 +1,173 @@
+/*
+ * \brief  Benchmark for the reconfiguration of init
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The benchmark drives a dynamically configured init with configurations of
+ * a growing number of children. For each number of children, it measures
+ * the time needed to start all children and the time needed to apply a
+ * configuration update that changes the start node of a single child. The
+ * end of each update is detected via the version attribute of the state
+ * report generated by init.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/component.h>
+#include <base/log.h>
+#include <base/attached_rom_dataspace.h>
+#include <os/reporter.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	enum { UPDATES = 10, CONFIG_BUFFER = 128*1024 };
+
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Reporter _init_config { _env, "config", "init.config", CONFIG_BUFFER };
+
+	Attached_rom_dataspace _init_state { _env, "state" };
+
+	Signal_handler<Main> _init_state_handler {
+		_env.ep(), *this, &Main::_handle_init_state };
+
+	typedef String<32> Version;
+
+	enum { MAX_STEPS = 16 };
+
+	unsigned _child_counts[MAX_STEPS];
+	unsigned _num_steps = 0;
+	unsigned _step      = 0;
+
+	/* number of the current update, 0 denotes the initial start */
+	unsigned _update = 0;
+
+	Version       _version { };
+	unsigned long _start_ms = 0;
+	unsigned long _update_ms_total = 0;
+
+	unsigned _num_children() const { return _child_counts[_step]; }
+
+	void _generate_init_config()
+	{
+		_version  = Version(_num_children(), "/", _update);
+		_start_ms = _timer.elapsed_ms();
+
+		Reporter::Xml_generator xml(_init_config, [&] () {
+
+			xml.attribute("version", _version);
+
+			xml.node("parent-provides", [&] () {
+				char const *services[] = { "ROM", "CPU", "PD", "LOG" };
+				for (char const *service : services)
+					xml.node("service", [&] () {
+						xml.attribute("name", service); });
+			});
+
+			xml.node("default-route", [&] () {
+				xml.node("any-service", [&] () {
+					xml.node("parent", [&] () { }); }); });
+
+			xml.node("report", [&] () {
+				xml.attribute("children", "yes");
+				xml.attribute("delay_ms", 1);
+				xml.attribute("buffer",   "64K");
+			});
+
+			for (unsigned i = 0; i < _num_children(); i++) {
+				xml.node("start", [&] () {
+					xml.attribute("name", String<16>("dummy_", i));
+					xml.attribute("caps", 50);
+					xml.node("binary", [&] () {
+						xml.attribute("name", "dummy"); });
+					xml.node("resource", [&] () {
+						xml.attribute("name", "RAM");
+						xml.attribute("quantum", "512K");
+					});
+
+					/* each update modifies the start node of one child */
+					xml.node("config", [&] () {
+						xml.attribute("generation", i == 0 ? _update : 0); });
+				});
+			}
+		});
+	}
+
+	void _handle_init_state()
+	{
+		_init_state.update();
+
+		Xml_node const state = _init_state.xml();
+		if (state.attribute_value("version", Version()) != _version)
+			return;
+
+		unsigned num_children = 0;
+		state.for_each_sub_node("child", [&] (Xml_node) { num_children++; });
+		if (num_children != _num_children())
+			return;
+
+		unsigned long const duration_ms = _timer.elapsed_ms() - _start_ms;
+
+		if (_update == 0) {
+			log(_num_children(), " children: start took ", duration_ms, " ms");
+			_update_ms_total = 0;
+		} else {
+			_update_ms_total += duration_ms;
+		}
+
+		if (_update == UPDATES) {
+			log(_num_children(), " children: update took ",
+			    _update_ms_total / UPDATES, " ms on average");
+
+			_update = 0;
+			if (++_step == _num_steps) {
+				log("--- finished init reconfiguration benchmark ---");
+				_env.parent().exit(0);
+				return;
+			}
+		} else {
+			_update++;
+		}
+		_generate_init_config();
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- init reconfiguration benchmark ---");
+
+		_config.xml().for_each_sub_node("step", [&] (Xml_node step) {
+			if (_num_steps < MAX_STEPS)
+				_child_counts[_num_steps++] = step.attribute_value("children", 0U); });
+
+		if (_num_steps == 0) {
+			error("no steps configured");
+			_env.parent().exit(-1);
+			return;
+		}
+
+		_init_config.enabled(true);
+		_init_state.sigh(_init_state_handler);
+		_generate_init_config();
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,179 @@
+/*
+ * \brief  Test and benchmark for the Internet checksum
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The test compares the results of the net library against a plain
+ * reference implementation that sums up the data 16 bit at a time, for
+ * full computations as well as for incremental updates. Afterwards, it
+ * measures the costs of both implementations for typical frame sizes.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/component.h>
+#include <base/log.h>
+#include <net/internet_checksum.h>
+#include <trace/timestamp.h>
+#include <os/bench.h>
+
+namespace Test {
+
+	using namespace Genode;
+	using namespace Net;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	enum {
+		BUF_SIZE = 2048,
+		MAX_SIZE = 1600,
+		ROUNDS   = 10000,
+		CHECKS   = 20000,
+	};
+
+	uint8_t _buf[BUF_SIZE];
+
+	Lcg_random _random { };
+
+	unsigned _next_random() { return _random.next() >> 16; }
+
+	void _fill_random(uint8_t *data, size_t size)
+	{
+		for (size_t i = 0; i < size; i++)
+			data[i] = _next_random();
+	}
+
+	static uint16_t _reference(uint8_t const *data, size_t size, uint32_t sum)
+	{
+		for (size_t i = 0; i + 1 < size; i += 2)
+			sum += data[i] << 8 | data[i + 1];
+
+		if (size & 1)
+			sum += data[size - 1] << 8;
+
+		while (sum >> 16)
+			sum = (sum & 0xffff) + (sum >> 16);
+
+		return ~sum;
+	}
+
+	/*
+	 * Both 0x0000 and 0xffff represent zero in one's complement arithmetic
+	 */
+	static bool _equal(uint16_t a, uint16_t b) {
+		return a == b || (a == 0 && b == 0xffff) || (a == 0xffff && b == 0); }
+
+	unsigned _check_full()
+	{
+		unsigned errors = 0;
+		for (unsigned i = 0; i < CHECKS; i++) {
+
+			/* packet headers are 16-bit aligned at least */
+			size_t   const offset = (_next_random() % 8) & ~1U;
+			size_t   const size   = _next_random() % MAX_SIZE;
+			uint32_t const sum    = _next_random();
+			uint8_t *const data   = _buf + offset;
+			_fill_random(data, size);
+
+			if (_reference(data, size, sum) == internet_checksum(data, size, sum))
+				continue;
+
+			error("wrong checksum, offset ", offset, " size ", size);
+			errors++;
+		}
+		return errors;
+	}
+
+	unsigned _check_incremental()
+	{
+		enum { SIZE = 64 };
+
+		unsigned errors = 0;
+		for (unsigned i = 0; i < CHECKS; i++) {
+
+			_fill_random(_buf, SIZE);
+			uint16_t const old_checksum = _reference(_buf, SIZE, 0);
+
+			/* modify an IPv4 address and a 16-bit field at random positions */
+			Internet_checksum_diff diff;
+			size_t const addr_offset = (_next_random() % (SIZE / 2)) & ~1U;
+			Ipv4_address old_addr, new_addr;
+			for (unsigned j = 0; j < Ipv4_packet::ADDR_LEN; j++) {
+				old_addr.addr[j] = _buf[addr_offset + j];
+				new_addr.addr[j] = _next_random();
+				_buf[addr_offset + j] = new_addr.addr[j];
+			}
+			diff.add_up_diff(old_addr, new_addr);
+
+			size_t const word_offset = SIZE / 2 + ((_next_random() % (SIZE / 2)) & ~1U);
+			uint16_t const old_word = _buf[word_offset] << 8 | _buf[word_offset + 1];
+			uint16_t const new_word = _next_random();
+			_buf[word_offset]     = new_word >> 8;
+			_buf[word_offset + 1] = new_word;
+			diff.add_up_diff(old_word, new_word);
+
+			if (_equal(diff.apply_to(old_checksum), _reference(_buf, SIZE, 0)))
+				continue;
+
+			error("wrong incremental checksum, round ", i);
+			errors++;
+		}
+		return errors;
+	}
+
+	template <typename FN>
+	Trace::Timestamp _cycles_per_frame(FN const &fn)
+	{
+		Trace::Timestamp const start = Trace::timestamp();
+		for (unsigned i = 0; i < ROUNDS; i++)
+			fn();
+
+		return (Trace::timestamp() - start) / ROUNDS;
+	}
+
+	void _measure(size_t size)
+	{
+		/* start behind an Ethernet header like an IPv4 packet would */
+		uint8_t *const data = _buf + 14;
+		_fill_random(data, size);
+
+		uint16_t volatile result = 0;
+		Trace::Timestamp const reference_cycles = _cycles_per_frame([&] () {
+			result = _reference(data, size, 0); });
+
+		Trace::Timestamp const library_cycles = _cycles_per_frame([&] () {
+			result = internet_checksum(data, size); });
+
+		log("frame size ", size, ": reference ", reference_cycles,
+		    " cycles, library ", library_cycles, " cycles");
+	}
+
+	Main(Env &)
+	{
+		log("--- Internet-checksum test ---");
+
+		unsigned const errors = _check_full() + _check_incremental();
+		if (errors) {
+			error("test failed with ", errors, " errors");
+			return;
+		}
+
+		size_t const sizes[] = { 64, 576, 1500 };
+		for (size_t size : sizes)
+			_measure(size);
+
+		log("--- Internet-checksum test finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,162 @@
+/*
+ * \brief  Throughput benchmark for the NIC loop-back service
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The benchmark streams packets of different sizes through a NIC loop-back
+ * server using the batch operations of the packet-stream interface.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/component.h>
+#include <base/log.h>
+#include <base/heap.h>
+#include <nic_session/connection.h>
+#include <nic/packet_allocator.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	enum {
+		BURST       = 64,
+		NUM_PACKETS = 200000,
+		BUF_SIZE    = Nic::Packet_allocator::DEFAULT_PACKET_SIZE * 512,
+	};
+
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Nic::Packet_allocator _tx_block_alloc { &_heap };
+
+	Nic::Connection _nic { _env, &_tx_block_alloc, BUF_SIZE, BUF_SIZE };
+
+	Timer::Connection _timer { _env };
+
+	Signal_handler<Main> _nic_handler { _env.ep(), *this, &Main::_handle_nic };
+
+	static size_t const _packet_sizes[];
+
+	unsigned _size_idx = 0;
+
+	size_t _packet_size() const { return _packet_sizes[_size_idx]; }
+
+	unsigned _tx_cnt = 0, _rx_cnt = 0;
+
+	unsigned long _start_ms = 0;
+
+	Packet_descriptor _packets[BURST];
+
+	void _start_round()
+	{
+		_tx_cnt = _rx_cnt = 0;
+		_start_ms = _timer.elapsed_ms();
+	}
+
+	void _finish_round()
+	{
+		unsigned long const duration_ms = max(1UL, _timer.elapsed_ms() - _start_ms);
+		unsigned long const bytes       = (unsigned long)NUM_PACKETS*_packet_size();
+
+		log("packet size ", _packet_size(), ": ",
+		    (unsigned)NUM_PACKETS, " packets in ", duration_ms, " ms, ",
+		    ((unsigned long)NUM_PACKETS*1000)/duration_ms, " packets/s, ",
+		    (bytes/1024)*1000/duration_ms/1024, " MiB/s");
+	}
+
+	void _send_packets()
+	{
+		unsigned const limit = min(NUM_PACKETS - _tx_cnt,
+		                           min((unsigned)BURST, _nic.tx()->submit_slots_free()));
+		unsigned n = 0;
+		try {
+			for (; n < limit; n++)
+				_packets[n] = _nic.tx()->alloc_packet(_packet_size());
+		}
+		catch (Nic::Session::Tx::Source::Packet_alloc_failed) { }
+
+		_tx_cnt += _nic.tx()->submit_packets(_packets, n);
+	}
+
+	void _collect_acknowledgements()
+	{
+		for (unsigned n; (n = _nic.tx()->get_acked_packets(_packets, BURST)); )
+			for (unsigned i = 0; i < n; i++)
+				_nic.tx()->release_packet(_packets[i]);
+	}
+
+	void _receive_packets()
+	{
+		for (;;) {
+			unsigned const limit = min((unsigned)BURST, _nic.rx()->ack_slots_free());
+			unsigned const n     = _nic.rx()->get_packets(_packets, limit);
+			if (!n)
+				return;
+
+			_nic.rx()->acknowledge_packets(_packets, n);
+			_rx_cnt += n;
+		}
+	}
+
+	void _handle_nic()
+	{
+		if (!_packet_size())
+			return;
+
+		_collect_acknowledgements();
+		_receive_packets();
+		_send_packets();
+
+		if (_rx_cnt < NUM_PACKETS)
+			return;
+
+		_finish_round();
+
+		_size_idx++;
+		if (!_packet_size()) {
+			log("--- finished NIC loop-back benchmark ---");
+			_env.parent().exit(0);
+			return;
+		}
+
+		_start_round();
+		_send_packets();
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- NIC loop-back benchmark ---");
+
+		/* the packet streams are handled by the entrypoint only */
+		_nic.tx()->single_threaded();
+		_nic.rx()->single_threaded();
+
+		_nic.tx_channel()->sigh_ready_to_submit(_nic_handler);
+		_nic.tx_channel()->sigh_ack_avail      (_nic_handler);
+		_nic.rx_channel()->sigh_ready_to_ack   (_nic_handler);
+		_nic.rx_channel()->sigh_packet_avail   (_nic_handler);
+
+		_start_round();
+		_send_packets();
+	}
+};
+
+
+Genode::size_t const Test::Main::_packet_sizes[] = { 64, 576, 1500, 0 };
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
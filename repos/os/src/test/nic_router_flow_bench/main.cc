@@ -0,0 +1,252 @@
+/*
+ * \brief  Stress benchmark for the flow tracking of the NIC router
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The benchmark connects to the router twice, once as client domain and
+ * once as server domain, and sends one UDP packet for each of a large
+ * number of distinct flows from the client to the server side. The first
+ * round creates a link state per flow, all subsequent rounds hit the
+ * existing link states.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/component.h>
+#include <base/log.h>
+#include <base/heap.h>
+#include <nic_session/connection.h>
+#include <nic/packet_allocator.h>
+#include <timer_session/connection.h>
+#include <net/ethernet.h>
+#include <net/ipv4.h>
+#include <net/udp.h>
+#include <net/arp.h>
+
+namespace Test {
+
+	using namespace Genode;
+	using namespace Net;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	enum {
+		NR_OF_FLOWS    = 100000,
+		FLOWS_PER_HOST = 50000,
+		ROUNDS         = 5,
+		WINDOW         = 32,
+		BUF_SIZE       = Nic::Packet_allocator::DEFAULT_PACKET_SIZE * 128,
+		PAYLOAD_SIZE   = 18,
+		UDP_SIZE       = sizeof(Udp_packet) + PAYLOAD_SIZE,
+		IP_SIZE        = sizeof(Ipv4_packet) + UDP_SIZE,
+		PACKET_SIZE    = sizeof(Ethernet_frame) + IP_SIZE,
+
+		/* RAM donated to the router for the link states of all flows */
+		CLIENT_LINK_RAM = 32*1024*1024,
+		SERVER_LINK_RAM = 8*1024*1024,
+	};
+
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Nic::Packet_allocator _client_alloc { &_heap };
+	Nic::Packet_allocator _server_alloc { &_heap };
+
+	Nic::Connection _client { _env, &_client_alloc, BUF_SIZE, BUF_SIZE, "client" };
+	Nic::Connection _server { _env, &_server_alloc, BUF_SIZE, BUF_SIZE, "server" };
+
+	Timer::Connection _timer { _env };
+
+	Signal_handler<Main> _nic_handler { _env.ep(), *this, &Main::_handle_nic };
+
+	Ipv4_address const _client_net  { Ipv4_packet::ip_from_string("10.0.1.0") };
+	Ipv4_address const _server_ip   { Ipv4_packet::ip_from_string("10.0.3.2") };
+	Mac_address  const _server_mac  { (uint8_t)0x02 };
+	Port         const _server_port { 7 };
+
+	unsigned      _round    = 0;
+	unsigned      _sent     = 0;
+	unsigned      _received = 0;
+	unsigned long _start_ms = 0;
+
+	void _build_flow_packet(void *base, unsigned const flow)
+	{
+		Ethernet_frame &eth = *new (base) Ethernet_frame(PACKET_SIZE);
+		eth.dst(Mac_address(0xff));
+		eth.src(_client.mac_address());
+		eth.type(Ethernet_frame::Type::IPV4);
+
+		/* spread the flows over multiple client hosts and ports */
+		Ipv4_address src_ip = _client_net;
+		src_ip.addr[3] = 2 + flow / FLOWS_PER_HOST;
+		Port const src_port(1024 + flow % FLOWS_PER_HOST);
+
+		Ipv4_packet &ip = *new (eth.data<void>()) Ipv4_packet(IP_SIZE);
+		ip.version(4);
+		ip.header_length(sizeof(Ipv4_packet) / 4);
+		ip.diff_service(0);
+		ip.ecn(0);
+		ip.total_length(IP_SIZE);
+		ip.identification(0);
+		ip.flags(0);
+		ip.fragment_offset(0);
+		ip.time_to_live(64);
+		ip.protocol(Ipv4_packet::Protocol::UDP);
+		ip.src(src_ip);
+		ip.dst(_server_ip);
+
+		Udp_packet &udp = *new (ip.data<void>()) Udp_packet(UDP_SIZE);
+		udp.src_port(src_port);
+		udp.dst_port(_server_port);
+		udp.length(UDP_SIZE);
+		memset(udp.data<void>(), 0, PAYLOAD_SIZE);
+		udp.update_checksum(ip.src(), ip.dst());
+		ip.checksum(Ipv4_packet::calculate_checksum(ip));
+	}
+
+	/**
+	 * Answer ARP requests of the router for the emulated server host
+	 */
+	void _reply_arp(Ethernet_frame const &request_eth, Arp_packet const &request)
+	{
+		if (request.opcode() != Arp_packet::REQUEST)
+			return;
+
+		Nic::Packet_descriptor pkt;
+		try { pkt = _server.tx()->alloc_packet(PACKET_SIZE); }
+		catch (Nic::Session::Tx::Source::Packet_alloc_failed) { return; }
+
+		size_t const size = sizeof(Ethernet_frame) + sizeof(Arp_packet);
+		void *const base = _server.tx()->packet_content(pkt);
+		memcpy(base, &request_eth, size);
+
+		Ethernet_frame &eth = *(Ethernet_frame *)base;
+		Arp_packet     &arp = *eth.data<Arp_packet>();
+		arp.opcode(Arp_packet::REPLY);
+		arp.dst_mac(request.src_mac());
+		arp.dst_ip(request.src_ip());
+		arp.src_mac(_server_mac);
+		arp.src_ip(request.dst_ip());
+		eth.dst(request_eth.src());
+		eth.src(_server_mac);
+
+		_server.tx()->submit_packet(pkt);
+	}
+
+	void _handle_server_packet(void *base, size_t size)
+	{
+		try {
+			Ethernet_frame &eth = *new (base) Ethernet_frame(size);
+			switch (eth.type()) {
+			case Ethernet_frame::Type::ARP:
+				_reply_arp(eth, *new (eth.data<void>())
+				           Arp_packet(size - sizeof(Ethernet_frame)));
+				return;
+			case Ethernet_frame::Type::IPV4:
+				_received++;
+				return;
+			default: return; }
+		}
+		catch (Ethernet_frame::No_ethernet_frame) { }
+		catch (Arp_packet::No_arp_packet) { }
+	}
+
+	void _send_packets()
+	{
+		while (_sent < NR_OF_FLOWS && _sent - _received < WINDOW &&
+		       _client.tx()->ready_to_submit())
+		{
+			Nic::Packet_descriptor pkt;
+			try { pkt = _client.tx()->alloc_packet(PACKET_SIZE); }
+			catch (Nic::Session::Tx::Source::Packet_alloc_failed) { return; }
+
+			_build_flow_packet(_client.tx()->packet_content(pkt), _sent++);
+			_client.tx()->submit_packet(pkt);
+		}
+	}
+
+	void _collect_acknowledgements(Nic::Connection &nic)
+	{
+		while (nic.tx()->ack_avail())
+			nic.tx()->release_packet(nic.tx()->get_acked_packet());
+	}
+
+	void _receive_packets(Nic::Connection &nic, bool const server)
+	{
+		while (nic.rx()->packet_avail() && nic.rx()->ready_to_ack()) {
+			Nic::Packet_descriptor const pkt = nic.rx()->get_packet();
+			if (server)
+				_handle_server_packet(nic.rx()->packet_content(pkt), pkt.size());
+
+			nic.rx()->acknowledge_packet(pkt);
+		}
+	}
+
+	void _start_round()
+	{
+		_sent = _received = 0;
+		_start_ms = _timer.elapsed_ms();
+	}
+
+	void _finish_round()
+	{
+		unsigned long const duration_ms = max(1UL, _timer.elapsed_ms() - _start_ms);
+
+		log(_round ? "existing" : "new", " flows: ", (unsigned)NR_OF_FLOWS,
+		    " packets in ", duration_ms, " ms, ",
+		    ((unsigned long)NR_OF_FLOWS*1000)/duration_ms, " packets/s");
+	}
+
+	void _handle_nic()
+	{
+		if (_round == ROUNDS)
+			return;
+
+		_collect_acknowledgements(_client);
+		_collect_acknowledgements(_server);
+		_receive_packets(_client, false);
+		_receive_packets(_server, true);
+
+		if (_received == NR_OF_FLOWS) {
+			_finish_round();
+			if (++_round == ROUNDS) {
+				log("--- finished NIC-router flow benchmark ---");
+				_env.parent().exit(0);
+				return;
+			}
+			_start_round();
+		}
+		_send_packets();
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- NIC-router flow benchmark ---");
+
+		_client.upgrade_ram(CLIENT_LINK_RAM);
+		_server.upgrade_ram(SERVER_LINK_RAM);
+
+		Nic::Connection *nics[] = { &_client, &_server };
+		for (Nic::Connection *nic : nics) {
+			nic->tx_channel()->sigh_ready_to_submit(_nic_handler);
+			nic->tx_channel()->sigh_ack_avail      (_nic_handler);
+			nic->rx_channel()->sigh_ready_to_ack   (_nic_handler);
+			nic->rx_channel()->sigh_packet_avail   (_nic_handler);
+		}
+		_start_round();
+		_send_packets();
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
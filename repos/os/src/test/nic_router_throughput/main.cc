@@ -0,0 +1,276 @@
+/*
+ * \brief  Throughput benchmark for the forwarding path of the NIC router
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The benchmark connects to the router twice, once as client domain and
+ * once as server domain, and streams MTU-sized UDP packets of one flow from
+ * the client to the server side. Each measurement interval, it reports the
+ * amount of data that arrived at the server side.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/component.h>
+#include <base/log.h>
+#include <base/heap.h>
+#include <nic_session/connection.h>
+#include <nic/packet_allocator.h>
+#include <timer_session/connection.h>
+#include <net/ethernet.h>
+#include <net/ipv4.h>
+#include <net/udp.h>
+#include <net/arp.h>
+
+namespace Test {
+
+	using namespace Genode;
+	using namespace Net;
+
+	struct Nic_connection;
+	struct Main;
+}
+
+
+/**
+ * NIC connection that donates the quota needed for zero-copy forwarding
+ *
+ * Besides the capabilities of a regular session, the router needs three
+ * capabilities for the TX slot and the region map of the RX buffer.
+ */
+struct Test::Nic_connection : Genode::Connection<Nic::Session>,
+                              Nic::Session_client
+{
+	enum { ZERO_COPY_CAP_QUOTA = 3 };
+
+	Capability<Nic::Session> _session(Parent &parent, char const *label,
+	                                  size_t buf_size)
+	{
+		return session(parent,
+		               "ram_quota=%ld, cap_quota=%ld, tx_buf_size=%ld, "
+		               "rx_buf_size=%ld, label=\"%s\"",
+		               32*1024*sizeof(long) + 2*buf_size,
+		               CAP_QUOTA + ZERO_COPY_CAP_QUOTA, buf_size, buf_size,
+		               label);
+	}
+
+	Nic_connection(Env &env, Range_allocator &alloc, size_t buf_size,
+	               char const *label)
+	:
+		Genode::Connection<Nic::Session>(env, _session(env.parent(), label,
+		                                               buf_size)),
+		Nic::Session_client(cap(), alloc, env.rm())
+	{ }
+};
+
+
+struct Test::Main
+{
+	enum {
+		INTERVALS    = 5,
+		INTERVAL_US  = 1000*1000,
+		WINDOW       = 64,
+		BUF_SIZE     = Nic::Packet_allocator::DEFAULT_PACKET_SIZE * 128,
+		PACKET_SIZE  = 1514,
+		IP_SIZE      = PACKET_SIZE - sizeof(Ethernet_frame),
+		UDP_SIZE     = IP_SIZE - sizeof(Ipv4_packet),
+		PAYLOAD_SIZE = UDP_SIZE - sizeof(Udp_packet),
+	};
+
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Nic::Packet_allocator _client_alloc { &_heap };
+	Nic::Packet_allocator _server_alloc { &_heap };
+
+	Nic_connection _client { _env, _client_alloc, BUF_SIZE, "client" };
+	Nic_connection _server { _env, _server_alloc, BUF_SIZE, "server" };
+
+	Timer::Connection _timer { _env };
+
+	Signal_handler<Main> _nic_handler { _env.ep(), *this, &Main::_handle_nic };
+
+	Ipv4_address const _client_ip   { Ipv4_packet::ip_from_string("10.0.1.2") };
+	Ipv4_address const _server_ip   { Ipv4_packet::ip_from_string("10.0.3.2") };
+	Mac_address  const _server_mac  { (uint8_t)0x02 };
+	Port         const _client_port { 1024 };
+	Port         const _server_port { 7 };
+
+	unsigned long _sent           = 0;
+	unsigned long _received       = 0;
+	unsigned long _received_bytes = 0;
+	unsigned      _interval       = 0;
+	unsigned long _start_ms       = 0;
+
+	Timer::Periodic_timeout<Main> _interval_timeout {
+		_timer, *this, &Main::_handle_interval, Microseconds(INTERVAL_US) };
+
+	void _build_packet(void *base)
+	{
+		Ethernet_frame &eth = *new (base) Ethernet_frame(PACKET_SIZE);
+		eth.dst(Mac_address(0xff));
+		eth.src(_client.mac_address());
+		eth.type(Ethernet_frame::Type::IPV4);
+
+		Ipv4_packet &ip = *new (eth.data<void>()) Ipv4_packet(IP_SIZE);
+		ip.version(4);
+		ip.header_length(sizeof(Ipv4_packet) / 4);
+		ip.diff_service(0);
+		ip.ecn(0);
+		ip.total_length(IP_SIZE);
+		ip.identification(0);
+		ip.flags(0);
+		ip.fragment_offset(0);
+		ip.time_to_live(64);
+		ip.protocol(Ipv4_packet::Protocol::UDP);
+		ip.src(_client_ip);
+		ip.dst(_server_ip);
+
+		Udp_packet &udp = *new (ip.data<void>()) Udp_packet(UDP_SIZE);
+		udp.src_port(_client_port);
+		udp.dst_port(_server_port);
+		udp.length(UDP_SIZE);
+		memset(udp.data<void>(), 0x5a, PAYLOAD_SIZE);
+		udp.update_checksum(ip.src(), ip.dst());
+		ip.checksum(Ipv4_packet::calculate_checksum(ip));
+	}
+
+	/**
+	 * Answer ARP requests of the router for the emulated server host
+	 */
+	void _reply_arp(Ethernet_frame const &request_eth, Arp_packet const &request)
+	{
+		if (request.opcode() != Arp_packet::REQUEST)
+			return;
+
+		size_t const size = sizeof(Ethernet_frame) + sizeof(Arp_packet);
+		Nic::Packet_descriptor pkt;
+		try { pkt = _server.tx()->alloc_packet(size); }
+		catch (Nic::Session::Tx::Source::Packet_alloc_failed) { return; }
+
+		void *const base = _server.tx()->packet_content(pkt);
+		memcpy(base, &request_eth, size);
+
+		Ethernet_frame &eth = *(Ethernet_frame *)base;
+		Arp_packet     &arp = *eth.data<Arp_packet>();
+		arp.opcode(Arp_packet::REPLY);
+		arp.dst_mac(request.src_mac());
+		arp.dst_ip(request.src_ip());
+		arp.src_mac(_server_mac);
+		arp.src_ip(request.dst_ip());
+		eth.dst(request_eth.src());
+		eth.src(_server_mac);
+
+		_server.tx()->submit_packet(pkt);
+	}
+
+	void _handle_server_packet(void *base, size_t size)
+	{
+		try {
+			Ethernet_frame &eth = *new (base) Ethernet_frame(size);
+			switch (eth.type()) {
+			case Ethernet_frame::Type::ARP:
+				_reply_arp(eth, *new (eth.data<void>())
+				           Arp_packet(size - sizeof(Ethernet_frame)));
+				return;
+			case Ethernet_frame::Type::IPV4:
+				_received++;
+				_received_bytes += size;
+				return;
+			default: return; }
+		}
+		catch (Ethernet_frame::No_ethernet_frame) { }
+		catch (Arp_packet::No_arp_packet) { }
+	}
+
+	void _send_packets()
+	{
+		while (_sent - _received < WINDOW && _client.tx()->ready_to_submit())
+		{
+			Nic::Packet_descriptor pkt;
+			try { pkt = _client.tx()->alloc_packet(PACKET_SIZE); }
+			catch (Nic::Session::Tx::Source::Packet_alloc_failed) { return; }
+
+			_build_packet(_client.tx()->packet_content(pkt));
+			_client.tx()->submit_packet(pkt);
+			_sent++;
+		}
+	}
+
+	void _collect_acknowledgements(Nic_connection &nic)
+	{
+		while (nic.tx()->ack_avail())
+			nic.tx()->release_packet(nic.tx()->get_acked_packet());
+	}
+
+	void _receive_packets(Nic_connection &nic, bool const server)
+	{
+		while (nic.rx()->packet_avail() && nic.rx()->ready_to_ack()) {
+			Nic::Packet_descriptor const pkt = nic.rx()->get_packet();
+			if (server)
+				_handle_server_packet(nic.rx()->packet_content(pkt), pkt.size());
+
+			nic.rx()->acknowledge_packet(pkt);
+		}
+	}
+
+	void _handle_interval(Duration)
+	{
+		if (_interval == INTERVALS)
+			return;
+
+		unsigned long const now_ms      = _timer.elapsed_ms();
+		unsigned long const duration_ms = max(1UL, now_ms - _start_ms);
+
+		log("received ", _received_bytes / 1024, " KiB in ", duration_ms,
+		    " ms, ", (_received_bytes / duration_ms) * 1000 / 1024, " KiB/s");
+
+		/* packets that were dropped on the way must not block the window */
+		_sent           = _received;
+		_received_bytes = 0;
+		_start_ms       = now_ms;
+
+		if (++_interval == INTERVALS) {
+			log("--- finished NIC-router throughput benchmark ---");
+			_env.parent().exit(0);
+			return;
+		}
+		_send_packets();
+	}
+
+	void _handle_nic()
+	{
+		if (_interval == INTERVALS)
+			return;
+
+		_collect_acknowledgements(_client);
+		_collect_acknowledgements(_server);
+		_receive_packets(_client, false);
+		_receive_packets(_server, true);
+		_send_packets();
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- NIC-router throughput benchmark ---");
+
+		Nic_connection *nics[] = { &_client, &_server };
+		for (Nic_connection *nic : nics) {
+			nic->tx_channel()->sigh_ready_to_submit(_nic_handler);
+			nic->tx_channel()->sigh_ack_avail      (_nic_handler);
+			nic->rx_channel()->sigh_ready_to_ack   (_nic_handler);
+			nic->rx_channel()->sigh_packet_avail   (_nic_handler);
+		}
+		_start_ms = _timer.elapsed_ms();
+		_send_packets();
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-nic_router_throughput
+SRC_CC = main.cc
+LIBS   = base net
@@ -0,0 +1,194 @@
+/*
+ * \brief  Frame-rate and latency benchmark of nitpicker
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The benchmark opens a number of nitpicker sessions. Each session animates
+ * one view by repainting its buffer and moving the view whenever nitpicker
+ * delivers a sync signal. Once per second, the benchmark reports the number
+ * of frames per second achieved per client and the average latency between
+ * refreshing a buffer and the next sync signal.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_dataspace.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <nitpicker_session/connection.h>
+#include <timer_session/connection.h>
+#include <nitpicker_gfx/box_painter.h>
+#include <os/pixel_rgb565.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Client;
+	struct Main;
+}
+
+
+struct Test::Client : List<Client>::Element
+{
+	typedef Nitpicker::Session::View_handle View_handle;
+	typedef Nitpicker::Session::Command     Command;
+
+	Env               &_env;
+	Timer::Connection &_timer;
+	unsigned const     _index;
+	Nitpicker::Area    _screen;
+	Nitpicker::Area    _size;
+
+	Nitpicker::Connection _nitpicker { _env, String<32>("client-", _index).string() };
+
+	Framebuffer::Mode const _mode { (int)_size.w(), (int)_size.h(),
+	                                Framebuffer::Mode::RGB565 };
+
+	Dataspace_capability _init_buffer()
+	{
+		_nitpicker.buffer(_mode, false);
+		return _nitpicker.framebuffer()->dataspace();
+	}
+
+	Attached_dataspace _fb_ds { _env.rm(), _init_buffer() };
+
+	Surface<Pixel_rgb565> _surface { _fb_ds.local_addr<Pixel_rgb565>(), _size };
+
+	View_handle _view = _nitpicker.create_view();
+
+	Nitpicker::Point _pos;
+	int              _dx = 1 + _index % 4, _dy = 1 + _index % 3;
+
+	unsigned      _frame      = 0;
+	unsigned long _refresh_us = 0;
+	bool          _pending    = false;
+
+	/* statistics, reset by 'Main' */
+	unsigned           frames     = 0;
+	unsigned long long latency_us = 0;
+
+	Signal_handler<Client> _sync_handler { _env.ep(), *this, &Client::_handle_sync };
+
+	void _animate()
+	{
+		/* move view and bounce at the screen boundaries */
+		int const max_x = (int)_screen.w() - (int)_size.w(),
+		          max_y = (int)_screen.h() - (int)_size.h();
+
+		if (_pos.x() + _dx < 0 || _pos.x() + _dx > max_x) _dx = -_dx;
+		if (_pos.y() + _dy < 0 || _pos.y() + _dy > max_y) _dy = -_dy;
+
+		_pos = Nitpicker::Point(_pos.x() + _dx, _pos.y() + _dy);
+
+		_nitpicker.enqueue<Command::Geometry>(_view, Nitpicker::Rect(_pos, _size));
+		_nitpicker.execute();
+
+		/* repaint buffer with a frame-dependent color */
+		_frame++;
+		Box_painter::paint(_surface, Nitpicker::Rect(Nitpicker::Point(0, 0), _size),
+		                   Color(_frame*3, _index*40, 255 - _frame));
+
+		_nitpicker.framebuffer()->refresh(0, 0, _size.w(), _size.h());
+
+		_refresh_us = _timer.elapsed_us();
+		_pending    = true;
+	}
+
+	void _handle_sync()
+	{
+		if (_pending) {
+			latency_us += _timer.elapsed_us() - _refresh_us;
+			frames++;
+			_pending = false;
+		}
+		_animate();
+	}
+
+	Client(Env &env, Timer::Connection &timer, unsigned index,
+	       Nitpicker::Area screen, Nitpicker::Area size)
+	:
+		_env(env), _timer(timer), _index(index), _screen(screen), _size(size),
+		_pos((index*97) % max(1, (int)screen.w() - (int)size.w()),
+		     (index*61) % max(1, (int)screen.h() - (int)size.h()))
+	{
+		_nitpicker.enqueue<Command::Title>(_view, "nitpicker_bench");
+		_nitpicker.enqueue<Command::To_front>(_view);
+		_nitpicker.framebuffer()->sync_sigh(_sync_handler);
+		_animate();
+	}
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	List<Client> _clients { };
+
+	unsigned const _num_clients = _config.xml().attribute_value("clients", 8U);
+	unsigned const _seconds     = _config.xml().attribute_value("seconds", 10U);
+
+	unsigned _elapsed = 0;
+
+	Signal_handler<Main> _timeout_handler { _env.ep(), *this, &Main::_handle_timeout };
+
+	void _handle_timeout()
+	{
+		unsigned           frames     = 0;
+		unsigned long long latency_us = 0;
+
+		for (Client *c = _clients.first(); c; c = c->next()) {
+			frames     += c->frames;
+			latency_us += c->latency_us;
+			c->frames     = 0;
+			c->latency_us = 0;
+		}
+
+		log(_num_clients, " clients: ", frames/_num_clients, " fps, ",
+		    frames ? (unsigned long)(latency_us/frames) : 0UL, " us latency");
+
+		if (++_elapsed == _seconds)
+			log("--- nitpicker benchmark finished ---");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		Nitpicker::Area const size(_config.xml().attribute_value("width",  256U),
+		                           _config.xml().attribute_value("height", 256U));
+
+		/* obtain screen size via a dedicated session */
+		Nitpicker::Area screen;
+		{
+			Nitpicker::Connection nitpicker(_env, "screen");
+			Framebuffer::Mode const mode = nitpicker.mode();
+			screen = Nitpicker::Area(mode.width(), mode.height());
+		}
+
+		log("--- nitpicker benchmark started (", _num_clients, " clients, ",
+		    size, " pixels each, screen ", screen, ") ---");
+
+		for (unsigned i = 0; i < _num_clients; i++)
+			_clients.insert(new (_heap) Client(_env, _timer, i, screen, size));
+
+		_timer.sigh(_timeout_handler);
+		_timer.trigger_periodic(1000*1000);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,111 @@
+/*
+ * \brief  Benchmark for the packet allocator
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The benchmark measures the cost of allocating and freeing packets of a
+ * packet-stream buffer that is occupied to different degrees. The occupied
+ * blocks are scattered over the whole buffer to model fragmentation.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <nic/packet_allocator.h>
+#include <trace/timestamp.h>
+#include <os/bench.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	enum {
+		BLOCK_SIZE = Nic::Packet_allocator::DEFAULT_PACKET_SIZE,
+		BUF_SIZE   = 2*1024*1024,
+		NUM_BLOCKS = BUF_SIZE / BLOCK_SIZE,
+		ROUNDS     = 100000,
+	};
+
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	void *_blocks[NUM_BLOCKS];
+
+	Lcg_random _random { };
+
+	unsigned _next_random() { return _random.next() >> 16; }
+
+	void _measure(unsigned occupancy_percent, size_t packet_size)
+	{
+		Nic::Packet_allocator alloc(&_heap);
+		alloc.add_range(BLOCK_SIZE, BUF_SIZE);
+
+		/* occupy the whole buffer, then free a random selection of blocks */
+		unsigned num_allocated = 0;
+		for (; num_allocated < NUM_BLOCKS; num_allocated++)
+			if (!alloc.alloc(BLOCK_SIZE, &_blocks[num_allocated]))
+				break;
+
+		unsigned const num_occupied = (num_allocated*occupancy_percent)/100;
+
+		for (unsigned n = num_allocated; n > num_occupied; n--) {
+			unsigned const i = _next_random() % n;
+			alloc.free(_blocks[i], BLOCK_SIZE);
+			_blocks[i] = _blocks[n - 1];
+		}
+
+		Trace::Timestamp const start = Trace::timestamp();
+
+		unsigned failed = 0;
+		for (unsigned i = 0; i < ROUNDS; i++) {
+			void *packet = nullptr;
+			if (!alloc.alloc(packet_size, &packet)) {
+				failed++;
+				continue;
+			}
+			alloc.free(packet, packet_size);
+		}
+
+		Trace::Timestamp const cycles = Trace::timestamp() - start;
+
+		log("occupancy ", occupancy_percent, "%, packet size ", packet_size, ": ",
+		    cycles/ROUNDS, " cycles per alloc/free",
+		    failed ? " (some allocations failed)" : "");
+
+		for (unsigned i = 0; i < num_occupied; i++)
+			alloc.free(_blocks[i], BLOCK_SIZE);
+
+		alloc.remove_range(BLOCK_SIZE, BUF_SIZE);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- packet-allocator benchmark ---");
+
+		unsigned const occupancies[] = { 0, 50, 90 };
+		size_t   const sizes[]       = { 64, 1500, 4*BLOCK_SIZE };
+
+		for (unsigned occupancy : occupancies)
+			for (size_t size : sizes)
+				_measure(occupancy, size);
+
+		log("--- packet-allocator benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,214 @@
+/*
+ * \brief  Benchmark of distributing a large report to many readers
+ * \author agent
+ * \date   2026-10-17
+ *
+ * One reporter repeatedly submits a report of 1 MiB, which is observed by
+ * 50 ROM clients. A round is complete once each reader has obtained the new
+ * content. Finally, the reporter submits the same content again, which is
+ * expected not to wake up any reader.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/log.h>
+#include <os/reporter.h>
+#include <util/reconstructible.h>
+#include <util/string.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Reader;
+	struct Main;
+
+	enum {
+		NUM_READERS      = 50,
+		REPORT_SIZE      = 1024*1024,
+		ROUNDS           = 20,
+		UNCHANGED_ROUNDS = 20,
+		ROUND_DIGITS     = 8,
+	};
+}
+
+
+struct Test::Reader
+{
+	struct Observer { virtual void reader_updated() = 0; };
+
+	Observer &_observer;
+
+	Attached_rom_dataspace _rom;
+
+	unsigned _round = 0;
+
+	unsigned long signals = 0;
+
+	unsigned _round_of_content()
+	{
+		unsigned round = 0;
+		ascii_to(_rom.local_addr<char const>(), round);
+		return round;
+	}
+
+	void _handle_update()
+	{
+		signals++;
+
+		_rom.update();
+
+		unsigned const round = _round_of_content();
+		if (round == _round)
+			return;
+
+		_round = round;
+		_observer.reader_updated();
+	}
+
+	Signal_handler<Reader> _update_handler;
+
+	Reader(Env &env, Observer &observer, char const *label)
+	:
+		_observer(observer), _rom(env, label),
+		_update_handler(env.ep(), *this, &Reader::_handle_update)
+	{
+		_rom.sigh(_update_handler);
+	}
+};
+
+
+struct Test::Main : Reader::Observer
+{
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Attached_ram_dataspace _content_ds { _env.ram(), _env.rm(), REPORT_SIZE };
+
+	char * const _content = _content_ds.local_addr<char>();
+
+	Reporter _reporter { _env, "data", "data", REPORT_SIZE + 4096 };
+
+	Constructible<Reader> _readers[NUM_READERS];
+
+	unsigned      _round    = 0;
+	unsigned      _pending  = 0;
+	unsigned long _start_ms = 0;
+	unsigned long _signals  = 0;
+
+	unsigned long _total_signals() const
+	{
+		unsigned long cnt = 0;
+		for (unsigned i = 0; i < NUM_READERS; i++)
+			cnt += _readers[i]->signals;
+		return cnt;
+	}
+
+	void _report(unsigned round)
+	{
+		/* write round number at the start of the content */
+		char digits[ROUND_DIGITS + 1];
+		snprintf(digits, sizeof(digits), "%08u", round);
+		memcpy(_content, digits, ROUND_DIGITS);
+
+		_reporter.report(_content, REPORT_SIZE);
+	}
+
+	void _start_round()
+	{
+		_round++;
+		_pending = NUM_READERS;
+		_report(_round);
+	}
+
+	void _measure_unchanged_reports()
+	{
+		_signals = _total_signals();
+
+		unsigned long const start_ms = _timer.elapsed_ms();
+
+		for (unsigned i = 0; i < UNCHANGED_ROUNDS; i++)
+			_report(_round);
+
+		unsigned long const duration_ms = _timer.elapsed_ms() - start_ms;
+
+		log("submitted ", (unsigned)UNCHANGED_ROUNDS, " unchanged reports in ",
+		    duration_ms, " ms");
+
+		/* give the readers the chance to observe spurious notifications */
+		_timer.trigger_once(500*1000);
+	}
+
+	void _handle_timeout()
+	{
+		unsigned long const spurious = _total_signals() - _signals;
+
+		log("readers woken up by unchanged reports: ", spurious);
+		log("--- report_rom benchmark finished ---");
+	}
+
+	Signal_handler<Main> _timeout_handler {
+		_env.ep(), *this, &Main::_handle_timeout };
+
+	/**
+	 * Reader::Observer interface
+	 */
+	void reader_updated() override
+	{
+		if (!_pending || --_pending)
+			return;
+
+		if (_round < ROUNDS) {
+			_start_round();
+			return;
+		}
+
+		unsigned long const duration_ms =
+			max(1UL, _timer.elapsed_ms() - _start_ms);
+
+		unsigned long const delivered_mib =
+			((unsigned long)ROUNDS*NUM_READERS*REPORT_SIZE) / (1024*1024);
+
+		log((unsigned)ROUNDS, " reports of ", (unsigned)REPORT_SIZE/1024,
+		    " KiB delivered to ", (unsigned)NUM_READERS, " readers in ",
+		    duration_ms, " ms (", duration_ms*1000/ROUNDS, " us per report, ",
+		    delivered_mib*1000/duration_ms, " MiB/s)");
+
+		_measure_unchanged_reports();
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- report_rom benchmark started ---");
+
+		_timer.sigh(_timeout_handler);
+
+		memset(_content, 'x', REPORT_SIZE);
+		_content[REPORT_SIZE - 1] = 0;
+
+		_reporter.enabled(true);
+		_report(0);
+
+		for (unsigned i = 0; i < NUM_READERS; i++) {
+			String<32> const label("reader_", i);
+			_readers[i].construct(_env, *this, label.string());
+		}
+
+		_start_ms = _timer.elapsed_ms();
+		_start_round();
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
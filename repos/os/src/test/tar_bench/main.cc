@@ -0,0 +1,175 @@
+/*
+ * \brief  Benchmark of looking up files in a large TAR archive
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The benchmark measures the startup and open latency of the 'tar_rom'
+ * server and of the VFS tar plugin for an archive that contains the files
+ * 'file_0' to 'file_<n-1>'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <rom_session/connection.h>
+#include <timer_session/connection.h>
+#include <vfs/dir_file_system.h>
+#include <vfs/file_system_factory.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+
+	typedef String<32> File_name;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _num_files = _config.xml().attribute_value("files", 5000U);
+
+	Timer::Connection _timer { _env };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	struct Io_response_handler : Vfs::Io_response_handler
+	{
+		void handle_io_response(Vfs::Vfs_handle::Context *) override { }
+	} _io_response_handler { };
+
+	/**
+	 * Return file name to be accessed in step 'i'
+	 *
+	 * The files are visited in a scattered order to avoid favoring a
+	 * sequential scan of the archive.
+	 */
+	File_name _file_name(unsigned i) const {
+		return File_name("file_", (i*7919) % _num_files); }
+
+	void _check_content(char const *content, File_name const &name)
+	{
+		if (strcmp(content, name.string(), name.length() - 1) != 0)
+			error("unexpected content of ", name);
+	}
+
+	void _log_result(char const *what, unsigned long ms, unsigned n)
+	{
+		log(what, ": ", ms, " ms total, ", ms*1000/max(n, 1U), " us per file");
+	}
+
+	void _measure_tar_rom()
+	{
+		/*
+		 * The first session request is answered only after the server
+		 * has indexed the archive.
+		 */
+		unsigned long const start_ms = _timer.elapsed_ms();
+		{
+			Rom_connection rom(_env, "file_0");
+		}
+		log("tar_rom: first open after ", _timer.elapsed_ms() - start_ms, " ms");
+
+		unsigned long const open_ms = _timer.elapsed_ms();
+		for (unsigned i = 0; i < _num_files; i++)
+			Rom_connection rom(_env, _file_name(i).string());
+
+		_log_result("tar_rom: open", _timer.elapsed_ms() - open_ms, _num_files);
+
+		/* check content of a sample of files */
+		for (unsigned i = 0; i < _num_files; i += _num_files/16 + 1) {
+			File_name const name = _file_name(i);
+			Attached_rom_dataspace rom(_env, name.string());
+			_check_content(rom.local_addr<char const>(), name);
+		}
+	}
+
+	void _measure_vfs()
+	{
+		Vfs::Global_file_system_factory fs_factory { _heap };
+
+		unsigned long const start_ms = _timer.elapsed_ms();
+
+		Vfs::Dir_file_system vfs_root(_env, _heap, _config.xml().sub_node("vfs"),
+		                              _io_response_handler, fs_factory);
+
+		log("vfs: startup took ", _timer.elapsed_ms() - start_ms, " ms");
+
+		unsigned long const stat_ms = _timer.elapsed_ms();
+		for (unsigned i = 0; i < _num_files; i++) {
+			Vfs::Directory_service::Stat st;
+			if (vfs_root.stat(Vfs::Absolute_path(_file_name(i).string()).base(), st)
+			    != Vfs::Directory_service::STAT_OK)
+				error("stat of ", _file_name(i), " failed");
+		}
+		_log_result("vfs: stat", _timer.elapsed_ms() - stat_ms, _num_files);
+
+		unsigned long const open_ms = _timer.elapsed_ms();
+		for (unsigned i = 0; i < _num_files; i++) {
+
+			File_name const name = _file_name(i);
+			Vfs::Absolute_path const path(name.string());
+
+			Vfs::Vfs_handle *handle = nullptr;
+			if (vfs_root.open(path.base(), Vfs::Directory_service::OPEN_MODE_RDONLY,
+			                  &handle, _heap) != Vfs::Directory_service::OPEN_OK) {
+				error("open of ", name, " failed");
+				continue;
+			}
+
+			char buf[32] { };
+			Vfs::file_size n = 0;
+			handle->fs().complete_read(handle, buf, sizeof(buf) - 1, n);
+			_check_content(buf, name);
+
+			handle->ds().close(handle);
+		}
+		_log_result("vfs: open and read", _timer.elapsed_ms() - open_ms, _num_files);
+
+		unsigned long const dir_ms = _timer.elapsed_ms();
+		Vfs::file_size const num_dirent = vfs_root.num_dirent("/");
+
+		Vfs::Vfs_handle *dir = nullptr;
+		vfs_root.opendir("/", false, &dir, _heap);
+
+		Vfs::Directory_service::Dirent dirent;
+		unsigned entries = 0;
+		for (Vfs::file_size i = 0; i < num_dirent; i++) {
+			Vfs::file_size n = 0;
+			dir->seek(i*sizeof(dirent));
+			dir->fs().complete_read(dir, (char *)&dirent, sizeof(dirent), n);
+			if (n == sizeof(dirent))
+				entries++;
+		}
+		dir->ds().close(dir);
+
+		_log_result("vfs: readdir", _timer.elapsed_ms() - dir_ms, entries);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- tar benchmark started (", _num_files, " files) ---");
+
+		_measure_tar_rom();
+		_measure_vfs();
+
+		log("--- tar benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-tar_bench
+SRC_CC = main.cc
+LIBS   = base vfs
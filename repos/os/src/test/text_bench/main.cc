@@ -0,0 +1,235 @@
+/*
+ * \brief  Benchmark of the text painter and the glyph cache
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The benchmark fills a surface of the configured number of columns and
+ * lines with text repeatedly for about one second per drawing mode and
+ * reports the number of glyphs drawn per second as well as the time needed
+ * for one screen. The "cells" mode draws each character cell with its own
+ * background color the way the terminal does. Beforehand, the benchmark
+ * checks that the glyph cache yields the same pixels as the text painter.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+#include <os/bench.h>
+#include <nitpicker_gfx/text_painter.h>
+#include <nitpicker_gfx/glyph_cache.h>
+#include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	typedef Surface_base::Area  Area;
+	typedef Surface_base::Point Point;
+	typedef Surface_base::Rect  Rect;
+
+	struct Main;
+}
+
+
+extern char _binary_default_tff_start;
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _columns = _config.xml().attribute_value("columns", 200U);
+	unsigned const _lines   = _config.xml().attribute_value("lines",    60U);
+
+	unsigned long const _duration_ms =
+		_config.xml().attribute_value("duration_ms", 1000UL);
+
+	Timer::Connection _timer { _env };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Text_painter::Font const _font { &_binary_default_tff_start };
+
+	Glyph_cache _glyph_cache { _heap };
+
+	/* the glyphs of the font have different widths, use the widest */
+	static int _max_glyph_w(Text_painter::Font const &font)
+	{
+		int w = 0;
+		for (unsigned c = 33; c < 127; c++)
+			w = max(w, (int)font.wtab[c]);
+		return w;
+	}
+
+	int const _cell_w = _max_glyph_w(_font);
+	int const _cell_h = _font.str_h("m");
+
+	Area const _area { _columns*_cell_w, _lines*_cell_h };
+
+	unsigned _errors = 0;
+
+	Lcg_random _random { };
+
+	/**
+	 * Return printable character for the given cell
+	 */
+	static char _character(unsigned column, unsigned line) {
+		return 33 + (line*7 + column) % 94; }
+
+	/**
+	 * Draw screens until the configured duration is over, log the throughput
+	 */
+	template <typename FN>
+	void _measure(char const *format, char const *mode, FN const &draw_screen)
+	{
+		Bench_result const r = bench_for(_timer, _duration_ms, draw_screen);
+
+		unsigned long long const glyphs = (unsigned long long)r.rounds
+		                                * _columns*_lines;
+
+		log(format, " ", mode, ": ", glyphs/r.ms, " glyphs/ms, ",
+		    r.ms*1000/r.rounds, " us per screen");
+	}
+
+	/**
+	 * Compare the glyph cache with the text painter
+	 */
+	template <typename PT>
+	void _check(char const *format, Surface<PT> &surface, PT *pixels)
+	{
+		size_t const num_pixels = _area.count();
+
+		Attached_ram_dataspace ref_ds(_env.ram(), _env.rm(), num_pixels*sizeof(PT));
+		PT * const ref_pixels = ref_ds.local_addr<PT>();
+
+		Surface<PT> ref(ref_pixels, _area);
+
+		for (unsigned i = 0; i < 100; i++) {
+
+			for (size_t j = 0; j < num_pixels; j++)
+				pixels[j].pixel = ref_pixels[j].pixel = _random.next() >> 8;
+
+			char string[128];
+			unsigned const len = _random.next() % sizeof(string);
+			for (unsigned j = 0; j < len; j++)
+				string[j] = 32 + _random.next() % 95;
+			string[len] = 0;
+
+			Rect const clip(Point(_random.next() % _area.w(), _random.next() % _area.h()),
+			                Area (_random.next() % _area.w(), _random.next() % _area.h()));
+
+			Point const pos((int)(_random.next() % _area.w()) - 100,
+			                (int)(_random.next() % _area.h()) - _cell_h/2);
+
+			Color const color(_random.next() >> 24, _random.next() >> 24, _random.next() >> 24,
+			                  i % 2 ? 255 : _random.next() >> 24);
+
+			surface.clip(clip);
+			ref.clip(clip);
+
+			_glyph_cache.paint(surface, pos, _font, color, string);
+			Text_painter::paint(ref, pos, _font, color, string);
+
+			for (size_t j = 0; j < num_pixels; j++) {
+				if (pixels[j].pixel == ref_pixels[j].pixel)
+					continue;
+
+				error(format, ": glyph cache yields ", Hex(pixels[j].pixel),
+				      " instead of ", Hex(ref_pixels[j].pixel),
+				      " at pixel ", j);
+				_errors++;
+				break;
+			}
+		}
+
+		surface.clip(Rect(Point(0, 0), _area));
+	}
+
+	template <typename PT>
+	void _bench(char const *format)
+	{
+		Attached_ram_dataspace surface_ds(_env.ram(), _env.rm(),
+		                                  _area.count()*sizeof(PT));
+
+		PT * const pixels = surface_ds.local_addr<PT>();
+
+		Surface<PT> surface(pixels, _area);
+
+		_check<PT>(format, surface, pixels);
+
+		/* one string per line */
+		Attached_ram_dataspace text_ds(_env.ram(), _env.rm(),
+		                               _lines*(_columns + 1));
+
+		char * const text = text_ds.local_addr<char>();
+		for (unsigned line = 0; line < _lines; line++) {
+			char * const s = text + line*(_columns + 1);
+			for (unsigned column = 0; column < _columns; column++)
+				s[column] = _character(column, line);
+			s[_columns] = 0;
+		}
+
+		Color const color(200, 200, 200);
+
+		_measure(format, "text painter", [&] () {
+			for (unsigned line = 0; line < _lines; line++)
+				Text_painter::paint(surface, Point(0, line*_cell_h), _font,
+				                    color, text + line*(_columns + 1)); });
+
+		_measure(format, "glyph cache", [&] () {
+			for (unsigned line = 0; line < _lines; line++)
+				_glyph_cache.paint(surface, Point(0, line*_cell_h), _font,
+				                   color, text + line*(_columns + 1)); });
+
+		_measure(format, "cells", [&] () {
+			for (unsigned line = 0; line < _lines; line++) {
+				for (unsigned column = 0; column < _columns; column++) {
+
+					PT * const cell = pixels + line*_cell_h*_area.w()
+					                         + column*_cell_w;
+
+					PT const bg = (column + line) % 2 ? PT(0, 0, 64) : PT(0, 0, 0);
+
+					PT *row = cell;
+					for (int y = 0; y < _cell_h; y++, row += _area.w())
+						Pixel_row<PT>::fill(row, bg, _cell_w);
+
+					_glyph_cache.draw(cell, _area.w(), _font, color,
+					                  _character(column, line));
+				}
+			} });
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- text benchmark started (", _columns, "x", _lines, " characters, ",
+		    _area, " pixels) ---");
+
+		_bench<Pixel_rgb565>("RGB565");
+		_bench<Pixel_rgb888>("RGB888");
+
+		if (_errors) {
+			error(_errors, " errors");
+			return;
+		}
+
+		log("--- text benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
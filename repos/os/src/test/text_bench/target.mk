@@ -0,0 +1,6 @@
+TARGET  = test-text_bench
+SRC_CC  = main.cc
+LIBS    = base
+SRC_BIN = default.tff
+
+vpath %.tff $(REP_DIR)/src/server/nitpicker
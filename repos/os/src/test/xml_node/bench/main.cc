@@ -0,0 +1,149 @@
+/*
+ * \brief  Benchmark for iterating over large XML documents
+ * \author agent
+ * \date   2026-10-17
+ *
+ * The benchmark generates an init-like configuration with 10,000 '<start>'
+ * nodes and compares the iteration over this document using plain
+ * 'Xml_node' objects with the iteration using an 'Xml_index'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/component.h>
+#include <base/log.h>
+#include <base/heap.h>
+#include <base/attached_ram_dataspace.h>
+#include <util/xml_generator.h>
+#include <util/xml_index.h>
+#include <util/reconstructible.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	enum {
+		NR_OF_NODES  = 10000,
+		LOOKUPS      = 1000,
+		BUF_SIZE     = 4*1024*1024,
+	};
+
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Attached_ram_dataspace _buf { _env.ram(), _env.rm(), BUF_SIZE };
+
+	size_t _generate()
+	{
+		Xml_generator xml(_buf.local_addr<char>(), BUF_SIZE, "config", [&] () {
+			for (unsigned i = 0; i < NR_OF_NODES; i++) {
+				xml.node("start", [&] () {
+					xml.attribute("name", String<16>("child_", i));
+					xml.attribute("caps", 100);
+					xml.node("resource", [&] () {
+						xml.attribute("name", "RAM");
+						xml.attribute("quantum", "1M");
+					});
+					xml.node("route", [&] () {
+						xml.node("any-service", [&] () {
+							xml.node("parent", [&] () { }); });
+					});
+				});
+			}
+		});
+		return xml.used();
+	}
+
+	/**
+	 * Visit each node the way init visits its '<start>' nodes
+	 *
+	 * \return  checksum of the visited data
+	 */
+	static unsigned long _iterate(Xml_node const config)
+	{
+		unsigned long sum = 0;
+		config.for_each_sub_node("start", [&] (Xml_node start) {
+			sum += start.attribute_value("caps", 0UL);
+			sum += start.sub_node("resource").attribute_value("quantum", Number_of_bytes(0));
+			sum += start.sub_node("route").sub_node().num_sub_nodes();
+		});
+		return sum;
+	}
+
+	/**
+	 * Access nodes by index
+	 */
+	static unsigned long _lookup(Xml_node const config)
+	{
+		unsigned long sum = 0;
+		for (unsigned i = 0; i < LOOKUPS; i++)
+			sum += config.sub_node((i*7919) % NR_OF_NODES).size();
+		return sum;
+	}
+
+	template <typename FN>
+	unsigned long _measure(char const *what, FN const &fn)
+	{
+		unsigned long const start_ms = _timer.elapsed_ms();
+		unsigned long const result   = fn();
+		log(what, ": ", _timer.elapsed_ms() - start_ms, " ms");
+		return result;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- XML-node benchmark ---");
+
+		size_t const size = _generate();
+		log("document of ", size / 1024, " KiB with ", (unsigned)NR_OF_NODES,
+		    " start nodes");
+
+		char const *doc = _buf.local_addr<char const>();
+
+		unsigned long const plain_iterate = _measure("plain iteration", [&] () {
+			return _iterate(Xml_node(doc, size)); });
+
+		unsigned long const plain_lookup = _measure("plain lookup", [&] () {
+			return _lookup(Xml_node(doc, size)); });
+
+		Constructible<Xml_index> index;
+		_measure("index construction", [&] () {
+			index.construct(_heap, doc, size);
+			return 0UL; });
+
+		log("index of ", index->num_nodes(), " nodes");
+
+		unsigned long const indexed_iterate = _measure("indexed iteration", [&] () {
+			return _iterate(index->xml()); });
+
+		unsigned long const indexed_lookup = _measure("indexed lookup", [&] () {
+			return _lookup(index->xml()); });
+
+		if (plain_iterate != indexed_iterate || plain_lookup != indexed_lookup) {
+			error("indexed results differ from plain results");
+			_env.parent().exit(-1);
+			return;
+		}
+
+		log("--- finished XML-node benchmark ---");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }